@@ -0,0 +1,167 @@
+#include "BenchHarness.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+BenchState::BenchState(int iterations) : iteration_count(iterations), bytes_per_iteration(0), items_per_iteration(0) {}
+
+int BenchState::iterations() const {
+    return iteration_count;
+}
+
+void BenchState::setBytesPerIteration(long long bytes) {
+    bytes_per_iteration = bytes;
+}
+
+void BenchState::setItemsPerIteration(long long items) {
+    items_per_iteration = items;
+}
+
+void BenchState::skip(const std::string &reason) {
+    skip_reason = reason;
+}
+
+void BenchState::measure(const std::function<void()> &body) {
+    measure(nullptr, body);
+}
+
+void BenchState::measure(const std::function<void()> &setup, const std::function<void()> &body) {
+    if (!skip_reason.empty()) {
+        return;
+    }
+    for (int i = 0; i < iteration_count; i++) {
+        if (setup) {
+            setup();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        if (!skip_reason.empty()) {
+            break; // the body found the environment unusable, more iterations will not help
+        }
+    }
+}
+
+BenchResult BenchState::result(const std::string &name) const {
+    BenchResult result{name, static_cast<int>(samples_ms.size()), 0, 0, 0, 0, 0, 0, skip_reason};
+    if (samples_ms.empty()) {
+        if (result.skipped.empty()) {
+            result.skipped = "measure() was not called";
+        }
+        return result;
+    }
+    std::vector<double> sorted = samples_ms;
+    std::sort(sorted.begin(), sorted.end());
+    result.mean_ms = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    result.median_ms = sorted.size() % 2 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+    result.min_ms = sorted.front();
+    result.max_ms = sorted.back();
+    // Throughput from the median, which a single slow iteration does not move
+    if (result.median_ms > 0) {
+        result.bytes_per_second = bytes_per_iteration * 1000.0 / result.median_ms;
+        result.items_per_second = items_per_iteration * 1000.0 / result.median_ms;
+    }
+    return result;
+}
+
+namespace BenchHarness {
+    namespace {
+        void writeString(std::ostream &out, const std::string &value) {
+            out << '"';
+            for (char c : value) {
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+
+        void writeNumber(std::ostream &out, double value) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.6g", value);
+            out << text;
+        }
+    }
+
+    std::vector<BenchDefinition> &registry() {
+        static std::vector<BenchDefinition> definitions;
+        return definitions;
+    }
+
+    bool registerBench(const char *name, int iterations, BenchFunction function) {
+        registry().push_back({name, iterations, function});
+        return true;
+    }
+
+    std::vector<BenchResult> runAll(const std::string &filter, std::ostream &progress) {
+        std::vector<BenchResult> results;
+        for (const BenchDefinition &definition : registry()) {
+            if (definition.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            BenchState state(definition.iterations);
+            definition.function(state);
+            BenchResult result = state.result(definition.name);
+            if (result.skipped.empty()) {
+                char line[160];
+                std::snprintf(line, sizeof(line), "%-36s %10.3f ms median  (%d iterations)\n", result.name.c_str(), result.median_ms, result.iterations);
+                progress << line;
+            } else {
+                progress << result.name << " skipped: " << result.skipped << "\n";
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    void writeJson(std::ostream &out, const std::vector<std::pair<std::string, std::string>> &context, const std::vector<BenchResult> &results) {
+        out << "{\n  \"context\": {";
+        for (size_t i = 0; i < context.size(); i++) {
+            out << (i ? ", " : "");
+            writeString(out, context[i].first);
+            out << ": ";
+            writeString(out, context[i].second);
+        }
+        out << "},\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult &result = results[i];
+            out << (i ? ",\n" : "\n") << "    {\"name\": ";
+            writeString(out, result.name);
+            if (!result.skipped.empty()) {
+                out << ", \"skipped\": ";
+                writeString(out, result.skipped);
+                out << "}";
+                continue;
+            }
+            out << ", \"iterations\": " << result.iterations;
+            const std::pair<const char *, double> fields[] = {
+                {"mean_ms", result.mean_ms}, {"median_ms", result.median_ms}, {"min_ms", result.min_ms}, {"max_ms", result.max_ms},
+                {"bytes_per_second", result.bytes_per_second}, {"items_per_second", result.items_per_second},
+            };
+            for (const auto &field : fields) {
+                out << ", \"" << field.first << "\": ";
+                writeNumber(out, field.second);
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    std::string sourceOfSize(size_t bytes) {
+        const std::string line = "    if (dp[i][j] > best) { best = dp[i][j]; at = {i, j}; } // keep the argmax\n";
+        std::string text;
+        text.reserve(bytes + line.size());
+        while (text.size() < bytes) {
+            text += line;
+        }
+        text.resize(bytes);
+        return text;
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness for kodetron_bench. A benchmark is a function
+// registered with KODETRON_BENCH; it prepares its data and then calls
+// state.measure(), which times the body once per iteration. Untimed work
+// that must happen before every iteration goes in measure()'s setup
+// argument.
+struct BenchResult {
+    std::string name;
+    int iterations;
+    double mean_ms;
+    double median_ms;
+    double min_ms;
+    double max_ms;
+    double bytes_per_second; // 0 unless the benchmark set bytes per iteration
+    double items_per_second; // 0 unless the benchmark set items per iteration
+    std::string skipped;     // reason, empty when the benchmark ran
+};
+
+class BenchState {
+  public:
+    explicit BenchState(int iterations);
+
+    int iterations() const;
+    void setBytesPerIteration(long long bytes);
+    void setItemsPerIteration(long long items);
+    // Marks the benchmark as not applicable here, e.g. g++ is not installed
+    void skip(const std::string &reason);
+
+    void measure(const std::function<void()> &body);
+    void measure(const std::function<void()> &setup, const std::function<void()> &body);
+
+    BenchResult result(const std::string &name) const;
+
+  private:
+    int iteration_count;
+    long long bytes_per_iteration;
+    long long items_per_iteration;
+    std::string skip_reason;
+    std::vector<double> samples_ms;
+};
+
+using BenchFunction = void (*)(BenchState &state);
+
+struct BenchDefinition {
+    std::string name;
+    int iterations;
+    BenchFunction function;
+};
+
+namespace BenchHarness {
+    std::vector<BenchDefinition> &registry();
+    bool registerBench(const char *name, int iterations, BenchFunction function);
+    // Runs every benchmark whose name contains filter, in registration order
+    std::vector<BenchResult> runAll(const std::string &filter, std::ostream &progress);
+    void writeJson(std::ostream &out, const std::vector<std::pair<std::string, std::string>> &context, const std::vector<BenchResult> &results);
+    // Exactly bytes of C++-looking ASCII, for benchmarks that load or save a file
+    std::string sourceOfSize(size_t bytes);
+}
+
+#define KODETRON_BENCH(name, iterations)                                                             \
+    static void name(BenchState &state);                                                             \
+    static const bool name##_registered = BenchHarness::registerBench(#name, iterations, name);      \
+    static void name(BenchState &state)
+
+#endif // BENCHHARNESS_H
@@ -0,0 +1,203 @@
+#include <sqlite3.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchHarness.h"
+#include "../src/Database/DataBaseManager.h"
+#include "../src/Database/LibraryArchive/LibraryArchive.h"
+#include "../src/Database/StatementCache/StatementCache.h"
+
+// DatabaseManager runs against the test-mode kodetron.db, which main()
+// removes before the first benchmark, so every run starts from an empty file
+namespace {
+    constexpr int SNIPPET_COUNT = 1000;
+    constexpr int LOOKUP_COUNT = 10000;
+    constexpr int LIBRARY_RECORD_COUNT = 10000; // the import target is 10k entries in under 1 s
+
+    DatabaseManager &database() {
+        static DatabaseManager manager;
+        static bool initialized = manager.initializeDatabase();
+        (void)initialized;
+        return manager;
+    }
+
+    int benchUserId() {
+        static int user_id = []() {
+            DatabaseManager &manager = database();
+            manager.createUser("bench", "bench@kodetron.invalid");
+            User user;
+            return manager.getUserById(1, user) ? user.id : 1;
+        }();
+        return user_id;
+    }
+
+    std::vector<Snippet> makeSnippets(const std::string &prefix) {
+        std::vector<Snippet> snippets;
+        snippets.reserve(SNIPPET_COUNT);
+        std::string content(512, 'x');
+        for (int i = 0; i < SNIPPET_COUNT; i++) {
+            snippets.push_back({0, prefix + std::to_string(i), content, benchUserId()});
+        }
+        return snippets;
+    }
+
+    // Inserted per iteration by the update and delete benchmarks
+    std::vector<int> insertSnippets(const std::string &prefix) {
+        std::vector<int> ids;
+        database().createSnippets(makeSnippets(prefix), &ids);
+        return ids;
+    }
+}
+
+KODETRON_BENCH(Database_CreateSnippets1000, 10) {
+    if (!database().isDatabaseInitialized()) {
+        state.skip("database could not be opened");
+    }
+    int round = 0;
+    std::vector<Snippet> snippets;
+    state.setItemsPerIteration(SNIPPET_COUNT);
+    state.measure([&]() { snippets = makeSnippets("create" + std::to_string(round++) + "_"); },
+                  [&]() { database().createSnippets(snippets); });
+}
+
+KODETRON_BENCH(Database_GetSnippetById10k, 10) {
+    if (!database().isDatabaseInitialized()) {
+        state.skip("database could not be opened");
+    }
+    std::vector<int> ids = insertSnippets("lookup_");
+    if (ids.empty()) {
+        state.skip("snippets could not be created");
+    }
+    Snippet snippet;
+    state.setItemsPerIteration(LOOKUP_COUNT);
+    state.measure([&]() {
+        for (int i = 0; i < LOOKUP_COUNT; i++) {
+            database().getSnippetById(ids[i % ids.size()], snippet);
+        }
+    });
+}
+
+KODETRON_BENCH(Database_UpdateSnippets1000, 10) {
+    if (!database().isDatabaseInitialized()) {
+        state.skip("database could not be opened");
+    }
+    std::vector<int> ids = insertSnippets("update_");
+    int round = 0;
+    state.setItemsPerIteration(static_cast<long long>(ids.size()));
+    state.measure([&]() {
+        DatabaseManager::Transaction transaction(database());
+        std::string content = "// revision " + std::to_string(round++);
+        for (int id : ids) {
+            database().updateSnippet({id, "update_" + std::to_string(id), content, benchUserId()});
+        }
+        transaction.commit();
+    });
+}
+
+KODETRON_BENCH(Database_DeleteSnippets1000, 10) {
+    if (!database().isDatabaseInitialized()) {
+        state.skip("database could not be opened");
+    }
+    int round = 0;
+    std::vector<int> ids;
+    state.setItemsPerIteration(SNIPPET_COUNT);
+    state.measure([&]() { ids = insertSnippets("delete" + std::to_string(round++) + "_"); },
+                  [&]() {
+                      DatabaseManager::Transaction transaction(database());
+                      for (int id : ids) {
+                          database().deleteSnippet(id);
+                      }
+                      transaction.commit();
+                  });
+}
+
+// What DatabaseWorker::importLibrary does, minus the file: read every
+// record of an in-memory archive and store it in one transaction
+KODETRON_BENCH(Database_ImportLibrary10k, 5) {
+    if (!database().isDatabaseInitialized()) {
+        state.skip("database could not be opened");
+    }
+    int round = 0;
+    std::string archive;
+    state.setItemsPerIteration(LIBRARY_RECORD_COUNT);
+    state.measure([&]() {
+                      std::ostringstream out;
+                      LibraryWriter writer(out);
+                      // Real code rather than one repeated letter, the full-text index tokenizes it
+                      std::string content = "struct DSU {\n    vector<int> parent, size;\n"
+                                            "    int find(int x) { return parent[x] == x ? x : parent[x] = find(parent[x]); }\n"
+                                            "    bool unite(int a, int b) { a = find(a); b = find(b); if (a == b) return false;\n"
+                                            "        if (size[a] < size[b]) swap(a, b); parent[b] = a; size[a] += size[b]; return true; }\n};\n";
+                      std::string prefix = "import" + std::to_string(round++) + "_";
+                      for (int i = 0; i < LIBRARY_RECORD_COUNT; i++) {
+                          writer.write({LibraryRecordKind::Snippet, prefix + std::to_string(i), content});
+                      }
+                      archive = out.str();
+                  },
+                  [&]() {
+                      std::istringstream in(archive);
+                      LibraryReader reader(in);
+                      LibraryRecord record;
+                      bool stored = false;
+                      DatabaseManager::Transaction transaction(database());
+                      while (reader.next(record)) {
+                          database().importLibraryRecord(record, benchUserId(), stored);
+                      }
+                      transaction.commit();
+                  });
+}
+
+// The same point lookup through StatementCache and through a statement
+// prepared and finalized per query, on an in-memory table
+namespace {
+    constexpr int ROW_COUNT = 200;
+    constexpr const char *LOOKUP_SQL = "SELECT name, content FROM Items WHERE id = ?;";
+
+    sqlite3 *openItemsTable() {
+        sqlite3 *db = nullptr;
+        sqlite3_open(":memory:", &db);
+        sqlite3_exec(db, "CREATE TABLE Items (id INTEGER PRIMARY KEY, name TEXT, content TEXT);", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+        for (int i = 1; i <= ROW_COUNT; i++) {
+            std::string sql = "INSERT INTO Items VALUES (" + std::to_string(i) + ", 'item" + std::to_string(i) + "', 'content');";
+            sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
+        }
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        return db;
+    }
+}
+
+KODETRON_BENCH(StatementCache_CachedLookup10k, 10) {
+    sqlite3 *db = openItemsTable();
+    {
+        StatementCache cache(db);
+        state.setItemsPerIteration(LOOKUP_COUNT);
+        state.measure([&]() {
+            for (int i = 0; i < LOOKUP_COUNT; i++) {
+                Statement stmt = cache.get(LOOKUP_SQL);
+                stmt.bind(1, i % ROW_COUNT + 1);
+                if (stmt.step() == SQLITE_ROW) {
+                    stmt.columnText(1);
+                }
+            }
+        });
+    }
+    sqlite3_close(db);
+}
+
+KODETRON_BENCH(StatementCache_PreparedLookup10k, 10) {
+    sqlite3 *db = openItemsTable();
+    state.setItemsPerIteration(LOOKUP_COUNT);
+    state.measure([&]() {
+        for (int i = 0; i < LOOKUP_COUNT; i++) {
+            sqlite3_stmt *stmt = nullptr;
+            sqlite3_prepare_v2(db, LOOKUP_SQL, -1, &stmt, nullptr);
+            sqlite3_bind_int(stmt, 1, i % ROW_COUNT + 1);
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                std::string content(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1)));
+            }
+            sqlite3_finalize(stmt);
+        }
+    });
+    sqlite3_close(db);
+}
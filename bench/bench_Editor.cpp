@@ -0,0 +1,28 @@
+#include <QString>
+#include "BenchHarness.h"
+#include "../src/widgets/KodetronEditor/KodetronEditor.h"
+
+// setText of a whole buffer, as when a file is opened, lexer included
+namespace {
+    constexpr int MEGABYTE = 1024 * 1024;
+
+    void benchSetText(BenchState &state, int megabytes) {
+        KodetronEditor editor;
+        editor.resize(1200, 800);
+        QString text = QString::fromStdString(BenchHarness::sourceOfSize(static_cast<size_t>(megabytes) * MEGABYTE));
+        state.setBytesPerIteration(static_cast<long long>(megabytes) * MEGABYTE);
+        state.measure([&]() { editor.clear(); }, [&]() { editor.setText(text); });
+    }
+}
+
+KODETRON_BENCH(Editor_SetText1MB, 10) {
+    benchSetText(state, 1);
+}
+
+KODETRON_BENCH(Editor_SetText10MB, 3) {
+    benchSetText(state, 10);
+}
+
+KODETRON_BENCH(Editor_SetText100MB, 1) {
+    benchSetText(state, 100);
+}
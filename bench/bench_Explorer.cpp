@@ -0,0 +1,76 @@
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <vector>
+#include "BenchHarness.h"
+#include "../src/FileSystemOperations/DirectoryEnumerator/DirectoryEnumerator.h"
+#include "../src/widgets/Explorer/ExplorerTreeModel/ExplorerTreeModel.h"
+
+namespace {
+    constexpr int FILE_COUNT = 50000;
+    constexpr int POPULATE_TIMEOUT_MS = 120000;
+
+    // One flat directory, shared by the explorer benchmarks and removed at exit
+    const QTemporaryDir &syntheticTree() {
+        static QTemporaryDir dir;
+        static bool created = []() {
+            for (int i = 0; i < FILE_COUNT; i++) {
+                QFile file(dir.filePath(QString("problem_%1.cpp").arg(i, 5, 10, QChar('0'))));
+                if (!file.open(QIODevice::WriteOnly)) {
+                    return false;
+                }
+            }
+            return true;
+        }();
+        (void)created;
+        return dir;
+    }
+
+    bool treeReady(BenchState &state) {
+        if (!syntheticTree().isValid() || QDir(syntheticTree().path()).count() < static_cast<uint>(FILE_COUNT)) {
+            state.skip("could not create the synthetic tree");
+            return false;
+        }
+        return true;
+    }
+}
+
+// From setRootPath until every row has been appended to the model
+KODETRON_BENCH(Explorer_Populate50k, 5) {
+    if (!treeReady(state)) {
+        return;
+    }
+    ExplorerTreeModel model;
+    state.setItemsPerIteration(FILE_COUNT);
+    state.measure([&]() { model.setRootPath(QString()); },
+                  [&]() {
+                      model.setRootPath(syntheticTree().path());
+                      model.fetchMore(QModelIndex());
+                      QEventLoop loop;
+                      QTimer poll;
+                      QObject::connect(&poll, &QTimer::timeout, &loop, [&]() {
+                          if (model.rowCount() >= FILE_COUNT) {
+                              loop.quit();
+                          }
+                      });
+                      QTimer::singleShot(POPULATE_TIMEOUT_MS, &loop, &QEventLoop::quit);
+                      poll.start(0);
+                      loop.exec();
+                      if (model.rowCount() < FILE_COUNT) {
+                          state.skip("timed out waiting for the listing");
+                      }
+                  });
+}
+
+KODETRON_BENCH(Explorer_Enumerate50k, 10) {
+    if (!treeReady(state)) {
+        return;
+    }
+    std::string path = syntheticTree().path().toStdString();
+    std::vector<DirectoryEntry> entries;
+    state.setItemsPerIteration(FILE_COUNT);
+    state.measure([&]() { DirectoryEnumerator::list(path, entries); });
+}
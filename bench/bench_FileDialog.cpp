@@ -0,0 +1,27 @@
+#include <QTemporaryDir>
+#include "BenchHarness.h"
+#include "../src/FileSystemOperations/FileDialog/FileDialog.h"
+
+namespace {
+    constexpr int FILE_BYTES = 1024 * 1024;
+}
+
+KODETRON_BENCH(FileDialog_Write1MB, 20) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("bench.cpp");
+    QString contents = QString::fromStdString(BenchHarness::sourceOfSize(FILE_BYTES));
+    state.setBytesPerIteration(FILE_BYTES);
+    state.measure([&]() { FileDialog::writeFileContents(path, contents); });
+}
+
+KODETRON_BENCH(FileDialog_Read1MB, 20) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("bench.cpp");
+    FileDialog::writeFileContents(path, QString::fromStdString(BenchHarness::sourceOfSize(FILE_BYTES)));
+    state.setBytesPerIteration(FILE_BYTES);
+    state.measure([&]() {
+        if (FileDialog::readFileContents(path).size() != FILE_BYTES) {
+            state.skip("read returned a short file");
+        }
+    });
+}
@@ -0,0 +1,97 @@
+#include <QEventLoop>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <string>
+#include "BenchHarness.h"
+#include "../src/LanguageSupport/LspClient/LspClient.h"
+
+// Round trips to a real clangd on a 1000-line buffer. The diagnostics target
+// is 100 ms from the edit, debounce included, so queueChange starts the clock.
+namespace {
+    constexpr int SOURCE_LINES = 1000;
+    constexpr int STARTUP_TIMEOUT_MS = 20000;
+    constexpr int REPLY_TIMEOUT_MS = 5000;
+
+    QByteArray makeSource() {
+        QByteArray source;
+        for (int i = 0; i < SOURCE_LINES; i++) {
+            source += "int function_" + QByteArray::number(i) + "(int value) { return value + " + QByteArray::number(i) + "; }\n";
+        }
+        return source;
+    }
+
+    template <typename Signal>
+    bool waitForSignal(LspClient &client, Signal signal, int timeout_ms) {
+        QEventLoop loop;
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        bool fired = false;
+        QObject::connect(&client, signal, &loop, [&]() {
+            fired = true;
+            loop.quit();
+        });
+        QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+        timeout.start(timeout_ms);
+        loop.exec();
+        return fired;
+    }
+
+    // Opens the buffer and waits for the first publish, so the timed
+    // iterations see a server that has parsed the file once
+    bool openSource(LspClient &client, const QTemporaryDir &directory, BenchState &state) {
+        if (QStandardPaths::findExecutable("clangd").isEmpty()) {
+            state.skip("clangd is not installed");
+            return false;
+        }
+        QString file_path = directory.filePath("bench.cpp");
+        QByteArray source = makeSource();
+        QFile file(file_path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(source) != source.size()) {
+            state.skip("could not write the source file");
+            return false;
+        }
+        file.close();
+        client.openDocument(file_path, source);
+        if (!waitForSignal(client, &LspClient::diagnosticsPublished, STARTUP_TIMEOUT_MS)) {
+            state.skip("clangd did not publish diagnostics for the opened file");
+            return false;
+        }
+        return true;
+    }
+}
+
+KODETRON_BENCH(Lsp_DiagnosticsAfterEdit1000Lines, 20) {
+    QTemporaryDir directory;
+    LspClient client;
+    if (!openSource(client, directory, state)) {
+        return;
+    }
+    int round = 0;
+    state.measure([&]() {
+        // Each edit adds an undeclared name so clangd has something new to report
+        QByteArray line = "int broken_" + QByteArray::number(round) + " = missing_" + QByteArray::number(round) + ";\n";
+        round++;
+        LspEditPosition position{SOURCE_LINES / 2, 0, 0};
+        client.queueChange(position, position, line);
+        if (!waitForSignal(client, &LspClient::diagnosticsPublished, REPLY_TIMEOUT_MS)) {
+            state.skip("clangd did not publish diagnostics after an edit");
+        }
+    });
+}
+
+KODETRON_BENCH(Lsp_Hover1000Lines, 50) {
+    QTemporaryDir directory;
+    LspClient client;
+    if (!openSource(client, directory, state)) {
+        return;
+    }
+    state.measure([&]() {
+        // On the name of the last function, the far end of the buffer
+        client.requestHover(SOURCE_LINES - 1, 6);
+        if (!waitForSignal(client, &LspClient::hoverReady, REPLY_TIMEOUT_MS)) {
+            state.skip("clangd did not answer the hover request");
+        }
+    });
+}
@@ -0,0 +1,72 @@
+#include <QFile>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include "BenchHarness.h"
+
+// The compile and run steps of StandardIOSection::runCode with a program
+// that does nearly nothing, so the numbers are the pipeline's own overhead
+namespace {
+    constexpr int PROCESS_TIMEOUT_MS = 30000;
+    constexpr const char *TRIVIAL_PROGRAM =
+        "#include <bits/stdc++.h>\n"
+        "using namespace std;\n"
+        "int main() { long long a, b; cin >> a >> b; cout << a + b << '\\n'; }\n";
+
+    bool writeProgram(const QString &path) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            return false;
+        }
+        return file.write(TRIVIAL_PROGRAM) > 0;
+    }
+
+    bool compile(const QString &cpp_path, const QString &exe_path) {
+        QProcess compiler;
+        compiler.start("g++", QStringList() << cpp_path << "-o" << exe_path);
+        return compiler.waitForFinished(PROCESS_TIMEOUT_MS) && compiler.exitCode() == 0 && QFile::exists(exe_path);
+    }
+
+    bool run(const QString &exe_path) {
+        QProcess program;
+        program.setProgram(exe_path);
+        program.setProcessChannelMode(QProcess::MergedChannels);
+        program.start();
+        program.write("20 22\n");
+        program.closeWriteChannel();
+        return program.waitForFinished(PROCESS_TIMEOUT_MS) && program.readAllStandardOutput().trimmed() == "42";
+    }
+}
+
+KODETRON_BENCH(RunPipeline_CompileAndRun, 5) {
+    QTemporaryDir dir;
+    QString cpp_path = dir.filePath("temp.cpp");
+    QString exe_path = dir.filePath("temp.exe");
+    if (QStandardPaths::findExecutable("g++").isEmpty()) {
+        state.skip("g++ not found");
+    } else if (!writeProgram(cpp_path)) {
+        state.skip("could not write the program");
+    }
+    state.measure([&]() { QFile::remove(exe_path); },
+                  [&]() {
+                      if (!compile(cpp_path, exe_path) || !run(exe_path)) {
+                          state.skip("compile or run failed");
+                      }
+                  });
+}
+
+KODETRON_BENCH(RunPipeline_RunOnly, 50) {
+    QTemporaryDir dir;
+    QString cpp_path = dir.filePath("temp.cpp");
+    QString exe_path = dir.filePath("temp.exe");
+    if (QStandardPaths::findExecutable("g++").isEmpty()) {
+        state.skip("g++ not found");
+    } else if (!writeProgram(cpp_path) || !compile(cpp_path, exe_path)) {
+        state.skip("could not build the program");
+    }
+    state.measure([&]() {
+        if (!run(exe_path)) {
+            state.skip("run failed");
+        }
+    });
+}
@@ -0,0 +1,71 @@
+#include <QApplication>
+#include <QFile>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "BenchHarness.h"
+
+// Headless benchmarks of the editor's hot paths. Results go to stdout as
+// JSON, or to the file given with --out=, progress goes to stderr.
+//
+//   kodetron_bench [--filter=<substring>] [--out=<file.json>] [--list]
+int main(int argc, char *argv[]) {
+    std::string filter;
+    std::string out_path;
+    bool list_only = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--out=", 0) == 0) {
+            out_path = arg.substr(6);
+        } else if (arg == "--list") {
+            list_only = true;
+        } else {
+            std::cerr << "usage: kodetron_bench [--filter=<substring>] [--out=<file.json>] [--list]\n";
+            return 2;
+        }
+    }
+    if (list_only) {
+        for (const BenchDefinition &definition : BenchHarness::registry()) {
+            std::cout << definition.name << "\n";
+        }
+        return 0;
+    }
+
+    // No display needed unless the caller asked for a platform
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    // Keeps the benchmark database away from the user's and starts it empty
+    QStandardPaths::setTestModeEnabled(true);
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/kodetron.db");
+
+    std::vector<BenchResult> results = BenchHarness::runAll(filter, std::cerr);
+    std::vector<std::pair<std::string, std::string>> context = {
+        {"qt_version", qVersion()},
+        {"platform", QApplication::platformName().toStdString()},
+        {"cpu", QSysInfo::currentCpuArchitecture().toStdString()},
+        {"os", QSysInfo::prettyProductName().toStdString()},
+#ifdef NDEBUG
+        {"build", "release"},
+#else
+        {"build", "debug"},
+#endif
+    };
+    if (out_path.empty()) {
+        BenchHarness::writeJson(std::cout, context, results);
+        return 0;
+    }
+    std::ofstream out(out_path, std::ios::trunc);
+    BenchHarness::writeJson(out, context, results);
+    if (!out) {
+        std::cerr << "could not write " << out_path << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -1,25 +1,48 @@
 #include "App.h"
-#include "../utils/StyleLoader/StyleReader.h"
+#include "../Snippets/SnippetEngine/SnippetEngine.h"
+#include "../Templates/TemplateCache/TemplateCache.h"
+#include "../Global/AppState.h"
+#include "../utils/StartupTracer/StartupTracer.h"
 
 #include <iostream>
 
-App::App(QWidget *parent) : QWidget(parent) {
-    // Database initialization
-    db_manager = new DatabaseManager();
+App::App(QWidget *parent) : QWidget(parent), search_panel(nullptr), quick_open_palette(nullptr), latency_panel(nullptr) {
+    StartupTracer &tracer = StartupTracer::instance();
+
+    // Database initialization, queued ahead of every other query. The file is
+    // opened and migrated once the worker starts, after the first paint.
+    database = new DatabaseWorker(this);
     int user_id = 1;
-    db_manager->initializeDatabase();
-    User user;
-    if (!db_manager->getUserById(user_id, user)) {
-        db_manager->createUser("default_handle", "default@email.com");
-    }
+    database->initialize(user_id);
+    tracer.defer("database open", [this]() { database->start(); });
+    // Snippets are parsed once here so expansion never touches the database
+    SnippetEngine::instance().load(database, user_id);
+    TemplateCache::instance().load(database, user_id);
+
+    // Quick open follows whichever folder the explorer shows
+    path_index = new PathIndex(database, this);
+    connect(&AppState::instance(), &AppState::selectedDirPathModified, path_index, &PathIndex::setRoot);
 
     // Childs initialization
-    menu_section = new MenuSection(this);
-    toolbar_section = new ToolbarSection(db_manager, user_id, this);
-    explorer_section = new ExplorerSection(this);
+    tracer.begin("MenuSection");
+    menu_section = new MenuSection(database, user_id, this);
+    tracer.end();
+    tracer.begin("ToolbarSection");
+    toolbar_section = new ToolbarSection(database, user_id, this);
+    tracer.end();
+    tracer.begin("ExplorerSection");
+    explorer_section = new ExplorerSection(database, this);
+    tracer.end();
+    tracer.begin("EditorSection");
     editor_section = new EditorSection(this);
-    standardio_section = new StandardIOSection(editor_section->getCodeEditor(), this);
+    tracer.end();
+    tracer.begin("StandardIOSection");
+    standardio_section = new StandardIOSection(database, editor_section->getCodeEditor(), this);
+    tracer.end();
     content_wrapper = new QWidget(this); // content = all - menu_section
+    connect(menu_section, &MenuSection::findInFolderRequested, this, &App::onFindInFolder);
+    connect(menu_section, &MenuSection::quickOpenRequested, this, &App::onQuickOpen);
+    connect(menu_section, &MenuSection::latencyPanelRequested, this, &App::onLatencyPanel);
 
     // Splitter
     file_editor_standardio_splitter = new QSplitter(Qt::Horizontal, this);
@@ -39,10 +62,37 @@ App::App(QWidget *parent) : QWidget(parent) {
     setLayout(vertical_layout);
 
     // Style sheet
+    tracer.begin("App styles");
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
+    tracer.end();
+
+    // Last session, on top of the defaults set above
+    StartupTracer::Scope restore("session restore");
+    session_manager = new SessionManager(editor_section->getCodeEditor(), file_editor_standardio_splitter, standardio_section, this);
+    session_manager->restore();
+}
+void App::onFindInFolder() {
+    if (!search_panel) {
+        // Created on first use, kept alive so results survive closing the panel
+        search_panel = new SearchPanel(editor_section->getCodeEditor(), this);
+    }
+    search_panel->showForCurrentFolder();
+}
+void App::onQuickOpen() {
+    if (!quick_open_palette) {
+        quick_open_palette = new QuickOpenPalette(path_index, this);
+    }
+    quick_open_palette->popup();
+}
+void App::onLatencyPanel() {
+    if (!latency_panel) {
+        latency_panel = new LatencyPanel(this);
+    }
+    latency_panel->show();
+    latency_panel->raise();
+    latency_panel->activateWindow();
 }
 void App::assignObjectNames() {
     file_editor_standardio_splitter->setObjectName("file_editor_standardio_splitter");
@@ -56,9 +106,3 @@ void App::applyQtStyles() {
     vertical_layout->setSpacing(0);
     horizontal_layout->setSpacing(0);
 }
-void App::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/App/App.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
-}
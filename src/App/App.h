@@ -12,6 +12,12 @@
 #include "../widgets/Explorer/ExplorerSection/ExplorerSection.h"
 #include "../widgets/Editor/EditorSection/EditorSection.h"
 #include "../widgets/StandardIO/StandardIOSection/StandardIOSection.h"
+#include "../widgets/Search/SearchPanel/SearchPanel.h"
+#include "../widgets/Search/QuickOpenPalette/QuickOpenPalette.h"
+#include "../widgets/Diagnostics/LatencyPanel/LatencyPanel.h"
+#include "../Search/PathIndex/PathIndex.h"
+#include "../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../Session/SessionManager/SessionManager.h"
 
 class App : public QWidget {
     Q_OBJECT
@@ -20,9 +26,10 @@ class App : public QWidget {
     App(QWidget *parent = nullptr);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
-    
-    
+    void onFindInFolder();
+    void onQuickOpen();
+    void onLatencyPanel();
+
   private:
     MenuSection *menu_section;
     ToolbarSection *toolbar_section;
@@ -33,7 +40,12 @@ class App : public QWidget {
     QSplitter *file_editor_standardio_splitter;
     QVBoxLayout *vertical_layout;
     QHBoxLayout *horizontal_layout;
-    DatabaseManager* db_manager;
+    DatabaseWorker *database;
+    SearchPanel *search_panel;
+    PathIndex *path_index;
+    QuickOpenPalette *quick_open_palette;
+    LatencyPanel *latency_panel;
+    SessionManager *session_manager;
 };
 
 #endif // APP_H
\ No newline at end of file
@@ -1,14 +1,17 @@
 #include "DatabaseManager.h"
+#include "FtsQuery/FtsQuery.h"
+#include "PayloadCodec/PayloadCodec.h"
+#include <QCryptographicHash>
 #include <iostream>
 #include <QCoreApplication>
 #include <QStandardPaths>
 #include <QDir>
 
-DatabaseManager::DatabaseManager() : db(nullptr) {
-    db_path = getDatabasePath();
-}
+DatabaseManager::DatabaseManager() : db(nullptr) {}
 
 DatabaseManager::~DatabaseManager() {
+    // Cached statements must be finalized before the connection can close
+    statements.reset();
     if (db) {
         sqlite3_close(db);
     }
@@ -24,6 +27,8 @@ std::string DatabaseManager::getDatabasePath() {
 }
 
 bool DatabaseManager::initializeDatabase() {
+    // Resolved here rather than in the constructor, which runs on the GUI thread
+    db_path = getDatabasePath();
     int rc = sqlite3_open(db_path.c_str(), &db);
     
     if (rc != SQLITE_OK) {
@@ -31,75 +36,226 @@ bool DatabaseManager::initializeDatabase() {
         return false;
     }
     
+    statements = std::make_unique<StatementCache>(db);
+
     // Enable foreign key constraints
     if (!executeSQL("PRAGMA foreign_keys = ON;")) {
         return false;
     }
+
+    // WAL lets a commit append to the log instead of rewriting pages, and with
+    // synchronous=NORMAL only checkpoints wait for fsync. A crash can lose the
+    // last commits but never corrupts the file.
+    executeSQL("PRAGMA journal_mode = WAL;");
+    executeSQL("PRAGMA synchronous = NORMAL;");
+    executeSQL("PRAGMA cache_size = " + std::to_string(-PAGE_CACHE_KIB) + ";");
+    executeSQL("PRAGMA mmap_size = " + std::to_string(MMAP_SIZE_BYTES) + ";");
     
-    return createTables();
+    return migrateSchema();
 }
 
 bool DatabaseManager::isDatabaseInitialized() const {
     return db != nullptr;
 }
 
-bool DatabaseManager::createTables() {
-    // Create Settings table first (referenced by Users)
-    std::string createSettings = R"(
-        CREATE TABLE IF NOT EXISTS Settings (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            name VARCHAR NOT NULL
-        );
-    )";
-    
-    if (!executeSQL(createSettings)) {
+// Every schema change is a new step here, never an edit to an applied one.
+// Steps may find their work already done on files created by builds that
+// predate user_version, hence the IF NOT EXISTS and column checks.
+std::vector<SchemaMigration> DatabaseManager::schemaHistory() {
+    using SchemaMigrations::execute;
+    std::vector<SchemaMigration> steps;
+
+    steps.push_back({1, "base tables", [](sqlite3* db) {
+        return execute(db, R"(
+            CREATE TABLE IF NOT EXISTS Settings (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                name VARCHAR NOT NULL
+            );
+            CREATE TABLE IF NOT EXISTS Users (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                codeforces_handle VARCHAR,
+                email VARCHAR,
+                settings_id INTEGER,
+                FOREIGN KEY (settings_id) REFERENCES Settings(id) ON DELETE SET NULL
+            );
+            CREATE TABLE IF NOT EXISTS Templates (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                name VARCHAR NOT NULL,
+                content VARCHAR NOT NULL,
+                user_id INTEGER,
+                FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
+            );
+            CREATE TABLE IF NOT EXISTS Snippets (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                name VARCHAR NOT NULL UNIQUE,
+                content VARCHAR NOT NULL,
+                user_id INTEGER,
+                FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
+            );
+            -- Files under each opened folder, for quick open
+            CREATE TABLE IF NOT EXISTS PathIndex (
+                root VARCHAR NOT NULL,
+                path VARCHAR NOT NULL,
+                PRIMARY KEY (root, path)
+            ) WITHOUT ROWID;
+            -- Name filters and grouping per opened folder
+            CREATE TABLE IF NOT EXISTS ExplorerFilters (
+                root VARCHAR PRIMARY KEY,
+                patterns VARCHAR NOT NULL,
+                group_problems INTEGER NOT NULL DEFAULT 0
+            );
+        )");
+    }});
+
+    // Lists only show (id, name, size, updated_at), content is read on selection
+    steps.push_back({2, "size and update time of snippets and templates", [](sqlite3* db) {
+        for (const std::string table : {"Templates", "Snippets"}) {
+            if (SchemaMigrations::hasColumn(db, table, "size")) {
+                continue;
+            }
+            bool added = execute(db, "ALTER TABLE " + table + " ADD COLUMN size INTEGER NOT NULL DEFAULT 0;") &&
+                         execute(db, "ALTER TABLE " + table + " ADD COLUMN updated_at INTEGER NOT NULL DEFAULT 0;") &&
+                         execute(db, "UPDATE " + table + " SET size = length(CAST(content AS BLOB));");
+            if (!added) {
+                return false;
+            }
+        }
+        return true;
+    }});
+
+    // Every list query filters on user_id. Leading with it and covering the
+    // listed columns answers the query from the index alone, sorted by name.
+    steps.push_back({3, "per-user indices", [](sqlite3* db) {
+        return execute(db, R"(
+            DROP INDEX IF EXISTS TemplatesSummaries;
+            DROP INDEX IF EXISTS SnippetsSummaries;
+            CREATE INDEX IF NOT EXISTS TemplatesByUser ON Templates (user_id, name, size, updated_at);
+            CREATE INDEX IF NOT EXISTS SnippetsByUser ON Snippets (user_id, name, size, updated_at);
+        )");
+    }});
+
+    // External-content FTS5 tables over name and content: the text lives only
+    // in the base table, triggers keep the index in step with every write
+    steps.push_back({4, "full-text search of snippets and templates", [](sqlite3* db) {
+        for (const auto& [table, index] : {std::pair<std::string, std::string>{"Snippets", "SnippetsSearch"}, {"Templates", "TemplatesSearch"}}) {
+            if (SchemaMigrations::hasTable(db, index)) {
+                continue;
+            }
+            std::string insert_row = "INSERT INTO " + index + " (rowid, name, content) VALUES (new.id, new.name, new.content);";
+            std::string delete_row = "INSERT INTO " + index + " (" + index + ", rowid, name, content) VALUES ('delete', old.id, old.name, old.content);";
+            bool created = execute(db,
+                "CREATE VIRTUAL TABLE " + index + " USING fts5(name, content, content='" + table + "', content_rowid='id', prefix='2 3');"
+                "CREATE TRIGGER " + index + "AfterInsert AFTER INSERT ON " + table + " BEGIN " + insert_row + " END;"
+                "CREATE TRIGGER " + index + "AfterDelete AFTER DELETE ON " + table + " BEGIN " + delete_row + " END;"
+                "CREATE TRIGGER " + index + "AfterUpdate AFTER UPDATE ON " + table + " BEGIN " + delete_row + " " + insert_row + " END;"
+                // Rows written before the index existed
+                "INSERT INTO " + index + " (" + index + ") VALUES ('rebuild');");
+            if (!created) {
+                return false;
+            }
+        }
+        return true;
+    }});
+
+    // Test inputs and outputs per source file. Payload bytes are stored once
+    // per distinct content, compressed, and dropped with their last reference.
+    // TestCases rows are only ever inserted and deleted, never updated.
+    steps.push_back({5, "test cases", [](sqlite3* db) {
+        return execute(db, R"(
+            CREATE TABLE IF NOT EXISTS Payloads (
+                id INTEGER PRIMARY KEY,
+                hash BLOB NOT NULL UNIQUE,
+                codec INTEGER NOT NULL,
+                raw_size INTEGER NOT NULL,
+                data BLOB NOT NULL,
+                refs INTEGER NOT NULL DEFAULT 0
+            );
+            CREATE TABLE IF NOT EXISTS TestCases (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                file_path VARCHAR NOT NULL,
+                position INTEGER NOT NULL,
+                input_id INTEGER REFERENCES Payloads(id),
+                expected_id INTEGER REFERENCES Payloads(id),
+                output_id INTEGER REFERENCES Payloads(id),
+                verdict INTEGER NOT NULL DEFAULT 0,
+                time_ms INTEGER NOT NULL DEFAULT -1,
+                updated_at INTEGER NOT NULL DEFAULT 0
+            );
+            CREATE INDEX IF NOT EXISTS TestCasesByFile ON TestCases (file_path, position);
+            CREATE TRIGGER IF NOT EXISTS TestCasesAfterInsert AFTER INSERT ON TestCases BEGIN
+                UPDATE Payloads SET refs = refs + 1 WHERE id = new.input_id;
+                UPDATE Payloads SET refs = refs + 1 WHERE id = new.expected_id;
+                UPDATE Payloads SET refs = refs + 1 WHERE id = new.output_id;
+            END;
+            CREATE TRIGGER IF NOT EXISTS TestCasesAfterDelete AFTER DELETE ON TestCases BEGIN
+                UPDATE Payloads SET refs = refs - 1 WHERE id = old.input_id;
+                UPDATE Payloads SET refs = refs - 1 WHERE id = old.expected_id;
+                UPDATE Payloads SET refs = refs - 1 WHERE id = old.output_id;
+                DELETE FROM Payloads WHERE id IN (old.input_id, old.expected_id, old.output_id) AND refs <= 0;
+            END;
+        )");
+    }});
+
+    return steps;
+}
+
+bool DatabaseManager::migrateSchema() {
+    std::string error;
+    if (!SchemaMigrations::migrate(db, schemaHistory(), &error)) {
+        logError("Schema migration", error);
         return false;
     }
-    
-    // Create Users table
-    std::string createUsers = R"(
-        CREATE TABLE IF NOT EXISTS Users (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            codeforces_handle VARCHAR,
-            email VARCHAR,
-            settings_id INTEGER,
-            FOREIGN KEY (settings_id) REFERENCES Settings(id) ON DELETE SET NULL
-        );
-    )";
-    
-    if (!executeSQL(createUsers)) {
+    return true;
+}
+
+// Reads one content value through an incremental blob handle, so a large
+// template is copied straight from its pages without a statement round trip
+bool DatabaseManager::readContent(const std::string& table, int id, std::string& content) {
+    sqlite3_blob* blob = nullptr;
+    if (sqlite3_blob_open(db, "main", table.c_str(), "content", id, 0, &blob) != SQLITE_OK) {
+        sqlite3_blob_close(blob);
         return false;
     }
-    
-    // Create Templates table
-    std::string createTemplates = R"(
-        CREATE TABLE IF NOT EXISTS Templates (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            name VARCHAR NOT NULL,
-            content VARCHAR NOT NULL,
-            user_id INTEGER,
-            FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
-        );
-    )";
-    
-    if (!executeSQL(createTemplates)) {
+    content.resize(static_cast<size_t>(sqlite3_blob_bytes(blob)));
+    bool ok = content.empty() || sqlite3_blob_read(blob, content.data(), static_cast<int>(content.size()), 0) == SQLITE_OK;
+    if (!ok) {
+        logError("Reading content", sqlite3_errmsg(db));
+    }
+    sqlite3_blob_close(blob);
+    return ok;
+}
+
+std::vector<ContentSummary> DatabaseManager::getSummaries(const std::string& table, int user_id) {
+    std::vector<ContentSummary> summaries;
+    Statement stmt = prepare("SELECT id, name, size, updated_at FROM " + table + " WHERE user_id = ? ORDER BY name;");
+    if (!stmt) {
+        logError("Preparing summaries query", sqlite3_errmsg(db));
+        return summaries;
+    }
+    stmt.bind(1, user_id);
+
+    while (stmt.step() == SQLITE_ROW) {
+        summaries.push_back(ContentSummary{stmt.columnInt(0), stmt.columnText(1), stmt.columnInt64(2), stmt.columnInt64(3)});
+    }
+    return summaries;
+}
+
+bool DatabaseManager::getSummary(const std::string& table, int id, ContentSummary& summary) {
+    Statement stmt = prepare("SELECT id, name, size, updated_at FROM " + table + " WHERE id = ?;");
+    if (!stmt) {
+        logError("Preparing summary query", sqlite3_errmsg(db));
         return false;
     }
-    
-    // Create Snippets table
-    std::string createSnippets = R"(
-        CREATE TABLE IF NOT EXISTS Snippets (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            name VARCHAR NOT NULL UNIQUE,
-            content VARCHAR NOT NULL,
-            user_id INTEGER,
-            FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
-        );
-    )";
-    
-    return executeSQL(createSnippets);
+    stmt.bind(1, id);
+
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
+    }
+    summary = ContentSummary{stmt.columnInt(0), stmt.columnText(1), stmt.columnInt64(2), stmt.columnInt64(3)};
+    return true;
 }
 
+
 bool DatabaseManager::executeSQL(const std::string& sql) {
     char* errorMessage = nullptr;
     int rc = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errorMessage);
@@ -115,28 +271,78 @@ bool DatabaseManager::executeSQL(const std::string& sql) {
     return true;
 }
 
+// Transactions
+DatabaseManager::Transaction::Transaction(DatabaseManager& manager) : manager(manager), owns(false), finished(false) {
+    // Inside an open transaction this one just joins it
+    if (manager.db && sqlite3_get_autocommit(manager.db)) {
+        owns = manager.beginTransaction();
+    }
+}
+
+DatabaseManager::Transaction::~Transaction() {
+    if (owns && !finished) {
+        manager.rollbackTransaction();
+    }
+}
+
+bool DatabaseManager::Transaction::commit() {
+    if (!owns || finished) {
+        return !finished;
+    }
+    finished = true;
+    return manager.commitTransaction();
+}
+
+bool DatabaseManager::beginTransaction() {
+    Statement stmt = prepare("BEGIN;");
+    if (!stmt || stmt.step() != SQLITE_DONE) {
+        logError("Beginning transaction", sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::commitTransaction() {
+    Statement stmt = prepare("COMMIT;");
+    if (!stmt || stmt.step() != SQLITE_DONE) {
+        logError("Committing transaction", sqlite3_errmsg(db));
+        rollbackTransaction();
+        return false;
+    }
+    return true;
+}
+
+void DatabaseManager::rollbackTransaction() {
+    // A failed statement may already have ended the transaction
+    if (!db || sqlite3_get_autocommit(db)) {
+        return;
+    }
+    Statement stmt = prepare("ROLLBACK;");
+    if (stmt) {
+        stmt.step();
+    }
+}
+
+Statement DatabaseManager::prepare(const std::string& sql) {
+    return statements ? statements->get(sql) : Statement();
+}
+
 void DatabaseManager::logError(const std::string& operation, const std::string& error) {
     std::cerr << "Database error during " << operation << ": " << error << std::endl;
 }
 
 // User operations
 bool DatabaseManager::createUser(const std::string& codeforces_handle, const std::string& email) {
-    const char* sql = "INSERT INTO Users (codeforces_handle, email) VALUES (?, ?);";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("INSERT INTO Users (codeforces_handle, email) VALUES (?, ?);");
+    if (!stmt) {
         logError("Preparing user creation", sqlite3_errmsg(db));
         return false;
     }
     
-    sqlite3_bind_text(stmt, 1, codeforces_handle.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, email.c_str(), -1, SQLITE_STATIC);
-    
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    stmt.bind(1, codeforces_handle);
+    stmt.bind(2, email);
     
-    if (rc != SQLITE_DONE) {
+    if (stmt.step() != SQLITE_DONE) {
         logError("Creating user", sqlite3_errmsg(db));
         return false;
     }
@@ -145,393 +351,652 @@ bool DatabaseManager::createUser(const std::string& codeforces_handle, const std
 }
 
 bool DatabaseManager::getUserById(int id, User& user) {
-    const char* sql = "SELECT id, codeforces_handle, email, settings_id FROM Users WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, codeforces_handle, email, settings_id FROM Users WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing user query", sqlite3_errmsg(db));
         return false;
     }
     
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
     
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        user.id = sqlite3_column_int(stmt, 0);
-        
-        const char* handle = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        user.codeforces_handle = handle ? handle : "";
-        
-        const char* email_text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        user.email = email_text ? email_text : "";
-        
-        user.settings_id = sqlite3_column_int(stmt, 3);
-        
-        sqlite3_finalize(stmt);
-        return true;
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
     }
-    
-    sqlite3_finalize(stmt);
-    return false;
+    user.id = stmt.columnInt(0);
+    user.codeforces_handle = stmt.columnText(1);
+    user.email = stmt.columnText(2);
+    user.settings_id = stmt.columnInt(3);
+    return true;
 }
 
 bool DatabaseManager::updateUser(const User& user) {
-    const char* sql = "UPDATE Users SET codeforces_handle = ?, email = ?, settings_id = ? WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("UPDATE Users SET codeforces_handle = ?, email = ?, settings_id = ? WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing user update", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_text(stmt, 1, user.codeforces_handle.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, user.email.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 3, user.settings_id);
-    sqlite3_bind_int(stmt, 4, user.id);
+    stmt.bind(1, user.codeforces_handle);
+    stmt.bind(2, user.email);
+    stmt.bind(3, user.settings_id);
+    stmt.bind(4, user.id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE;
 }
 
 bool DatabaseManager::deleteUser(int id) {
-    const char* sql = "DELETE FROM Users WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("DELETE FROM Users WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing user deletion", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE;
 }
 
 std::vector<User> DatabaseManager::getAllUsers() {
     std::vector<User> users;
-    const char* sql = "SELECT id, codeforces_handle, email, settings_id FROM Users;";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, codeforces_handle, email, settings_id FROM Users;");
+    if (!stmt) {
         logError("Preparing users query", sqlite3_errmsg(db));
         return users;
     }
     
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        User user;
-        user.id = sqlite3_column_int(stmt, 0);
-        
-        const char* handle = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        user.codeforces_handle = handle ? handle : "";
-        
-        const char* email_text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        user.email = email_text ? email_text : "";
-        
-        user.settings_id = sqlite3_column_int(stmt, 3);
-        
-        users.push_back(user);
+    while (stmt.step() == SQLITE_ROW) {
+        users.push_back(User{stmt.columnInt(0), stmt.columnText(1), stmt.columnText(2), stmt.columnInt(3)});
     }
     
-    sqlite3_finalize(stmt);
     return users;
 }
 
 // Template operations
-bool DatabaseManager::createTemplate(const std::string& name, const std::string& content, int user_id) {
-    const char* sql = "INSERT INTO Templates (name, content, user_id) VALUES (?, ?, ?);";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+bool DatabaseManager::createTemplate(const std::string& name, const std::string& content, int user_id, int* new_id) {
+    Statement stmt = prepare("INSERT INTO Templates (name, content, user_id, size, updated_at) VALUES (?, ?, ?, ?, CAST(strftime('%s', 'now') AS INTEGER));");
+    if (!stmt) {
         logError("Preparing template creation", sqlite3_errmsg(db));
         return false;
     }
     
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, content.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 3, user_id);
+    stmt.bind(1, name);
+    stmt.bind(2, content);
+    stmt.bind(3, user_id);
+    stmt.bindInt64(4, static_cast<sqlite3_int64>(content.size()));
     
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    return rc == SQLITE_DONE;
+    if (stmt.step() != SQLITE_DONE) {
+        return false;
+    }
+    if (new_id) {
+        *new_id = static_cast<int>(sqlite3_last_insert_rowid(db));
+    }
+    return true;
 }
 
 bool DatabaseManager::getTemplateById(int id, Template& template_obj) {
-    const char* sql = "SELECT id, name, content, user_id FROM Templates WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, name, content, user_id FROM Templates WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing template query", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
 
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        template_obj.id = sqlite3_column_int(stmt, 0);
-        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        template_obj.name = name ? name : "";
-        const char* content = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        template_obj.content = content ? content : "";
-        template_obj.user_id = sqlite3_column_int(stmt, 3);
-        sqlite3_finalize(stmt);
-        return true;
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
     }
-    sqlite3_finalize(stmt);
-    return false;
+    template_obj.id = stmt.columnInt(0);
+    template_obj.name = stmt.columnText(1);
+    template_obj.content = stmt.columnText(2);
+    template_obj.user_id = stmt.columnInt(3);
+    return true;
 }
 
 std::vector<Template> DatabaseManager::getTemplatesByUserId(int user_id) {
     std::vector<Template> templates;
-    const char* sql = "SELECT id, name, content, user_id FROM Templates WHERE user_id = ?;";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, name, content, user_id FROM Templates WHERE user_id = ?;");
+    if (!stmt) {
         logError("Preparing templates query", sqlite3_errmsg(db));
         return templates;
     }
     
-    sqlite3_bind_int(stmt, 1, user_id);
+    stmt.bind(1, user_id);
     
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        Template tmpl;
-        tmpl.id = sqlite3_column_int(stmt, 0);
-        
-        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        tmpl.name = name ? name : "";
-        
-        const char* content = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        tmpl.content = content ? content : "";
-        
-        tmpl.user_id = sqlite3_column_int(stmt, 3);
-        
-        templates.push_back(tmpl);
+    while (stmt.step() == SQLITE_ROW) {
+        templates.push_back(Template{stmt.columnInt(0), stmt.columnText(1), stmt.columnText(2), stmt.columnInt(3)});
     }
     
-    sqlite3_finalize(stmt);
     return templates;
 }
 
+std::vector<ContentSummary> DatabaseManager::getTemplateSummariesByUserId(int user_id) {
+    return getSummaries("Templates", user_id);
+}
+
+bool DatabaseManager::getTemplateContent(int id, std::string& content) {
+    return readContent("Templates", id, content);
+}
+
+bool DatabaseManager::getTemplateSummary(int id, ContentSummary& summary) {
+    return getSummary("Templates", id, summary);
+}
+
 bool DatabaseManager::updateTemplate(const Template& template_obj) {
-    const char* sql = "UPDATE Templates SET name = ?, content = ? WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("UPDATE Templates SET name = ?, content = ?, size = ?, updated_at = CAST(strftime('%s', 'now') AS INTEGER) WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing template update", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_text(stmt, 1, template_obj.name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, template_obj.content.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 3, template_obj.id);
+    stmt.bind(1, template_obj.name);
+    stmt.bind(2, template_obj.content);
+    stmt.bindInt64(3, static_cast<sqlite3_int64>(template_obj.content.size()));
+    stmt.bind(4, template_obj.id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    // An unknown id is not an error to SQLite, but the caller's list would drift
+    return stmt.step() == SQLITE_DONE && sqlite3_changes(db) == 1;
 }
 
 bool DatabaseManager::deleteTemplate(int id) {
-    const char* sql = "DELETE FROM Templates WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("DELETE FROM Templates WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing template deletion", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE && sqlite3_changes(db) == 1;
 }
 
 // Snippet operations
-bool DatabaseManager::createSnippet(const std::string& name, const std::string& content, int user_id) {
-    const char* sql = "INSERT INTO Snippets (name, content, user_id) VALUES (?, ?, ?);";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+bool DatabaseManager::createSnippet(const std::string& name, const std::string& content, int user_id, int* new_id) {
+    Statement stmt = prepare("INSERT INTO Snippets (name, content, user_id, size, updated_at) VALUES (?, ?, ?, ?, CAST(strftime('%s', 'now') AS INTEGER));");
+    if (!stmt) {
         logError("Preparing snippet creation", sqlite3_errmsg(db));
         return false;
     }
     
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, content.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 3, user_id);
+    stmt.bind(1, name);
+    stmt.bind(2, content);
+    stmt.bind(3, user_id);
+    stmt.bindInt64(4, static_cast<sqlite3_int64>(content.size()));
     
-    rc = sqlite3_step(stmt);
-    if (rc != SQLITE_DONE) {
+    if (stmt.step() != SQLITE_DONE) {
         logError("Inserting snippet", sqlite3_errmsg(db));
-        sqlite3_finalize(stmt);
         return false;
     }
-    sqlite3_finalize(stmt);
-    
-    return rc == SQLITE_DONE;
+    if (new_id) {
+        *new_id = static_cast<int>(sqlite3_last_insert_rowid(db));
+    }
+    return true;
+}
+
+bool DatabaseManager::createSnippets(const std::vector<Snippet>& snippets, std::vector<int>* new_ids) {
+    // All or nothing, and a single commit instead of one per snippet
+    Transaction transaction(*this);
+    std::vector<int> ids;
+    ids.reserve(snippets.size());
+    for (const Snippet& snippet : snippets) {
+        int new_id = 0;
+        if (!createSnippet(snippet.name, snippet.content, snippet.user_id, &new_id)) {
+            return false;
+        }
+        ids.push_back(new_id);
+    }
+    if (!transaction.commit()) {
+        return false;
+    }
+    if (new_ids) {
+        *new_ids = std::move(ids);
+    }
+    return true;
 }
 
 bool DatabaseManager::getSnippetById(int id, Snippet& snippet) {
-    const char* sql = "SELECT id, name, content, user_id FROM Snippets WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, name, content, user_id FROM Snippets WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing snippet query", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
 
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        snippet.id = sqlite3_column_int(stmt, 0);
-        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        snippet.name = name ? name : "";
-        const char* content = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        snippet.content = content ? content : "";
-        snippet.user_id = sqlite3_column_int(stmt, 3);
-        sqlite3_finalize(stmt);
-        return true;
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
     }
-    sqlite3_finalize(stmt);
-    return false;
+    snippet.id = stmt.columnInt(0);
+    snippet.name = stmt.columnText(1);
+    snippet.content = stmt.columnText(2);
+    snippet.user_id = stmt.columnInt(3);
+    return true;
 }
 
 std::vector<Snippet> DatabaseManager::getSnippetsByUserId(int user_id) {
     std::vector<Snippet> snippets;
-    const char* sql = "SELECT id, name, content, user_id FROM Snippets WHERE user_id = ?;";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, name, content, user_id FROM Snippets WHERE user_id = ?;");
+    if (!stmt) {
         logError("Preparing snippets query", sqlite3_errmsg(db));
         return snippets;
     }
     
-    sqlite3_bind_int(stmt, 1, user_id);
+    stmt.bind(1, user_id);
     
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        Snippet snippet;
-        snippet.id = sqlite3_column_int(stmt, 0);
-        
-        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        snippet.name = name ? name : "";
-        
-        const char* content = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-        snippet.content = content ? content : "";
-        
-        snippet.user_id = sqlite3_column_int(stmt, 3);
-        
-        snippets.push_back(snippet);
+    while (stmt.step() == SQLITE_ROW) {
+        snippets.push_back(Snippet{stmt.columnInt(0), stmt.columnText(1), stmt.columnText(2), stmt.columnInt(3)});
     }
     
-    sqlite3_finalize(stmt);
     return snippets;
 }
 
+std::vector<ContentSummary> DatabaseManager::getSnippetSummariesByUserId(int user_id) {
+    return getSummaries("Snippets", user_id);
+}
+
+bool DatabaseManager::getSnippetContent(int id, std::string& content) {
+    return readContent("Snippets", id, content);
+}
+
+bool DatabaseManager::getSnippetSummary(int id, ContentSummary& summary) {
+    return getSummary("Snippets", id, summary);
+}
+
 bool DatabaseManager::updateSnippet(const Snippet& snippet) {
-    const char* sql = "UPDATE Snippets SET name = ?, content = ? WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("UPDATE Snippets SET name = ?, content = ?, size = ?, updated_at = CAST(strftime('%s', 'now') AS INTEGER) WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing snippet update", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_text(stmt, 1, snippet.name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, snippet.content.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 3, snippet.id);
+    stmt.bind(1, snippet.name);
+    stmt.bind(2, snippet.content);
+    stmt.bindInt64(3, static_cast<sqlite3_int64>(snippet.content.size()));
+    stmt.bind(4, snippet.id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE && sqlite3_changes(db) == 1;
 }
 
 bool DatabaseManager::deleteSnippet(int id) {
-    const char* sql = "DELETE FROM Snippets WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("DELETE FROM Snippets WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing snippet deletion", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
+
+    return stmt.step() == SQLITE_DONE && sqlite3_changes(db) == 1;
+}
+
+std::vector<SearchHit> DatabaseManager::searchSnippets(int user_id, const std::string& text, int limit) {
+    return searchIndex("Snippets", "SnippetsSearch", user_id, text, limit);
+}
+
+std::vector<SearchHit> DatabaseManager::searchTemplates(int user_id, const std::string& text, int limit) {
+    return searchIndex("Templates", "TemplatesSearch", user_id, text, limit);
+}
+
+// Ranked by bm25 with name matches weighted well above content matches
+std::vector<SearchHit> DatabaseManager::searchIndex(const std::string& table, const std::string& index, int user_id, const std::string& text, int limit) {
+    std::vector<SearchHit> hits;
+    std::string query = FtsQuery::prefixQuery(text);
+    if (query.empty()) {
+        return hits;
+    }
+    Statement stmt = prepare(
+        "SELECT " + table + ".id, highlight(" + index + ", 0, char(1), char(2)), snippet(" + index + ", 1, char(1), char(2), '...', 12) "
+        "FROM " + index + " JOIN " + table + " ON " + table + ".id = " + index + ".rowid "
+        "WHERE " + index + " MATCH ? AND " + table + ".user_id = ? "
+        "ORDER BY bm25(" + index + ", 10.0, 1.0) LIMIT ?;");
+    if (!stmt) {
+        logError("Preparing search query", sqlite3_errmsg(db));
+        return hits;
+    }
+    stmt.bind(1, query);
+    stmt.bind(2, user_id);
+    stmt.bind(3, limit);
+
+    while (stmt.step() == SQLITE_ROW) {
+        hits.push_back(SearchHit{stmt.columnInt(0), stmt.columnText(1), stmt.columnText(2)});
+    }
+    return hits;
+}
+
+// Library operations
+bool DatabaseManager::importLibraryRecord(const LibraryRecord& record, int user_id, bool& stored) {
+    stored = false;
+    if (record.kind == LibraryRecordKind::Snippet) {
+        // Names are unique across snippets; a name owned by another user is left alone
+        Statement stmt = prepare("INSERT INTO Snippets (name, content, user_id, size, updated_at) "
+                                 "VALUES (?, ?, ?, ?, CAST(strftime('%s', 'now') AS INTEGER)) "
+                                 "ON CONFLICT(name) DO UPDATE SET content = excluded.content, size = excluded.size, "
+                                 "updated_at = excluded.updated_at WHERE Snippets.user_id = excluded.user_id;");
+        if (!stmt) {
+            logError("Preparing snippet import", sqlite3_errmsg(db));
+            return false;
+        }
+        stmt.bind(1, record.name);
+        stmt.bind(2, record.content);
+        stmt.bind(3, user_id);
+        stmt.bindInt64(4, static_cast<sqlite3_int64>(record.content.size()));
+        if (stmt.step() != SQLITE_DONE) {
+            logError("Importing snippet", sqlite3_errmsg(db));
+            return false;
+        }
+        // The upsert's WHERE turns a name owned by another user into a no-op
+        stored = sqlite3_changes(db) > 0;
+        return true;
+    }
+
+    // Template names are not unique, so only the oldest template of the same
+    // name is replaced; the others keep their own content
+    Statement stmt = prepare("UPDATE Templates SET content = ?, size = ?, updated_at = CAST(strftime('%s', 'now') AS INTEGER) "
+                             "WHERE id = (SELECT MIN(id) FROM Templates WHERE user_id = ? AND name = ?);");
+    if (!stmt) {
+        logError("Preparing template import", sqlite3_errmsg(db));
+        return false;
+    }
+    stmt.bind(1, record.content);
+    stmt.bindInt64(2, static_cast<sqlite3_int64>(record.content.size()));
+    stmt.bind(3, user_id);
+    stmt.bind(4, record.name);
+    if (stmt.step() != SQLITE_DONE) {
+        logError("Importing template", sqlite3_errmsg(db));
+        return false;
+    }
+    if (sqlite3_changes(db) == 0 && !createTemplate(record.name, record.content, user_id)) {
+        return false;
+    }
+    stored = true;
+    return true;
+}
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+bool DatabaseManager::exportLibrary(int user_id, const std::function<void(const LibraryRecord&)>& write) {
+    LibraryRecord record;
+    for (LibraryRecordKind kind : {LibraryRecordKind::Snippet, LibraryRecordKind::Template}) {
+        std::string table = kind == LibraryRecordKind::Snippet ? "Snippets" : "Templates";
+        // Rows are handed over as they are stepped, the library is never held in memory
+        Statement stmt = prepare("SELECT name, content FROM " + table + " WHERE user_id = ? ORDER BY name;");
+        if (!stmt) {
+            logError("Preparing library export", sqlite3_errmsg(db));
+            return false;
+        }
+        stmt.bind(1, user_id);
+
+        record.kind = kind;
+        int result;
+        while ((result = stmt.step()) == SQLITE_ROW) {
+            record.name = stmt.columnText(0);
+            record.content = stmt.columnText(1);
+            write(record);
+        }
+        if (result != SQLITE_DONE) {
+            logError("Exporting library", sqlite3_errmsg(db));
+            return false;
+        }
+    }
+    return true;
 }
 
 // Settings operations
 bool DatabaseManager::createSettings(const std::string& name) {
-    const char* sql = "INSERT INTO Settings (name) VALUES (?);";
-    sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("INSERT INTO Settings (name) VALUES (?);");
+    if (!stmt) {
         logError("Preparing settings creation", sqlite3_errmsg(db));
         return false;
     }
     
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
+    stmt.bind(1, name);
     
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE;
 }
 
 bool DatabaseManager::getSettingsById(int id, Settings& settings) {
-    const char* sql = "SELECT id, name FROM Settings WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("SELECT id, name FROM Settings WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing settings query", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
 
-    rc = sqlite3_step(stmt);
-    if (rc == SQLITE_ROW) {
-        settings.id = sqlite3_column_int(stmt, 0);
-        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        settings.name = name ? name : "";
-        sqlite3_finalize(stmt);
-        return true;
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
     }
-    sqlite3_finalize(stmt);
-    return false;
+    settings.id = stmt.columnInt(0);
+    settings.name = stmt.columnText(1);
+    return true;
 }
 
 bool DatabaseManager::updateSettings(const Settings& settings) {
-    const char* sql = "UPDATE Settings SET name = ? WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("UPDATE Settings SET name = ? WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing settings update", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_text(stmt, 1, settings.name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 2, settings.id);
+    stmt.bind(1, settings.name);
+    stmt.bind(2, settings.id);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
+    return stmt.step() == SQLITE_DONE;
 }
 
 bool DatabaseManager::deleteSettings(int id) {
-    const char* sql = "DELETE FROM Settings WHERE id = ?;";
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    Statement stmt = prepare("DELETE FROM Settings WHERE id = ?;");
+    if (!stmt) {
         logError("Preparing settings deletion", sqlite3_errmsg(db));
         return false;
     }
-    sqlite3_bind_int(stmt, 1, id);
+    stmt.bind(1, id);
+
+    return stmt.step() == SQLITE_DONE;
+}
+// Path index operations
+std::vector<std::string> DatabaseManager::getIndexedPaths(const std::string& root) {
+    std::vector<std::string> paths;
+    Statement stmt = prepare("SELECT path FROM PathIndex WHERE root = ?;");
+    if (!stmt) {
+        logError("Preparing path index query", sqlite3_errmsg(db));
+        return paths;
+    }
+
+    stmt.bind(1, root);
+
+    while (stmt.step() == SQLITE_ROW) {
+        paths.push_back(stmt.columnText(0));
+    }
+
+    return paths;
+}
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc == SQLITE_DONE;
-}
\ No newline at end of file
+bool DatabaseManager::updateIndexedPaths(const std::string& root, const std::vector<std::string>& added, const std::vector<std::string>& removed) {
+    if (added.empty() && removed.empty()) {
+        return true;
+    }
+    Statement insert_stmt = prepare("INSERT OR IGNORE INTO PathIndex (root, path) VALUES (?, ?);");
+    Statement delete_stmt = prepare("DELETE FROM PathIndex WHERE root = ? AND path = ?;");
+    if (!insert_stmt || !delete_stmt) {
+        logError("Preparing path index update", sqlite3_errmsg(db));
+        return false;
+    }
+
+    // One transaction for the whole batch, a fresh crawl can add thousands of rows
+    Transaction transaction(*this);
+    auto apply = [&](Statement& stmt, const std::vector<std::string>& paths) {
+        for (const std::string& path : paths) {
+            stmt.bind(1, root);
+            stmt.bind(2, path);
+            if (stmt.step() != SQLITE_DONE) {
+                logError("Updating path index", sqlite3_errmsg(db));
+                return false;
+            }
+            stmt.reset();
+        }
+        return true;
+    };
+    if (!apply(delete_stmt, removed) || !apply(insert_stmt, added)) {
+        return false;
+    }
+    return transaction.commit();
+}
+
+// Explorer filter operations
+bool DatabaseManager::getExplorerFilter(const std::string& root, std::string& patterns, bool& group_problems) {
+    Statement stmt = prepare("SELECT patterns, group_problems FROM ExplorerFilters WHERE root = ?;");
+    if (!stmt) {
+        logError("Preparing explorer filter query", sqlite3_errmsg(db));
+        return false;
+    }
+    stmt.bind(1, root);
+
+    if (stmt.step() != SQLITE_ROW) {
+        return false;
+    }
+    patterns = stmt.columnText(0);
+    group_problems = stmt.columnInt(1) != 0;
+    return true;
+}
+
+bool DatabaseManager::saveExplorerFilter(const std::string& root, const std::string& patterns, bool group_problems) {
+    Statement stmt = prepare("INSERT OR REPLACE INTO ExplorerFilters (root, patterns, group_problems) VALUES (?, ?, ?);");
+    if (!stmt) {
+        logError("Preparing explorer filter update", sqlite3_errmsg(db));
+        return false;
+    }
+    stmt.bind(1, root);
+    stmt.bind(2, patterns);
+    stmt.bind(3, group_problems ? 1 : 0);
+
+    return stmt.step() == SQLITE_DONE;
+}
+
+// Test case operations
+std::vector<TestCase> DatabaseManager::getTestCases(const std::string& file_path) {
+    std::vector<TestCase> test_cases;
+    Statement stmt = prepare(R"(
+        SELECT t.verdict, t.time_ms,
+               i.codec, i.raw_size, i.data,
+               e.codec, e.raw_size, e.data,
+               o.codec, o.raw_size, o.data
+        FROM TestCases t
+        LEFT JOIN Payloads i ON i.id = t.input_id
+        LEFT JOIN Payloads e ON e.id = t.expected_id
+        LEFT JOIN Payloads o ON o.id = t.output_id
+        WHERE t.file_path = ?
+        ORDER BY t.position;
+    )");
+    if (!stmt) {
+        logError("Preparing test cases query", sqlite3_errmsg(db));
+        return test_cases;
+    }
+    stmt.bind(1, file_path);
+
+    while (stmt.step() == SQLITE_ROW) {
+        TestCase test_case{std::string(), std::string(), std::string(), static_cast<TestVerdict>(stmt.columnInt(0)), stmt.columnInt64(1)};
+        if (!readPayload(stmt, 2, test_case.input) || !readPayload(stmt, 5, test_case.expected_output) || !readPayload(stmt, 8, test_case.last_output)) {
+            logError("Reading test case", "payload of " + file_path + " could not be decoded");
+        }
+        test_cases.push_back(std::move(test_case));
+    }
+    return test_cases;
+}
+
+// Replaces the suite of a file. The new rows go in before the old ones are
+// deleted, so payloads shared by both are found by hash instead of being
+// dropped and compressed again.
+bool DatabaseManager::saveTestCases(const std::string& file_path, const std::vector<TestCase>& test_cases) {
+    Transaction transaction(*this);
+    sqlite3_int64 first_new_id = 0;
+    for (size_t position = 0; position < test_cases.size(); position++) {
+        const TestCase& test_case = test_cases[position];
+        sqlite3_int64 input_id = 0;
+        sqlite3_int64 expected_id = 0;
+        sqlite3_int64 output_id = 0;
+        if (!storePayload(test_case.input, input_id) || !storePayload(test_case.expected_output, expected_id) ||
+            !storePayload(test_case.last_output, output_id)) {
+            return false;
+        }
+
+        Statement stmt = prepare("INSERT INTO TestCases (file_path, position, input_id, expected_id, output_id, verdict, time_ms, updated_at) "
+                                 "VALUES (?, ?, ?, ?, ?, ?, ?, CAST(strftime('%s', 'now') AS INTEGER));");
+        if (!stmt) {
+            logError("Preparing test case insert", sqlite3_errmsg(db));
+            return false;
+        }
+        stmt.bind(1, file_path);
+        stmt.bind(2, static_cast<int>(position));
+        sqlite3_int64 payload_ids[] = {input_id, expected_id, output_id};
+        for (int i = 0; i < 3; i++) {
+            if (payload_ids[i]) {
+                stmt.bindInt64(3 + i, payload_ids[i]);
+            } else {
+                stmt.bindNull(3 + i);
+            }
+        }
+        stmt.bind(6, static_cast<int>(test_case.verdict));
+        stmt.bindInt64(7, test_case.time_ms);
+        if (stmt.step() != SQLITE_DONE) {
+            logError("Inserting test case", sqlite3_errmsg(db));
+            return false;
+        }
+        if (position == 0) {
+            first_new_id = sqlite3_last_insert_rowid(db);
+        }
+    }
+
+    Statement stmt = prepare(test_cases.empty() ? "DELETE FROM TestCases WHERE file_path = ?;"
+                                                : "DELETE FROM TestCases WHERE file_path = ? AND id < ?;");
+    if (!stmt) {
+        logError("Preparing test case deletion", sqlite3_errmsg(db));
+        return false;
+    }
+    stmt.bind(1, file_path);
+    if (!test_cases.empty()) {
+        stmt.bindInt64(2, first_new_id);
+    }
+    if (stmt.step() != SQLITE_DONE) {
+        logError("Deleting test cases", sqlite3_errmsg(db));
+        return false;
+    }
+    return transaction.commit();
+}
+
+// Finds the payload with the same content or stores a new compressed one;
+// empty values are not stored and get id 0
+bool DatabaseManager::storePayload(const std::string& raw, sqlite3_int64& payload_id) {
+    payload_id = 0;
+    if (raw.empty()) {
+        return true;
+    }
+    QByteArray hash = QCryptographicHash::hash(QByteArray::fromRawData(raw.data(), static_cast<int>(raw.size())), QCryptographicHash::Sha256);
+    std::string hash_bytes(hash.constData(), hash.size());
+    {
+        Statement stmt = prepare("SELECT id FROM Payloads WHERE hash = ?;");
+        if (!stmt) {
+            logError("Preparing payload lookup", sqlite3_errmsg(db));
+            return false;
+        }
+        stmt.bindBlob(1, hash_bytes);
+        if (stmt.step() == SQLITE_ROW) {
+            payload_id = stmt.columnInt64(0);
+            return true;
+        }
+    }
+
+    PayloadCodec::Encoded encoded = PayloadCodec::encode(raw);
+    Statement stmt = prepare("INSERT INTO Payloads (hash, codec, raw_size, data) VALUES (?, ?, ?, ?);");
+    if (!stmt) {
+        logError("Preparing payload insert", sqlite3_errmsg(db));
+        return false;
+    }
+    stmt.bindBlob(1, hash_bytes);
+    stmt.bind(2, encoded.codec);
+    stmt.bindInt64(3, static_cast<sqlite3_int64>(raw.size()));
+    stmt.bindBlob(4, encoded.data);
+    if (stmt.step() != SQLITE_DONE) {
+        logError("Inserting payload", sqlite3_errmsg(db));
+        return false;
+    }
+    payload_id = sqlite3_last_insert_rowid(db);
+    return true;
+}
+
+// Decodes the (codec, raw_size, data) columns starting at column; a NULL
+// codec is a value that was empty when saved
+bool DatabaseManager::readPayload(Statement& stmt, int column, std::string& raw) {
+    if (stmt.columnIsNull(column)) {
+        raw.clear();
+        return true;
+    }
+    return PayloadCodec::decode(stmt.columnInt(column), stmt.columnBlob(column + 2), static_cast<size_t>(stmt.columnInt64(column + 1)), raw);
+}
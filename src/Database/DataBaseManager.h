@@ -2,12 +2,16 @@
 #define DATABASEMANAGER_H
 
 #include <sqlite3.h>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
 #include <QStandardPaths>
 #include <QDir>
 #include <QString>
+#include "StatementCache/StatementCache.h"
+#include "SchemaMigrations/SchemaMigrations.h"
+#include "LibraryArchive/LibraryArchive.h"
 
 struct User {
     int id;
@@ -30,6 +34,40 @@ struct Snippet {
     int user_id;
 };
 
+// List row for snippets and templates, everything but the content
+struct ContentSummary {
+    int id;
+    std::string name;
+    long long size;       // content bytes
+    long long updated_at; // unix seconds, 0 for rows older than the column
+};
+
+// Outcome of the last run of a test case
+enum class TestVerdict {
+    None = 0,     // never run
+    Ran,          // ran to completion, no expected output to compare with
+    Accepted,
+    WrongAnswer,
+    RuntimeError,
+    TimeLimit,
+    CompileError
+};
+
+struct TestCase {
+    std::string input;
+    std::string expected_output; // empty when not known
+    std::string last_output;
+    TestVerdict verdict;
+    long long time_ms;           // duration of the last run, -1 before any
+};
+
+// One search result; name and excerpt carry FtsQuery match markers
+struct SearchHit {
+    int id;
+    std::string name;
+    std::string excerpt;
+};
+
 struct Settings {
     int id;
     std::string name;
@@ -37,12 +75,34 @@ struct Settings {
 
 class DatabaseManager {
 public:
+    // Groups the writes made while it lives into one transaction, so they
+    // share a single commit. Rolls back unless commit() is called; inside an
+    // already open transaction it joins the outer one.
+    class Transaction {
+    public:
+        explicit Transaction(DatabaseManager& manager);
+        ~Transaction();
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+        bool commit();
+
+    private:
+        DatabaseManager& manager;
+        bool owns;
+        bool finished;
+    };
+
     DatabaseManager();
     ~DatabaseManager();
     
     // Database initialization
     bool initializeDatabase();
     bool isDatabaseInitialized() const;
+
+    // Transaction operations, prefer the Transaction guard
+    bool beginTransaction();
+    bool commitTransaction();
+    void rollbackTransaction();
     
     // User operations
     bool createUser(const std::string& codeforces_handle, const std::string& email);
@@ -52,34 +112,75 @@ public:
     std::vector<User> getAllUsers();
     
     // Template operations
-    bool createTemplate(const std::string& name, const std::string& content, int user_id);
+    bool createTemplate(const std::string& name, const std::string& content, int user_id, int* new_id = nullptr);
     bool getTemplateById(int id, Template& template_obj);
     bool updateTemplate(const Template& template_obj);
     bool deleteTemplate(int id);
     std::vector<Template> getTemplatesByUserId(int user_id);
+    std::vector<ContentSummary> getTemplateSummariesByUserId(int user_id);
+    bool getTemplateContent(int id, std::string& content);
+    bool getTemplateSummary(int id, ContentSummary& summary);
     
     // Snippet operations
-    bool createSnippet(const std::string& name, const std::string& content, int user_id);
+    bool createSnippet(const std::string& name, const std::string& content, int user_id, int* new_id = nullptr);
+    bool createSnippets(const std::vector<Snippet>& snippets, std::vector<int>* new_ids = nullptr);
     bool getSnippetById(int id, Snippet& snippet);
     bool updateSnippet(const Snippet& snippet);
     bool deleteSnippet(int id);
     std::vector<Snippet> getSnippetsByUserId(int user_id);
+    std::vector<ContentSummary> getSnippetSummariesByUserId(int user_id);
+    bool getSnippetContent(int id, std::string& content);
+    bool getSnippetSummary(int id, ContentSummary& summary);
+
+    // Full-text search, text is what the user typed
+    std::vector<SearchHit> searchSnippets(int user_id, const std::string& text, int limit);
+    std::vector<SearchHit> searchTemplates(int user_id, const std::string& text, int limit);
+
+    // Library operations (portable archive). An imported record replaces the
+    // user's snippet or template of the same name; wrap many in a Transaction.
+    // stored is false for a snippet whose name belongs to another user.
+    bool importLibraryRecord(const LibraryRecord& record, int user_id, bool& stored);
+    bool exportLibrary(int user_id, const std::function<void(const LibraryRecord&)>& write);
     
     // Settings operations
     bool createSettings(const std::string& name);
     bool getSettingsById(int id, Settings& settings);
     bool updateSettings(const Settings& settings);
     bool deleteSettings(int id);
+
+    // Path index operations (quick open), paths are relative to root
+    std::vector<std::string> getIndexedPaths(const std::string& root);
+    bool updateIndexedPaths(const std::string& root, const std::vector<std::string>& added, const std::vector<std::string>& removed);
+
+    // Explorer filter operations, one row per opened folder
+    bool getExplorerFilter(const std::string& root, std::string& patterns, bool& group_problems);
+    bool saveExplorerFilter(const std::string& root, const std::string& patterns, bool group_problems);
+
+    // Test case operations, the suite of a source file in order
+    std::vector<TestCase> getTestCases(const std::string& file_path);
+    bool saveTestCases(const std::string& file_path, const std::vector<TestCase>& test_cases);
     
 private:
     sqlite3* db;
     std::string db_path;
+    std::unique_ptr<StatementCache> statements; // every query of this connection, parsed once
     
     // Helper methodss
     std::string getDatabasePath();
-    bool createTables();
+    static std::vector<SchemaMigration> schemaHistory();
+    bool migrateSchema();
+    std::vector<ContentSummary> getSummaries(const std::string& table, int user_id);
+    bool getSummary(const std::string& table, int id, ContentSummary& summary);
+    bool readContent(const std::string& table, int id, std::string& content);
+    bool storePayload(const std::string& raw, sqlite3_int64& payload_id);
+    bool readPayload(Statement& stmt, int column, std::string& raw);
+    std::vector<SearchHit> searchIndex(const std::string& table, const std::string& index, int user_id, const std::string& text, int limit);
     bool executeSQL(const std::string& sql);
+    Statement prepare(const std::string& sql);
     void logError(const std::string& operation, const std::string& error);
+
+    static constexpr int PAGE_CACHE_KIB = 8192;
+    static constexpr long long MMAP_SIZE_BYTES = 64LL * 1024 * 1024;
 };
 
 #endif // DATABASEMANAGER_H
\ No newline at end of file
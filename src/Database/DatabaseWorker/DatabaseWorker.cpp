@@ -0,0 +1,376 @@
+#include "DatabaseWorker.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    bool eraseSummary(std::vector<ContentSummary> &summaries, int id) {
+        auto found = std::find_if(summaries.begin(), summaries.end(), [id](const ContentSummary &summary) { return summary.id == id; });
+        if (found == summaries.end()) {
+            return false;
+        }
+        summaries.erase(found);
+        return true;
+    }
+
+    // Cached lists keep the ORDER BY name of the query that filled them
+    bool insertSummary(std::vector<ContentSummary> &summaries, const ContentSummary &summary) {
+        auto position = std::upper_bound(summaries.begin(), summaries.end(), summary.name,
+                                         [](const std::string &name, const ContentSummary &other) { return name < other.name; });
+        summaries.insert(position, summary);
+        return true;
+    }
+
+    // A write answers with the row as the list shows it, so the owner's cached
+    // list is patched rather than read again; other users' lists stay as they are.
+    void applySummary(RecordCache<std::vector<ContentSummary>> &cache, int user_id, const ContentSummary &summary) {
+        cache.updateAll([&summary](std::vector<ContentSummary> &summaries) { return eraseSummary(summaries, summary.id); });
+        cache.update(user_id, [&summary](std::vector<ContentSummary> &summaries) { return insertSummary(summaries, summary); });
+    }
+
+    void removeSummary(RecordCache<std::vector<ContentSummary>> &cache, int id) {
+        cache.updateAll([id](std::vector<ContentSummary> &summaries) { return eraseSummary(summaries, id); });
+    }
+}
+
+DatabaseWorker::DatabaseWorker(QObject *parent) : QObject(parent), db_manager(std::make_unique<DatabaseManager>()) {
+    thread = new QThread(this);
+    thread->setObjectName("DatabaseWorker");
+    thread_context = new QObject();
+    thread_context->moveToThread(thread);
+}
+
+void DatabaseWorker::start() {
+    if (!thread->isRunning() && !thread->isFinished()) {
+        thread->start();
+    }
+}
+
+DatabaseWorker::~DatabaseWorker() {
+    // Queued behind the pending jobs, so writes made right before exit still land
+    QMetaObject::invokeMethod(thread_context, [worker_thread = thread]() { worker_thread->quit(); }, Qt::QueuedConnection);
+    start();
+    thread->wait();
+    delete thread_context;
+    db_manager.reset();
+}
+
+QFuture<bool> DatabaseWorker::initialize(int user_id) {
+    return run([user_id](DatabaseManager &db) {
+        if (!db.initializeDatabase()) {
+            return false;
+        }
+        User user;
+        return db.getUserById(user_id, user) || db.createUser("default_handle", "default@email.com");
+    });
+}
+
+uint64_t DatabaseWorker::generation(CachedTable table) const {
+    switch (table) {
+    case CachedTable::Users:
+        return users.generation();
+    case CachedTable::Settings:
+        return settings.generation();
+    case CachedTable::Snippets:
+        return snippet_summaries.generation();
+    case CachedTable::Templates:
+        return template_summaries.generation();
+    }
+    return 0;
+}
+
+const User *DatabaseWorker::cachedUser(int user_id) const {
+    return users.find(user_id);
+}
+
+const Settings *DatabaseWorker::cachedSettings(int settings_id) const {
+    return settings.find(settings_id);
+}
+
+const std::vector<ContentSummary> *DatabaseWorker::cachedSnippetSummaries(int user_id) const {
+    return snippet_summaries.find(user_id);
+}
+
+const std::vector<ContentSummary> *DatabaseWorker::cachedTemplateSummaries(int user_id) const {
+    return template_summaries.find(user_id);
+}
+
+// Continuations run on the GUI thread in the order the jobs finished, which
+// is the order they were queued, so a read never overwrites a later write.
+QFuture<std::optional<User>> DatabaseWorker::fetchUser(int user_id) {
+    if (const User *cached = users.find(user_id)) {
+        return readyFuture(std::optional<User>(*cached));
+    }
+    return run([user_id](DatabaseManager &db) {
+        User user;
+        return db.getUserById(user_id, user) ? std::optional<User>(user) : std::nullopt;
+    }).then(this, [this](std::optional<User> user) {
+        if (user) {
+            users.put(user->id, *user);
+        }
+        return user;
+    });
+}
+
+QFuture<bool> DatabaseWorker::updateUser(const User &user) {
+    return run([user](DatabaseManager &db) { return db.updateUser(user); }).then(this, [this, user](bool updated) {
+        if (updated) {
+            users.put(user.id, user);
+        } else {
+            users.erase(user.id);
+        }
+        return updated;
+    });
+}
+
+QFuture<std::optional<Settings>> DatabaseWorker::fetchSettings(int settings_id) {
+    if (const Settings *cached = settings.find(settings_id)) {
+        return readyFuture(std::optional<Settings>(*cached));
+    }
+    return run([settings_id](DatabaseManager &db) {
+        Settings stored;
+        return db.getSettingsById(settings_id, stored) ? std::optional<Settings>(stored) : std::nullopt;
+    }).then(this, [this](std::optional<Settings> stored) {
+        if (stored) {
+            settings.put(stored->id, *stored);
+        }
+        return stored;
+    });
+}
+
+QFuture<bool> DatabaseWorker::updateSettings(const Settings &updated_settings) {
+    return run([updated_settings](DatabaseManager &db) { return db.updateSettings(updated_settings); }).then(this, [this, updated_settings](bool updated) {
+        if (updated) {
+            settings.put(updated_settings.id, updated_settings);
+        } else {
+            settings.erase(updated_settings.id);
+        }
+        return updated;
+    });
+}
+
+QFuture<bool> DatabaseWorker::deleteSettings(int settings_id) {
+    return run([settings_id](DatabaseManager &db) { return db.deleteSettings(settings_id); }).then(this, [this, settings_id](bool deleted) {
+        settings.erase(settings_id);
+        // Users pointing at it had settings_id set to NULL by the foreign key
+        users.clear();
+        return deleted;
+    });
+}
+
+QFuture<std::vector<Template>> DatabaseWorker::fetchTemplates(int user_id) {
+    return run([user_id](DatabaseManager &db) { return db.getTemplatesByUserId(user_id); });
+}
+
+QFuture<std::vector<ContentSummary>> DatabaseWorker::fetchTemplateSummaries(int user_id) {
+    if (const std::vector<ContentSummary> *cached = template_summaries.find(user_id)) {
+        return readyFuture(*cached);
+    }
+    return run([user_id](DatabaseManager &db) { return db.getTemplateSummariesByUserId(user_id); }).then(this, [this, user_id](std::vector<ContentSummary> summaries) {
+        template_summaries.put(user_id, summaries);
+        return summaries;
+    });
+}
+
+QFuture<std::optional<std::string>> DatabaseWorker::fetchTemplateContent(int template_id) {
+    return run([template_id](DatabaseManager &db) {
+        std::string content;
+        return db.getTemplateContent(template_id, content) ? std::optional<std::string>(std::move(content)) : std::nullopt;
+    });
+}
+
+QFuture<std::optional<ContentSummary>> DatabaseWorker::createTemplate(const Template &template_obj) {
+    return run([template_obj](DatabaseManager &db) {
+        int new_id = -1;
+        ContentSummary summary;
+        bool created = db.createTemplate(template_obj.name, template_obj.content, template_obj.user_id, &new_id) && db.getTemplateSummary(new_id, summary);
+        return created ? std::optional<ContentSummary>(summary) : std::nullopt;
+    }).then(this, [this, user_id = template_obj.user_id](std::optional<ContentSummary> summary) {
+        if (summary) {
+            applySummary(template_summaries, user_id, *summary);
+        }
+        return summary;
+    });
+}
+
+QFuture<std::optional<ContentSummary>> DatabaseWorker::updateTemplate(const Template &template_obj) {
+    return run([template_obj](DatabaseManager &db) {
+        ContentSummary summary;
+        bool updated = db.updateTemplate(template_obj) && db.getTemplateSummary(template_obj.id, summary);
+        return updated ? std::optional<ContentSummary>(summary) : std::nullopt;
+    }).then(this, [this, user_id = template_obj.user_id](std::optional<ContentSummary> summary) {
+        if (summary) {
+            applySummary(template_summaries, user_id, *summary);
+        }
+        return summary;
+    });
+}
+
+QFuture<bool> DatabaseWorker::deleteTemplate(int template_id) {
+    return run([template_id](DatabaseManager &db) { return db.deleteTemplate(template_id); }).then(this, [this, template_id](bool deleted) {
+        if (deleted) {
+            removeSummary(template_summaries, template_id);
+        }
+        return deleted;
+    });
+}
+
+QFuture<std::vector<SearchHit>> DatabaseWorker::searchTemplates(int user_id, const std::string &text, int limit) {
+    return run([user_id, text, limit](DatabaseManager &db) { return db.searchTemplates(user_id, text, limit); });
+}
+
+QFuture<std::vector<Snippet>> DatabaseWorker::fetchSnippets(int user_id) {
+    return run([user_id](DatabaseManager &db) { return db.getSnippetsByUserId(user_id); });
+}
+
+QFuture<std::vector<ContentSummary>> DatabaseWorker::fetchSnippetSummaries(int user_id) {
+    if (const std::vector<ContentSummary> *cached = snippet_summaries.find(user_id)) {
+        return readyFuture(*cached);
+    }
+    return run([user_id](DatabaseManager &db) { return db.getSnippetSummariesByUserId(user_id); }).then(this, [this, user_id](std::vector<ContentSummary> summaries) {
+        snippet_summaries.put(user_id, summaries);
+        return summaries;
+    });
+}
+
+QFuture<std::optional<std::string>> DatabaseWorker::fetchSnippetContent(int snippet_id) {
+    return run([snippet_id](DatabaseManager &db) {
+        std::string content;
+        return db.getSnippetContent(snippet_id, content) ? std::optional<std::string>(std::move(content)) : std::nullopt;
+    });
+}
+
+QFuture<std::optional<ContentSummary>> DatabaseWorker::createSnippet(const Snippet &snippet) {
+    return run([snippet](DatabaseManager &db) {
+        int new_id = -1;
+        ContentSummary summary;
+        bool created = db.createSnippet(snippet.name, snippet.content, snippet.user_id, &new_id) && db.getSnippetSummary(new_id, summary);
+        return created ? std::optional<ContentSummary>(summary) : std::nullopt;
+    }).then(this, [this, user_id = snippet.user_id](std::optional<ContentSummary> summary) {
+        if (summary) {
+            applySummary(snippet_summaries, user_id, *summary);
+        }
+        return summary;
+    });
+}
+
+QFuture<std::optional<ContentSummary>> DatabaseWorker::updateSnippet(const Snippet &snippet) {
+    return run([snippet](DatabaseManager &db) {
+        ContentSummary summary;
+        bool updated = db.updateSnippet(snippet) && db.getSnippetSummary(snippet.id, summary);
+        return updated ? std::optional<ContentSummary>(summary) : std::nullopt;
+    }).then(this, [this, user_id = snippet.user_id](std::optional<ContentSummary> summary) {
+        if (summary) {
+            applySummary(snippet_summaries, user_id, *summary);
+        }
+        return summary;
+    });
+}
+
+QFuture<bool> DatabaseWorker::deleteSnippet(int snippet_id) {
+    return run([snippet_id](DatabaseManager &db) { return db.deleteSnippet(snippet_id); }).then(this, [this, snippet_id](bool deleted) {
+        if (deleted) {
+            removeSummary(snippet_summaries, snippet_id);
+        }
+        return deleted;
+    });
+}
+
+QFuture<std::vector<SearchHit>> DatabaseWorker::searchSnippets(int user_id, const std::string &text, int limit) {
+    return run([user_id, text, limit](DatabaseManager &db) { return db.searchSnippets(user_id, text, limit); });
+}
+
+QFuture<std::vector<std::string>> DatabaseWorker::fetchIndexedPaths(const std::string &root) {
+    return run([root](DatabaseManager &db) { return db.getIndexedPaths(root); });
+}
+
+QFuture<bool> DatabaseWorker::updateIndexedPaths(const std::string &root, std::vector<std::string> added, std::vector<std::string> removed) {
+    return run([root, added = std::move(added), removed = std::move(removed)](DatabaseManager &db) { return db.updateIndexedPaths(root, added, removed); });
+}
+
+QFuture<std::optional<ExplorerFilterSetting>> DatabaseWorker::fetchExplorerFilter(const std::string &root) {
+    return run([root](DatabaseManager &db) {
+        ExplorerFilterSetting setting{std::string(), false};
+        return db.getExplorerFilter(root, setting.patterns, setting.group_problems) ? std::optional<ExplorerFilterSetting>(setting) : std::nullopt;
+    });
+}
+
+QFuture<bool> DatabaseWorker::saveExplorerFilter(const std::string &root, const ExplorerFilterSetting &setting) {
+    return run([root, setting](DatabaseManager &db) { return db.saveExplorerFilter(root, setting.patterns, setting.group_problems); });
+}
+
+QFuture<std::vector<TestCase>> DatabaseWorker::fetchTestCases(const std::string &file_path) {
+    return run([file_path](DatabaseManager &db) { return db.getTestCases(file_path); });
+}
+
+QFuture<bool> DatabaseWorker::saveTestCases(const std::string &file_path, std::vector<TestCase> test_cases) {
+    return run([file_path, test_cases = std::move(test_cases)](DatabaseManager &db) { return db.saveTestCases(file_path, test_cases); });
+}
+
+QFuture<LibraryTransfer> DatabaseWorker::importLibrary(const std::string &archive_path, int user_id) {
+    return run([this, archive_path, user_id](DatabaseManager &db) {
+        std::ifstream in(archive_path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            return LibraryTransfer{false, 0, "Cannot open " + archive_path};
+        }
+        qint64 total = static_cast<qint64>(in.tellg());
+        in.seekg(0);
+
+        // One transaction for the whole file: a single commit, and a broken
+        // line halfway through leaves the library as it was
+        DatabaseManager::Transaction transaction(db);
+        LibraryReader reader(in);
+        LibraryRecord record;
+        long long imported = 0;
+        long long records_read = 0;
+        std::vector<std::string> skipped;
+        while (reader.next(record)) {
+            bool stored = false;
+            if (!db.importLibraryRecord(record, user_id, stored)) {
+                return LibraryTransfer{false, imported, "Failed to store \"" + record.name + "\""};
+            }
+            if (stored) {
+                imported++;
+            } else {
+                skipped.push_back(record.name);
+            }
+            if (++records_read % LIBRARY_PROGRESS_RECORDS == 0) {
+                // Emitted from the database thread, receivers get it queued
+                emit libraryProgress(reader.bytesRead(), total);
+            }
+        }
+        if (!reader.error().empty()) {
+            return LibraryTransfer{false, imported, reader.error()};
+        }
+        if (!transaction.commit()) {
+            return LibraryTransfer{false, imported, "Failed to save the imported library"};
+        }
+        emit libraryProgress(total, total);
+        return LibraryTransfer{true, imported, std::string(), std::move(skipped)};
+    }).then(this, [this](LibraryTransfer transfer) {
+        if (transfer.ok) {
+            snippet_summaries.clear();
+            template_summaries.clear();
+        }
+        return transfer;
+    });
+}
+
+QFuture<LibraryTransfer> DatabaseWorker::exportLibrary(const std::string &archive_path, int user_id) {
+    return run([archive_path, user_id](DatabaseManager &db) {
+        std::ofstream out(archive_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return LibraryTransfer{false, 0, "Cannot write " + archive_path};
+        }
+        LibraryWriter writer(out);
+        long long exported = 0;
+        bool read = db.exportLibrary(user_id, [&](const LibraryRecord &record) {
+            writer.write(record);
+            exported++;
+        });
+        out.flush();
+        if (!read || !out) {
+            return LibraryTransfer{false, exported, read ? "Cannot write " + archive_path : "Failed to read the library"};
+        }
+        return LibraryTransfer{true, exported, std::string()};
+    });
+}
@@ -0,0 +1,146 @@
+#ifndef DATABASEWORKER_H
+#define DATABASEWORKER_H
+
+#include <QFuture>
+#include <QObject>
+#include <QPromise>
+#include <QThread>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../DataBaseManager.h"
+#include "../RecordCache/RecordCache.h"
+
+struct ExplorerFilterSetting {
+    std::string patterns;
+    bool group_problems;
+};
+
+// Outcome of a library import or export
+struct LibraryTransfer {
+    bool ok;
+    long long records; // snippets and templates read or written
+    std::string error; // empty when ok
+    std::vector<std::string> skipped; // imported snippet names owned by another user
+};
+
+// Owns the kodetron.db connection on a thread of its own so a slow disk
+// never stalls the GUI. Jobs run one at a time in the order they were
+// queued; results come back as QFutures, and callers attach a continuation
+// with future.then(this, ...) to have it queued back onto their thread.
+// Nothing runs before start(), so startup can queue work while it builds the
+// window and only open the database once the window is on screen.
+//
+// Users, settings and the snippet and template lists are also cached on the
+// GUI thread: once read, a fetch answers with a ready future and cached*()
+// returns a pointer without queueing anything. Writes through this class
+// update or invalidate the cache when they succeed.
+class DatabaseWorker : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit DatabaseWorker(QObject *parent = nullptr);
+    ~DatabaseWorker(); // runs every queued job before closing the connection
+    void start();       // begins running queued jobs
+
+    // job(DatabaseManager &) runs on the database thread
+    template <typename Job>
+    auto run(Job job) -> QFuture<std::invoke_result_t<Job, DatabaseManager &>>;
+
+    QFuture<bool> initialize(int user_id); // opens the database and makes sure the user exists
+
+    enum class CachedTable { Users, Settings, Snippets, Templates };
+    // Changes whenever cached data of the table changes, for cheap freshness checks
+    uint64_t generation(CachedTable table) const;
+    // GUI thread only; nullptr until read once, valid until the next write
+    const User *cachedUser(int user_id) const;
+    const Settings *cachedSettings(int settings_id) const;
+    const std::vector<ContentSummary> *cachedSnippetSummaries(int user_id) const;
+    const std::vector<ContentSummary> *cachedTemplateSummaries(int user_id) const;
+
+    QFuture<std::optional<User>> fetchUser(int user_id);
+    QFuture<bool> updateUser(const User &user);
+
+    QFuture<std::optional<Settings>> fetchSettings(int settings_id);
+    QFuture<bool> updateSettings(const Settings &settings);
+    QFuture<bool> deleteSettings(int settings_id);
+
+    QFuture<std::vector<Template>> fetchTemplates(int user_id);
+    QFuture<std::vector<ContentSummary>> fetchTemplateSummaries(int user_id);
+    QFuture<std::optional<std::string>> fetchTemplateContent(int template_id);
+    // Create and update answer with the row as the list shows it, for applying in place
+    QFuture<std::optional<ContentSummary>> createTemplate(const Template &template_obj);
+    QFuture<std::optional<ContentSummary>> updateTemplate(const Template &template_obj);
+    QFuture<bool> deleteTemplate(int template_id);
+    QFuture<std::vector<SearchHit>> searchTemplates(int user_id, const std::string &text, int limit);
+
+    QFuture<std::vector<Snippet>> fetchSnippets(int user_id);
+    QFuture<std::vector<ContentSummary>> fetchSnippetSummaries(int user_id);
+    QFuture<std::optional<std::string>> fetchSnippetContent(int snippet_id);
+    QFuture<std::optional<ContentSummary>> createSnippet(const Snippet &snippet);
+    QFuture<std::optional<ContentSummary>> updateSnippet(const Snippet &snippet);
+    QFuture<bool> deleteSnippet(int snippet_id);
+    QFuture<std::vector<SearchHit>> searchSnippets(int user_id, const std::string &text, int limit);
+
+    QFuture<std::vector<std::string>> fetchIndexedPaths(const std::string &root);
+    QFuture<bool> updateIndexedPaths(const std::string &root, std::vector<std::string> added, std::vector<std::string> removed);
+
+    QFuture<std::optional<ExplorerFilterSetting>> fetchExplorerFilter(const std::string &root);
+    QFuture<bool> saveExplorerFilter(const std::string &root, const ExplorerFilterSetting &setting);
+
+    QFuture<std::vector<TestCase>> fetchTestCases(const std::string &file_path);
+    QFuture<bool> saveTestCases(const std::string &file_path, std::vector<TestCase> test_cases);
+
+    // The archive is streamed on the database thread. An import is all or
+    // nothing and reports libraryProgress while it runs.
+    QFuture<LibraryTransfer> importLibrary(const std::string &archive_path, int user_id);
+    QFuture<LibraryTransfer> exportLibrary(const std::string &archive_path, int user_id);
+
+  signals:
+    void libraryProgress(qint64 bytes_done, qint64 bytes_total);
+
+  private:
+    template <typename T>
+    static QFuture<T> readyFuture(T value);
+
+    QThread *thread;
+    QObject *thread_context; // lives on thread, jobs are queued to it
+    std::unique_ptr<DatabaseManager> db_manager;
+    RecordCache<User> users;
+    RecordCache<Settings> settings;
+    RecordCache<std::vector<ContentSummary>> snippet_summaries;  // by user id
+    RecordCache<std::vector<ContentSummary>> template_summaries; // by user id
+
+    static constexpr int LIBRARY_PROGRESS_RECORDS = 500;
+};
+
+template <typename Job>
+auto DatabaseWorker::run(Job job) -> QFuture<std::invoke_result_t<Job, DatabaseManager &>> {
+    using Result = std::invoke_result_t<Job, DatabaseManager &>;
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+    QMetaObject::invokeMethod(thread_context, [manager = db_manager.get(), promise, job = std::move(job)]() mutable {
+        if constexpr (std::is_void_v<Result>) {
+            job(*manager);
+        } else {
+            promise->addResult(job(*manager));
+        }
+        promise->finish();
+    }, Qt::QueuedConnection);
+    return future;
+}
+
+template <typename T>
+QFuture<T> DatabaseWorker::readyFuture(T value) {
+    QPromise<T> promise;
+    promise.start();
+    promise.addResult(std::move(value));
+    promise.finish();
+    return promise.future();
+}
+
+#endif // DATABASEWORKER_H
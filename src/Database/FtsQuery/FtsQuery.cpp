@@ -0,0 +1,62 @@
+#include "FtsQuery.h"
+#include <cctype>
+
+namespace FtsQuery {
+    namespace {
+        bool isWordByte(unsigned char c) {
+            // Multi-byte UTF-8 is kept whole; the tokenizer splits each quoted word again
+            return std::isalnum(c) || c == '_' || c >= 0x80;
+        }
+    }
+
+    std::string prefixQuery(const std::string &text) {
+        std::string query;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            while (pos < text.size() && !isWordByte(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+            size_t start = pos;
+            while (pos < text.size() && isWordByte(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+            if (pos > start) {
+                if (!query.empty()) {
+                    query += ' ';
+                }
+                query += '"' + text.substr(start, pos - start) + "\"*";
+            }
+        }
+        return query;
+    }
+
+    std::string markedToHtml(const std::string &marked) {
+        std::string html;
+        html.reserve(marked.size() + 16);
+        for (char c : marked) {
+            switch (c) {
+            case '\x01':
+                html += "<b>";
+                break;
+            case '\x02':
+                html += "</b>";
+                break;
+            case '<':
+                html += "&lt;";
+                break;
+            case '>':
+                html += "&gt;";
+                break;
+            case '&':
+                html += "&amp;";
+                break;
+            case '\n':
+                html += ' ';
+                break;
+            default:
+                html += c;
+            }
+        }
+        return html;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef FTSQUERY_H
+#define FTSQUERY_H
+
+#include <string>
+
+// Helpers around SQLite FTS5 for the snippet and template search boxes.
+namespace FtsQuery {
+    // highlight() and snippet() wrap matches in these, the GUI turns them into markup
+    constexpr const char *MATCH_START = "\x01";
+    constexpr const char *MATCH_END = "\x02";
+
+    // Turns what the user typed into a prefix query: std::vec -> "std"* "vec"*.
+    // Every word is quoted, so no FTS5 syntax in the input reaches the query.
+    // Empty when the text has no word.
+    std::string prefixQuery(const std::string &text);
+
+    // HTML-escapes a highlighted excerpt and renders the matches in bold
+    std::string markedToHtml(const std::string &marked);
+}
+
+#endif // FTSQUERY_H
@@ -0,0 +1,361 @@
+#include "LibraryArchive.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr const char* FORMAT_NAME = "kodetron-library";
+    constexpr const char* FORMAT_VERSION = "1";
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    void appendUtf8(std::string& out, unsigned int code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    // Just enough JSON for flat objects: string values are unescaped, other
+    // scalars are returned as written, nested values are rejected
+    class LineParser {
+    public:
+        explicit LineParser(const std::string& line) : line(line), pos(0) {}
+
+        template <typename OnField>
+        bool parseObject(OnField on_field, std::string& error) {
+            skipSpace();
+            if (!consume('{')) {
+                error = "expected an object";
+                return false;
+            }
+            skipSpace();
+            if (consume('}')) {
+                return atEnd(error);
+            }
+            std::string key;
+            std::string value;
+            while (true) {
+                skipSpace();
+                if (!parseString(key)) {
+                    error = "expected a quoted key";
+                    return false;
+                }
+                skipSpace();
+                if (!consume(':')) {
+                    error = "expected ':' after \"" + key + "\"";
+                    return false;
+                }
+                skipSpace();
+                bool is_string = pos < line.size() && line[pos] == '"';
+                if (is_string ? !parseString(value) : !parseScalar(value)) {
+                    error = "unsupported value for \"" + key + "\"";
+                    return false;
+                }
+                on_field(key, value, is_string);
+                skipSpace();
+                if (consume('}')) {
+                    return atEnd(error);
+                }
+                if (!consume(',')) {
+                    error = "expected ',' or '}'";
+                    return false;
+                }
+            }
+        }
+
+    private:
+        void skipSpace() {
+            while (pos < line.size() && isSpace(line[pos])) {
+                pos++;
+            }
+        }
+
+        bool consume(char c) {
+            if (pos < line.size() && line[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool atEnd(std::string& error) {
+            skipSpace();
+            if (pos != line.size()) {
+                error = "trailing characters after the object";
+                return false;
+            }
+            return true;
+        }
+
+        bool readHex(unsigned int& value) {
+            if (pos + 4 > line.size()) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 4; i++) {
+                char c = line[pos++];
+                value <<= 4;
+                if (c >= '0' && c <= '9') {
+                    value |= c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    value |= c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    value |= c - 'A' + 10;
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool parseString(std::string& out) {
+            out.clear();
+            if (!consume('"')) {
+                return false;
+            }
+            while (pos < line.size()) {
+                // Copy the unescaped run in one go, most content has few escapes
+                size_t run_end = pos;
+                while (run_end < line.size() && line[run_end] != '"' && line[run_end] != '\\') {
+                    run_end++;
+                }
+                out.append(line, pos, run_end - pos);
+                pos = run_end;
+                if (pos >= line.size()) {
+                    break;
+                }
+                if (line[pos++] == '"') {
+                    return true;
+                }
+                if (pos >= line.size()) {
+                    return false;
+                }
+                char escaped = line[pos++];
+                switch (escaped) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        unsigned int code_point = 0;
+                        if (!readHex(code_point)) {
+                            return false;
+                        }
+                        // Characters outside the BMP arrive as a surrogate pair
+                        if (code_point >= 0xD800 && code_point < 0xDC00 && pos + 1 < line.size() &&
+                            line[pos] == '\\' && line[pos + 1] == 'u') {
+                            size_t pair_start = pos;
+                            pos += 2;
+                            unsigned int low = 0;
+                            if (readHex(low) && low >= 0xDC00 && low < 0xE000) {
+                                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                            } else {
+                                pos = pair_start;
+                            }
+                        }
+                        appendUtf8(out, code_point);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            return false;
+        }
+
+        bool parseScalar(std::string& out) {
+            size_t start = pos;
+            while (pos < line.size() && line[pos] != ',' && line[pos] != '}' && !isSpace(line[pos])) {
+                if (line[pos] == '{' || line[pos] == '[' || line[pos] == '"') {
+                    return false;
+                }
+                pos++;
+            }
+            out.assign(line, start, pos - start);
+            return pos > start;
+        }
+
+        const std::string& line;
+        size_t pos;
+    };
+
+    void appendEscaped(std::string& out, const std::string& value) {
+        static const char* HEX_DIGITS = "0123456789abcdef";
+        out += '"';
+        for (char c : value) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out += "\\u00";
+                        out += HEX_DIGITS[(c >> 4) & 0xF];
+                        out += HEX_DIGITS[c & 0xF];
+                    } else {
+                        // UTF-8 is valid JSON as it is
+                        out += c;
+                    }
+            }
+        }
+        out += '"';
+    }
+}
+
+LibraryReader::LibraryReader(std::istream& in)
+    : in(in), buffer(BUFFER_SIZE, '\0'), buffer_pos(0), buffer_end(0), bytes_read(0), line_number(0), header_read(false) {}
+
+const std::string& LibraryReader::error() const {
+    return error_message;
+}
+
+long long LibraryReader::bytesRead() const {
+    return bytes_read;
+}
+
+bool LibraryReader::fail(const std::string& message) {
+    error_message = "line " + std::to_string(line_number) + ": " + message;
+    return false;
+}
+
+// A line longer than the buffer is assembled over several refills
+bool LibraryReader::readLine(std::string& line) {
+    line.clear();
+    bool found_any = false;
+    while (true) {
+        if (buffer_pos == buffer_end) {
+            in.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+            buffer_pos = 0;
+            buffer_end = static_cast<size_t>(in.gcount());
+            if (buffer_end == 0) {
+                return found_any;
+            }
+        }
+        found_any = true;
+        const char* start = buffer.data() + buffer_pos;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', buffer_end - buffer_pos));
+        size_t length = newline ? static_cast<size_t>(newline - start) : buffer_end - buffer_pos;
+        line.append(start, length);
+        buffer_pos += length;
+        bytes_read += static_cast<long long>(length);
+        if (newline) {
+            buffer_pos++;
+            bytes_read++;
+            return true;
+        }
+    }
+}
+
+bool LibraryReader::next(LibraryRecord& record) {
+    if (!error_message.empty()) {
+        return false;
+    }
+    std::string line;
+    while (readLine(line)) {
+        line_number++;
+        size_t first = 0;
+        while (first < line.size() && isSpace(line[first])) {
+            first++;
+        }
+        if (first == line.size()) {
+            continue;
+        }
+
+        LineParser parser(line);
+        std::string parse_error;
+        if (!header_read) {
+            std::string format;
+            std::string version;
+            bool parsed = parser.parseObject([&](const std::string& key, const std::string& value, bool) {
+                if (key == "format") {
+                    format = value;
+                } else if (key == "version") {
+                    version = value;
+                }
+            }, parse_error);
+            if (!parsed) {
+                return fail(parse_error);
+            }
+            if (format != FORMAT_NAME) {
+                return fail("not a kodetron library");
+            }
+            if (version != FORMAT_VERSION) {
+                return fail("unsupported library version " + version);
+            }
+            header_read = true;
+            continue;
+        }
+
+        std::string kind;
+        bool has_name = false;
+        bool has_content = false;
+        bool parsed = parser.parseObject([&](const std::string& key, const std::string& value, bool is_string) {
+            if (key == "kind") {
+                kind = value;
+            } else if (key == "name" && is_string) {
+                record.name = value;
+                has_name = true;
+            } else if (key == "content" && is_string) {
+                record.content = value;
+                has_content = true;
+            }
+        }, parse_error);
+        if (!parsed) {
+            return fail(parse_error);
+        }
+        if (kind == "snippet") {
+            record.kind = LibraryRecordKind::Snippet;
+        } else if (kind == "template") {
+            record.kind = LibraryRecordKind::Template;
+        } else {
+            return fail("unknown record kind \"" + kind + "\"");
+        }
+        if (!has_name || record.name.empty() || !has_content) {
+            return fail("record without a name or content");
+        }
+        // The snippet and template editors refuse blank content, so must imports
+        if (std::all_of(record.content.begin(), record.content.end(), isSpace)) {
+            return fail("\"" + record.name + "\" has no content");
+        }
+        return true;
+    }
+    if (in.bad()) {
+        error_message = "read error";
+    } else if (!header_read) {
+        error_message = "empty file";
+    }
+    return false;
+}
+
+LibraryWriter::LibraryWriter(std::ostream& out) : out(out) {
+    out << "{\"format\":\"" << FORMAT_NAME << "\",\"version\":" << FORMAT_VERSION << "}\n";
+}
+
+void LibraryWriter::write(const LibraryRecord& record) {
+    line.clear();
+    line += record.kind == LibraryRecordKind::Snippet ? "{\"kind\":\"snippet\",\"name\":" : "{\"kind\":\"template\",\"name\":";
+    appendEscaped(line, record.name);
+    line += ",\"content\":";
+    appendEscaped(line, record.content);
+    line += "}\n";
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
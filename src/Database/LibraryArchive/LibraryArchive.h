@@ -0,0 +1,68 @@
+#ifndef LIBRARYARCHIVE_H
+#define LIBRARYARCHIVE_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Portable snippet and template library, one JSON object per line:
+//
+//   {"format":"kodetron-library","version":1}
+//   {"kind":"snippet","name":"dsu","content":"struct DSU {...}"}
+//   {"kind":"template","name":"default","content":"..."}
+//
+// The first line identifies the file, every other line is a record. Keys
+// other than kind, name and content are ignored so later versions can add
+// fields without breaking older builds.
+enum class LibraryRecordKind { Snippet, Template };
+
+struct LibraryRecord {
+    LibraryRecordKind kind;
+    std::string name;
+    std::string content;
+};
+
+// Pulls records one at a time. The file is read through a buffer of
+// BUFFER_SIZE bytes, so memory stays bounded by the largest single record
+// no matter how many records the archive holds.
+class LibraryReader {
+public:
+    explicit LibraryReader(std::istream& in);
+    LibraryReader(const LibraryReader&) = delete;
+    LibraryReader& operator=(const LibraryReader&) = delete;
+
+    // False at the end of the archive or on a malformed line, see error()
+    bool next(LibraryRecord& record);
+    // Empty unless reading stopped on a malformed line
+    const std::string& error() const;
+    // Bytes consumed from the stream so far, for progress reporting
+    long long bytesRead() const;
+
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+private:
+    bool readLine(std::string& line);
+    bool fail(const std::string& message);
+
+    std::istream& in;
+    std::string buffer;
+    size_t buffer_pos;
+    size_t buffer_end;
+    long long bytes_read;
+    long long line_number;
+    bool header_read;
+    std::string error_message;
+};
+
+class LibraryWriter {
+public:
+    explicit LibraryWriter(std::ostream& out); // writes the header line
+    void write(const LibraryRecord& record);
+
+private:
+    std::ostream& out;
+    std::string line; // reused between records
+};
+
+#endif // LIBRARYARCHIVE_H
@@ -0,0 +1,74 @@
+#include "PayloadCodec.h"
+#ifdef KODETRON_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef KODETRON_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace PayloadCodec {
+    namespace {
+#ifdef KODETRON_HAVE_ZSTD
+        // Level 3 is zstd's default: several hundred MB/s, close to zlib's best ratio
+        constexpr int ZSTD_LEVEL = 3;
+#endif
+
+        bool compress(const std::string& raw, Encoded& encoded) {
+#if defined(KODETRON_HAVE_ZSTD)
+            std::string data(ZSTD_compressBound(raw.size()), '\0');
+            size_t written = ZSTD_compress(data.data(), data.size(), raw.data(), raw.size(), ZSTD_LEVEL);
+            if (ZSTD_isError(written)) {
+                return false;
+            }
+            data.resize(written);
+            encoded = Encoded{ZSTD, std::move(data)};
+            return true;
+#elif defined(KODETRON_HAVE_ZLIB)
+            uLongf written = compressBound(static_cast<uLong>(raw.size()));
+            std::string data(written, '\0');
+            if (compress2(reinterpret_cast<Bytef*>(data.data()), &written, reinterpret_cast<const Bytef*>(raw.data()),
+                          static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION) != Z_OK) {
+                return false;
+            }
+            data.resize(written);
+            encoded = Encoded{ZLIB, std::move(data)};
+            return true;
+#else
+            (void)raw;
+            (void)encoded;
+            return false;
+#endif
+        }
+    }
+
+    Encoded encode(const std::string& raw) {
+        Encoded encoded;
+        if (raw.size() >= MIN_COMPRESSED_SIZE && compress(raw, encoded) && encoded.data.size() < raw.size()) {
+            return encoded;
+        }
+        return Encoded{RAW, raw};
+    }
+
+    bool decode(int codec, const std::string& data, size_t raw_size, std::string& raw) {
+        if (codec == RAW) {
+            raw = data;
+            return raw.size() == raw_size;
+        }
+#ifdef KODETRON_HAVE_ZSTD
+        if (codec == ZSTD) {
+            raw.assign(raw_size, '\0');
+            size_t read = ZSTD_decompress(raw.data(), raw.size(), data.data(), data.size());
+            return !ZSTD_isError(read) && read == raw_size;
+        }
+#endif
+#ifdef KODETRON_HAVE_ZLIB
+        if (codec == ZLIB) {
+            raw.assign(raw_size, '\0');
+            uLongf read = static_cast<uLongf>(raw_size);
+            int result = uncompress(reinterpret_cast<Bytef*>(raw.data()), &read, reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()));
+            return result == Z_OK && read == raw_size;
+        }
+#endif
+        return false;
+    }
+}
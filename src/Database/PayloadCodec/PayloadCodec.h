@@ -0,0 +1,30 @@
+#ifndef PAYLOADCODEC_H
+#define PAYLOADCODEC_H
+
+#include <cstddef>
+#include <string>
+
+// Compression of large stored values (test inputs and outputs). zstd is used
+// when the build found it (KODETRON_HAVE_ZSTD), zlib otherwise; values that
+// are small or do not shrink are kept as they are. The codec id is stored next
+// to the data, so a file written with either compressor stays readable by a
+// build that has it.
+namespace PayloadCodec {
+    constexpr int RAW = 0;
+    constexpr int ZLIB = 1;
+    constexpr int ZSTD = 2;
+
+    // Below this many bytes compression costs more than it saves
+    constexpr size_t MIN_COMPRESSED_SIZE = 256;
+
+    struct Encoded {
+        int codec;
+        std::string data;
+    };
+
+    Encoded encode(const std::string& raw);
+    // False when the codec is unknown to this build or the data is damaged
+    bool decode(int codec, const std::string& data, size_t raw_size, std::string& raw);
+}
+
+#endif // PAYLOADCODEC_H
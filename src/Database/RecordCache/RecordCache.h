@@ -0,0 +1,71 @@
+#ifndef RECORDCACHE_H
+#define RECORDCACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+// Records of one type keyed by id. A read is a hash lookup returning a
+// pointer that stays valid until that id is written or erased. Every write
+// bumps generation(), so a view that copied data out can tell it is stale by
+// comparing one integer.
+template <typename T>
+class RecordCache {
+public:
+    const T* find(int id) const {
+        auto entry = records.find(id);
+        return entry != records.end() ? &entry->second : nullptr;
+    }
+
+    void put(int id, T value) {
+        records.insert_or_assign(id, std::move(value));
+        current_generation++;
+    }
+
+    void erase(int id) {
+        if (records.erase(id) > 0) {
+            current_generation++;
+        }
+    }
+
+    // Edits a cached record in place; update(T&) returns whether it changed
+    // anything. Uncached ids are left alone, they are read fresh anyway.
+    template <typename Update>
+    void update(int id, Update update) {
+        auto entry = records.find(id);
+        if (entry != records.end() && update(entry->second)) {
+            current_generation++;
+        }
+    }
+
+    // The same for every cached record, when the owning id is not known
+    template <typename Update>
+    void updateAll(Update update) {
+        bool changed = false;
+        for (auto& entry : records) {
+            changed = update(entry.second) || changed;
+        }
+        if (changed) {
+            current_generation++;
+        }
+    }
+
+    void clear() {
+        records.clear();
+        current_generation++;
+    }
+
+    uint64_t generation() const {
+        return current_generation;
+    }
+
+    size_t size() const {
+        return records.size();
+    }
+
+private:
+    std::unordered_map<int, T> records; // node based, so pointers survive rehashing
+    uint64_t current_generation = 0;
+};
+
+#endif // RECORDCACHE_H
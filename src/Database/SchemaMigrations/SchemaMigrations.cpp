@@ -0,0 +1,94 @@
+#include "SchemaMigrations.h"
+#include <algorithm>
+
+namespace SchemaMigrations {
+    namespace {
+        bool exists(sqlite3* db, const std::string& sql, const std::string& first, const std::string& second) {
+            sqlite3_stmt* stmt = nullptr;
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                return false;
+            }
+            sqlite3_bind_text(stmt, 1, first.c_str(), -1, SQLITE_TRANSIENT);
+            if (!second.empty()) {
+                sqlite3_bind_text(stmt, 2, second.c_str(), -1, SQLITE_TRANSIENT);
+            }
+            bool found = sqlite3_step(stmt) == SQLITE_ROW;
+            sqlite3_finalize(stmt);
+            return found;
+        }
+    }
+
+    int currentVersion(sqlite3* db) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &stmt, nullptr) != SQLITE_OK) {
+            return -1;
+        }
+        int version = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : -1;
+        sqlite3_finalize(stmt);
+        return version;
+    }
+
+    bool migrate(sqlite3* db, std::vector<SchemaMigration> steps, std::string* error) {
+        std::sort(steps.begin(), steps.end(), [](const SchemaMigration& a, const SchemaMigration& b) { return a.version < b.version; });
+        int version = currentVersion(db);
+        if (version < 0) {
+            if (error) {
+                *error = sqlite3_errmsg(db);
+            }
+            return false;
+        }
+        int latest = steps.empty() ? 0 : steps.back().version;
+        if (version > latest) {
+            if (error) {
+                *error = "schema version " + std::to_string(version) + " is newer than this build knows (" + std::to_string(latest) + ")";
+            }
+            return false;
+        }
+        if (version == latest) {
+            return true;
+        }
+
+        // IMMEDIATE takes the write lock up front, so a second instance
+        // starting at the same time waits instead of migrating twice
+        if (!execute(db, "BEGIN IMMEDIATE;")) {
+            if (error) {
+                *error = sqlite3_errmsg(db);
+            }
+            return false;
+        }
+        // Re-read under the lock in case another process just migrated
+        version = currentVersion(db);
+        for (const SchemaMigration& step : steps) {
+            if (step.version <= version) {
+                continue;
+            }
+            if (!step.apply(db) || !execute(db, "PRAGMA user_version = " + std::to_string(step.version) + ";")) {
+                if (error) {
+                    *error = "migration " + std::to_string(step.version) + " (" + step.description + "): " + sqlite3_errmsg(db);
+                }
+                execute(db, "ROLLBACK;");
+                return false;
+            }
+        }
+        if (!execute(db, "COMMIT;")) {
+            if (error) {
+                *error = sqlite3_errmsg(db);
+            }
+            execute(db, "ROLLBACK;");
+            return false;
+        }
+        return true;
+    }
+
+    bool execute(sqlite3* db, const std::string& sql) {
+        return sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+
+    bool hasTable(sqlite3* db, const std::string& table) {
+        return exists(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?;", table, std::string());
+    }
+
+    bool hasColumn(sqlite3* db, const std::string& table, const std::string& column) {
+        return exists(db, "SELECT 1 FROM pragma_table_info(?) WHERE name = ?;", table, column);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef SCHEMAMIGRATIONS_H
+#define SCHEMAMIGRATIONS_H
+
+#include <sqlite3.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// One step of the schema history. Once applied the database's
+// PRAGMA user_version is set to its version.
+struct SchemaMigration {
+    int version;
+    std::string description;
+    std::function<bool(sqlite3* db)> apply;
+};
+
+// Brings a database up to date by running every step newer than its
+// user_version, in version order, all in one transaction: a failing step
+// leaves the file exactly as it was found.
+namespace SchemaMigrations {
+    int currentVersion(sqlite3* db);
+    // False with the reason in error when a step fails or the file was
+    // written by a newer build than the steps know about
+    bool migrate(sqlite3* db, std::vector<SchemaMigration> steps, std::string* error = nullptr);
+
+    // Helpers for writing steps
+    bool execute(sqlite3* db, const std::string& sql);
+    bool hasTable(sqlite3* db, const std::string& table);
+    bool hasColumn(sqlite3* db, const std::string& table, const std::string& column);
+}
+
+#endif // SCHEMAMIGRATIONS_H
@@ -0,0 +1,132 @@
+#include "StatementCache.h"
+#include <utility>
+
+Statement::Statement() : stmt(nullptr), in_use(nullptr) {}
+
+Statement::Statement(sqlite3_stmt* stmt, bool* in_use) : stmt(stmt), in_use(in_use) {}
+
+Statement::~Statement() {
+    release();
+}
+
+Statement::Statement(Statement&& other) noexcept : stmt(std::exchange(other.stmt, nullptr)), in_use(std::exchange(other.in_use, nullptr)) {}
+
+Statement& Statement::operator=(Statement&& other) noexcept {
+    if (this != &other) {
+        release();
+        stmt = std::exchange(other.stmt, nullptr);
+        in_use = std::exchange(other.in_use, nullptr);
+    }
+    return *this;
+}
+
+void Statement::release() {
+    if (!stmt) {
+        return;
+    }
+    if (in_use) {
+        reset();
+        *in_use = false;
+    } else {
+        sqlite3_finalize(stmt);
+    }
+    stmt = nullptr;
+    in_use = nullptr;
+}
+
+Statement::operator bool() const {
+    return stmt != nullptr;
+}
+
+sqlite3_stmt* Statement::get() const {
+    return stmt;
+}
+
+void Statement::bind(int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+void Statement::bind(int index, int value) {
+    sqlite3_bind_int(stmt, index, value);
+}
+
+void Statement::bindInt64(int index, sqlite3_int64 value) {
+    sqlite3_bind_int64(stmt, index, value);
+}
+
+void Statement::bindBlob(int index, const std::string& value) {
+    sqlite3_bind_blob(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+void Statement::bindNull(int index) {
+    sqlite3_bind_null(stmt, index);
+}
+
+int Statement::step() {
+    return sqlite3_step(stmt);
+}
+
+void Statement::reset() {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+}
+
+int Statement::columnInt(int column) const {
+    return sqlite3_column_int(stmt, column);
+}
+
+sqlite3_int64 Statement::columnInt64(int column) const {
+    return sqlite3_column_int64(stmt, column);
+}
+
+std::string Statement::columnText(int column) const {
+    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+    return text ? std::string(text, sqlite3_column_bytes(stmt, column)) : std::string();
+}
+
+std::string Statement::columnBlob(int column) const {
+    const char* data = static_cast<const char*>(sqlite3_column_blob(stmt, column));
+    return data ? std::string(data, sqlite3_column_bytes(stmt, column)) : std::string();
+}
+
+bool Statement::columnIsNull(int column) const {
+    return sqlite3_column_type(stmt, column) == SQLITE_NULL;
+}
+
+StatementCache::StatementCache(sqlite3* db) : db(db) {}
+
+StatementCache::~StatementCache() {
+    for (auto& [sql, entry] : statements) {
+        sqlite3_finalize(entry.stmt);
+    }
+}
+
+Statement StatementCache::get(const std::string& sql) {
+    auto it = statements.find(sql);
+    if (it != statements.end() && !it->second.in_use) {
+        it->second.in_use = true;
+        return Statement(it->second.stmt, &it->second.in_use);
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (it != statements.end()) {
+        // The cached copy is still stepping (nested use), hand out a one-off
+        if (sqlite3_prepare_v2(db, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr) != SQLITE_OK || !stmt) {
+            sqlite3_finalize(stmt);
+            return Statement();
+        }
+        return Statement(stmt, nullptr);
+    }
+
+    if (sqlite3_prepare_v3(db, sql.c_str(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK || !stmt) {
+        sqlite3_finalize(stmt);
+        return Statement();
+    }
+    // unordered_map nodes never move, so the in_use flag address stays valid
+    Entry& entry = statements.emplace(sql, Entry{stmt, true}).first->second;
+    return Statement(stmt, &entry.in_use);
+}
+
+size_t StatementCache::size() const {
+    return statements.size();
+}
@@ -0,0 +1,73 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <sqlite3.h>
+#include <string>
+#include <unordered_map>
+
+// Handle to a prepared statement. When it goes out of scope the statement is
+// reset and its bindings cleared, so every return path leaves a cached
+// statement ready for the next caller.
+class Statement {
+public:
+    Statement();
+    Statement(sqlite3_stmt* stmt, bool* in_use);
+    ~Statement();
+    Statement(Statement&& other) noexcept;
+    Statement& operator=(Statement&& other) noexcept;
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    explicit operator bool() const;
+    sqlite3_stmt* get() const;
+
+    // Text and blobs are bound without copying, the string must outlive the
+    // step calls; temporaries are rejected at compile time for that reason
+    void bind(int index, const std::string& value);
+    void bind(int index, std::string&& value) = delete;
+    void bind(int index, int value);
+    void bindInt64(int index, sqlite3_int64 value);
+    void bindBlob(int index, const std::string& value);
+    void bindBlob(int index, std::string&& value) = delete;
+    void bindNull(int index);
+    int step();
+    // Ready to bind and step again, for running one statement over a batch
+    void reset();
+    int columnInt(int column) const;
+    sqlite3_int64 columnInt64(int column) const;
+    std::string columnText(int column) const;
+    std::string columnBlob(int column) const;
+    bool columnIsNull(int column) const;
+
+private:
+    void release();
+
+    sqlite3_stmt* stmt;
+    bool* in_use; // flag in the owning cache, nullptr for a one-off statement
+};
+
+// Prepared statements of one connection keyed by their SQL text. Each is
+// parsed once and kept until the cache is destroyed, which must happen
+// before the connection is closed.
+class StatementCache {
+public:
+    explicit StatementCache(sqlite3* db);
+    ~StatementCache();
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    // Empty handle when the SQL does not compile, sqlite3_errmsg has the reason
+    Statement get(const std::string& sql);
+    size_t size() const;
+
+private:
+    struct Entry {
+        sqlite3_stmt* stmt;
+        bool in_use;
+    };
+
+    sqlite3* db;
+    std::unordered_map<std::string, Entry> statements;
+};
+
+#endif // STATEMENTCACHE_H
@@ -0,0 +1,81 @@
+#include "DirectoryEnumerator.h"
+
+#ifdef __linux__
+#include <cstddef>
+#include <cstdint>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#include <system_error>
+#endif
+
+#ifdef __linux__
+namespace {
+    // Kernel layout of a getdents64 record, glibc does not export it
+    struct LinuxDirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[1];
+    };
+
+    constexpr size_t BUFFER_BYTES = 64 * 1024;
+}
+
+namespace DirectoryEnumerator {
+    bool list(const std::string &dir_path, std::vector<DirectoryEntry> &entries) {
+        int fd = open(dir_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        alignas(LinuxDirent64) static thread_local char buffer[BUFFER_BYTES];
+        bool ok = true;
+        while (true) {
+            long bytes = syscall(SYS_getdents64, fd, buffer, BUFFER_BYTES);
+            if (bytes <= 0) {
+                ok = bytes == 0;
+                break;
+            }
+            for (long offset = 0; offset < bytes;) {
+                const LinuxDirent64 *record = reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+                offset += record->d_reclen;
+                const char *name = record->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                    continue;
+                }
+                bool is_dir = record->d_type == DT_DIR;
+                if (record->d_type == DT_UNKNOWN || record->d_type == DT_LNK) {
+                    struct stat info;
+                    is_dir = fstatat(fd, name, &info, 0) == 0 && S_ISDIR(info.st_mode);
+                }
+                entries.push_back(DirectoryEntry{name, is_dir});
+            }
+        }
+        close(fd);
+        return ok;
+    }
+}
+#else
+namespace DirectoryEnumerator {
+    bool list(const std::string &dir_path, std::vector<DirectoryEntry> &entries) {
+        std::error_code error;
+        std::filesystem::directory_iterator iterator(std::filesystem::u8path(dir_path), error);
+        if (error) {
+            return false;
+        }
+        for (; iterator != std::filesystem::directory_iterator(); iterator.increment(error)) {
+            if (error) {
+                return false;
+            }
+            std::error_code type_error;
+            entries.push_back(DirectoryEntry{iterator->path().filename().u8string(), iterator->is_directory(type_error)});
+        }
+        return true;
+    }
+}
+#endif
@@ -0,0 +1,20 @@
+#ifndef DIRECTORYENUMERATOR_H
+#define DIRECTORYENUMERATOR_H
+
+#include <string>
+#include <vector>
+
+struct DirectoryEntry {
+    std::string name;
+    bool is_dir; // symlinks report their target
+};
+
+// Lists one directory without building a QFileInfo per entry. On Linux the
+// entries and their types come straight from getdents64, so only symlinks
+// and file systems that do not fill d_type cost an extra stat.
+namespace DirectoryEnumerator {
+    // False if the directory could not be opened or read
+    bool list(const std::string &dir_path, std::vector<DirectoryEntry> &entries);
+}
+
+#endif // DIRECTORYENUMERATOR_H
@@ -0,0 +1,368 @@
+#include "DirectoryWatcher.h"
+#include "../../Global/AppState.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QThread>
+#include <iostream>
+#include <memory>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+#ifdef Q_OS_LINUX
+    constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+#endif
+}
+
+DirectoryWatcher &DirectoryWatcher::instance() {
+    static DirectoryWatcher instance;
+    return instance;
+}
+
+DirectoryWatcher::DirectoryWatcher(QObject *parent)
+    : QObject(parent), root_generation(0), inotify_fd(-1), inotify_notifier(nullptr), fallback_watcher(nullptr) {
+    flush_timer = new QTimer(this);
+    flush_timer->setSingleShot(true);
+    flush_timer->setInterval(FLUSH_INTERVAL_MS);
+    connect(flush_timer, &QTimer::timeout, this, &DirectoryWatcher::flush);
+
+#ifdef Q_OS_LINUX
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd >= 0) {
+        inotify_notifier = new QSocketNotifier(inotify_fd, QSocketNotifier::Read, this);
+        connect(inotify_notifier, &QSocketNotifier::activated, this, &DirectoryWatcher::onInotifyReadable);
+    }
+#endif
+    if (inotify_fd < 0) {
+        fallback_watcher = new QFileSystemWatcher(this);
+        connect(fallback_watcher, &QFileSystemWatcher::directoryChanged, this, &DirectoryWatcher::onFallbackDirectoryChanged);
+    }
+
+    connect(&AppState::instance(), &AppState::selectedDirPathModified, this, &DirectoryWatcher::setRoot);
+    // The singleton outlives the event loop, release the descriptor while it still runs
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &DirectoryWatcher::shutdown);
+}
+
+QString DirectoryWatcher::rootPath() const {
+    return root_path;
+}
+
+void DirectoryWatcher::shutdown() {
+    clearWatches();
+#ifdef Q_OS_LINUX
+    delete inotify_notifier;
+    inotify_notifier = nullptr;
+    if (inotify_fd >= 0) {
+        close(inotify_fd);
+        inotify_fd = -1;
+    }
+#endif
+}
+
+void DirectoryWatcher::clearWatches() {
+#ifdef Q_OS_LINUX
+    for (auto it = paths_by_watch.constBegin(); it != paths_by_watch.constEnd(); ++it) {
+        inotify_rm_watch(inotify_fd, it.key());
+    }
+#endif
+    paths_by_watch.clear();
+    watches_by_path.clear();
+    if (fallback_watcher && !fallback_watcher->directories().isEmpty()) {
+        fallback_watcher->removePaths(fallback_watcher->directories());
+    }
+    snapshots.clear();
+    flush_timer->stop();
+    pending.clear();
+}
+
+bool DirectoryWatcher::isWatchedDirectoryName(const QString &name) {
+    // Hidden trees (.git and friends) churn constantly and are never shown
+    return !name.startsWith('.');
+}
+
+void DirectoryWatcher::setRoot(const QString &new_root_path) {
+    QString clean_root = new_root_path.isEmpty() ? QString() : QDir::cleanPath(new_root_path);
+    if (clean_root == root_path) {
+        return;
+    }
+    clearWatches();
+    root_path = clean_root;
+    quint64 generation = ++root_generation;
+    if (root_path.isEmpty()) {
+        return;
+    }
+
+    if (fallback_watcher) {
+        watchTree(root_path, false);
+        return;
+    }
+    // Walking a large tree is slow, only the watch registration runs here
+    auto dir_paths = std::make_shared<QStringList>();
+    QString walk_root = root_path;
+    QThread *walker = QThread::create([walk_root, dir_paths]() {
+        QStringList pending{walk_root};
+        while (!pending.isEmpty()) {
+            QString dir_path = pending.takeLast();
+            *dir_paths << dir_path;
+            QDirIterator entries(dir_path, QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+            while (entries.hasNext()) {
+                entries.next();
+                if (isWatchedDirectoryName(entries.fileName())) {
+                    pending << entries.filePath();
+                }
+            }
+        }
+    });
+    connect(walker, &QThread::finished, this, [this, dir_paths, generation]() { onDirectoriesCollected(*dir_paths, generation); });
+    connect(walker, &QThread::finished, walker, &QObject::deleteLater);
+    walker->start(QThread::LowPriority);
+}
+
+void DirectoryWatcher::onDirectoriesCollected(const QStringList &dir_paths, quint64 generation) {
+    if (generation != root_generation) {
+        return;
+    }
+    for (const QString &dir_path : dir_paths) {
+        if (!watchDirectory(dir_path)) {
+            break;
+        }
+    }
+}
+
+bool DirectoryWatcher::watchDirectory(const QString &dir_path) {
+#ifdef Q_OS_LINUX
+    if (inotify_fd >= 0) {
+        int watch = inotify_add_watch(inotify_fd, QFile::encodeName(dir_path).constData(), WATCH_MASK);
+        if (watch < 0) {
+            if (errno == ENOSPC) {
+                std::cerr << "DirectoryWatcher: inotify watch limit reached, raise fs.inotify.max_user_watches" << std::endl;
+                return false;
+            }
+            return true;
+        }
+        paths_by_watch.insert(watch, dir_path);
+        watches_by_path.insert(dir_path, watch);
+        return true;
+    }
+#endif
+    QHash<QString, bool> &snapshot = snapshots[dir_path];
+    QDirIterator entries(dir_path, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden);
+    while (entries.hasNext()) {
+        entries.next();
+        snapshot.insert(entries.fileName(), entries.fileInfo().isDir());
+    }
+    fallback_watcher->addPath(dir_path);
+    return true;
+}
+
+// Registers a directory and everything under it. For a directory that just
+// appeared, its current contents are reported too: files created before the
+// watch existed would otherwise never produce an event.
+void DirectoryWatcher::watchTree(const QString &dir_path, bool report_contents) {
+    QStringList pending{dir_path};
+    while (!pending.isEmpty()) {
+        QString current = pending.takeLast();
+        if (!watchDirectory(current)) {
+            return;
+        }
+        QDirIterator entries(current, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden);
+        while (entries.hasNext()) {
+            entries.next();
+            QFileInfo info = entries.fileInfo();
+            bool is_dir = info.isDir() && !info.isSymLink();
+            if (report_contents) {
+                queueChange(FileChange::Kind::Added, info.filePath(), is_dir);
+            }
+            if (is_dir && isWatchedDirectoryName(info.fileName())) {
+                pending << info.filePath();
+            }
+        }
+    }
+}
+
+void DirectoryWatcher::unwatchTree(const QString &dir_path) {
+    QString prefix = dir_path + "/";
+    QStringList removed;
+    for (auto it = watches_by_path.constBegin(); it != watches_by_path.constEnd(); ++it) {
+        if (it.key() == dir_path || it.key().startsWith(prefix)) {
+            removed << it.key();
+        }
+    }
+    for (const QString &path : removed) {
+        int watch = watches_by_path.take(path);
+        paths_by_watch.remove(watch);
+#ifdef Q_OS_LINUX
+        inotify_rm_watch(inotify_fd, watch);
+#endif
+    }
+    for (auto it = snapshots.begin(); it != snapshots.end();) {
+        if (it.key() == dir_path || it.key().startsWith(prefix)) {
+            fallback_watcher->removePath(it.key());
+            it = snapshots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FileChangeBatch::add(FileChange::Kind kind, const QString &path, bool is_dir) {
+    auto existing = entries.find(path);
+    if (existing == entries.end()) {
+        order << path;
+        entries.insert(path, Entry{FileChange{kind, path, is_dir}, kind});
+        return;
+    }
+    // Compared with the first event: Removed, Added, Removed of an old file is still a removal
+    if (existing->first_kind == FileChange::Kind::Added && kind == FileChange::Kind::Removed) {
+        entries.erase(existing);
+        return;
+    }
+    existing->change.kind = kind;
+    existing->change.is_dir = is_dir;
+}
+
+bool FileChangeBatch::isEmpty() const {
+    return entries.isEmpty();
+}
+
+QList<FileChange> FileChangeBatch::take() {
+    QList<FileChange> changes;
+    changes.reserve(entries.size());
+    // A path dropped and seen again is listed twice in order, but reported once
+    for (const QString &path : order) {
+        auto entry = entries.find(path);
+        if (entry != entries.end()) {
+            changes << entry->change;
+            entries.erase(entry);
+        }
+    }
+    clear();
+    return changes;
+}
+
+void FileChangeBatch::clear() {
+    order.clear();
+    entries.clear();
+}
+
+void DirectoryWatcher::queueChange(FileChange::Kind kind, const QString &path, bool is_dir) {
+    pending.add(kind, path, is_dir);
+    if (!flush_timer->isActive()) {
+        flush_timer->start();
+    }
+}
+
+void DirectoryWatcher::flush() {
+    QList<FileChange> changes = pending.take();
+    if (!changes.isEmpty()) {
+        emit changesReady(changes);
+    }
+}
+
+// Nothing under the old path can be watched any more; consumers decide what
+// to show instead
+void DirectoryWatcher::onRootGone() {
+    QString gone_path = root_path;
+    clearWatches();
+    root_path.clear();
+    root_generation++;
+    emit rootRemoved(gone_path);
+}
+
+void DirectoryWatcher::onInotifyReadable() {
+#ifdef Q_OS_LINUX
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    bool overflowed = false;
+    while (true) {
+        ssize_t length = read(inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+        for (char *cursor = buffer; cursor < buffer + length;) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(cursor);
+            cursor += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflowed = true;
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                watches_by_path.remove(paths_by_watch.take(event->wd));
+                continue;
+            }
+            auto dir = paths_by_watch.constFind(event->wd);
+            if (dir != paths_by_watch.constEnd() && (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))) {
+                // Subdirectories were already reported through their parent
+                if (dir.value() == root_path) {
+                    onRootGone();
+                    return;
+                }
+                continue;
+            }
+            if (dir == paths_by_watch.constEnd() || event->len == 0) {
+                continue;
+            }
+            QString name = QFile::decodeName(event->name);
+            QString path = dir.value() + "/" + name;
+            bool is_dir = event->mask & IN_ISDIR;
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                queueChange(FileChange::Kind::Added, path, is_dir);
+                if (is_dir && isWatchedDirectoryName(name)) {
+                    watchTree(path, true);
+                }
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                queueChange(FileChange::Kind::Removed, path, is_dir);
+                if (is_dir) {
+                    unwatchTree(path);
+                }
+            }
+        }
+    }
+    if (overflowed) {
+        flush();
+        emit resyncRequired();
+    }
+#endif
+}
+
+void DirectoryWatcher::onFallbackDirectoryChanged(const QString &dir_path) {
+    auto snapshot = snapshots.find(dir_path);
+    if (snapshot == snapshots.end()) {
+        return;
+    }
+    if (dir_path == root_path && !QFileInfo(root_path).isDir()) {
+        onRootGone();
+        return;
+    }
+    QHash<QString, bool> previous = *snapshot;
+    QHash<QString, bool> current;
+    QDirIterator entries(dir_path, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden);
+    while (entries.hasNext()) {
+        entries.next();
+        current.insert(entries.fileName(), entries.fileInfo().isDir() && !entries.fileInfo().isSymLink());
+    }
+    *snapshot = current;
+
+    for (auto it = previous.constBegin(); it != previous.constEnd(); ++it) {
+        if (!current.contains(it.key())) {
+            queueChange(FileChange::Kind::Removed, dir_path + "/" + it.key(), it.value());
+            if (it.value()) {
+                unwatchTree(dir_path + "/" + it.key());
+            }
+        }
+    }
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it) {
+        if (!previous.contains(it.key())) {
+            queueChange(FileChange::Kind::Added, dir_path + "/" + it.key(), it.value());
+            if (it.value() && isWatchedDirectoryName(it.key())) {
+                watchTree(dir_path + "/" + it.key(), true);
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef DIRECTORYWATCHER_H
+#define DIRECTORYWATCHER_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+struct FileChange {
+    enum class Kind { Added, Removed };
+    Kind kind;
+    QString path; // absolute
+    bool is_dir;
+};
+
+// Net effect of the events seen for each path since the last take(). A path
+// created and deleted again is dropped; one that existed before the batch is
+// reported by its last event, whatever happened in between.
+class FileChangeBatch {
+  public:
+    void add(FileChange::Kind kind, const QString &path, bool is_dir);
+    bool isEmpty() const;
+    QList<FileChange> take(); // in the order paths were first seen
+    void clear();
+
+  private:
+    struct Entry {
+        FileChange change;
+        FileChange::Kind first_kind; // Added: the path did not exist before the batch
+    };
+    QStringList order;
+    QHash<QString, Entry> entries;
+};
+
+// Watches the opened folder recursively and reports what was added or
+// removed. Events are coalesced and delivered at most once per frame, so a
+// script writing a thousand test files produces a handful of batches.
+// Uses inotify on Linux and QFileSystemWatcher with directory snapshots
+// elsewhere.
+class DirectoryWatcher : public QObject {
+    Q_OBJECT
+
+  public:
+    static DirectoryWatcher &instance(); // Global access to the singleton
+    QString rootPath() const;
+
+  signals:
+    void changesReady(const QList<FileChange> &changes);
+    void resyncRequired(); // events were dropped, consumers should re-list what they show
+    void rootRemoved(const QString &root_path); // the folder itself was deleted or renamed, watching stopped
+
+  private:
+    explicit DirectoryWatcher(QObject *parent = nullptr);
+    void setRoot(const QString &root_path);
+    void shutdown();
+    void clearWatches();
+    void onDirectoriesCollected(const QStringList &dir_paths, quint64 generation);
+    void watchTree(const QString &dir_path, bool report_contents);
+    bool watchDirectory(const QString &dir_path);
+    void unwatchTree(const QString &dir_path);
+    void queueChange(FileChange::Kind kind, const QString &path, bool is_dir);
+    void flush();
+    void onInotifyReadable();
+    void onFallbackDirectoryChanged(const QString &dir_path);
+    void onRootGone();
+    static bool isWatchedDirectoryName(const QString &name);
+
+    QString root_path;
+    quint64 root_generation;
+
+    // Linux
+    int inotify_fd;
+    QSocketNotifier *inotify_notifier;
+    QHash<int, QString> paths_by_watch;
+    QHash<QString, int> watches_by_path;
+
+    // Other platforms: last listing of every watched directory, name -> is_dir
+    QFileSystemWatcher *fallback_watcher;
+    QHash<QString, QHash<QString, bool>> snapshots;
+
+    QTimer *flush_timer;
+    FileChangeBatch pending;
+
+    static constexpr int FLUSH_INTERVAL_MS = 16;
+};
+
+#endif // DIRECTORYWATCHER_H
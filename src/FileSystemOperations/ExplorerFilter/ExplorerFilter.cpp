@@ -0,0 +1,103 @@
+#include "ExplorerFilter.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    std::string toLower(std::string_view text) {
+        std::string lower(text);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower;
+    }
+
+    bool hasWildcard(std::string_view text) {
+        return text.find_first_of("*?") != std::string_view::npos;
+    }
+}
+
+const char *ExplorerFilter::defaultSpec() {
+    return "*.cpp, *.cc, *.c, *.h, *.hpp, *.py, *.in, *.out, *.ans, *.txt";
+}
+
+ExplorerFilter ExplorerFilter::compile(const std::string &spec) {
+    ExplorerFilter filter;
+    filter.source_spec = spec;
+    size_t start = 0;
+    while (start < spec.size()) {
+        size_t end = spec.find_first_of(",; \t", start);
+        if (end == std::string::npos) {
+            end = spec.size();
+        }
+        std::string pattern = toLower(std::string_view(spec).substr(start, end - start));
+        start = end + 1;
+        if (pattern.empty()) {
+            continue;
+        }
+        if (pattern == "*" || pattern == "*.*") {
+            // Anything goes, the other patterns no longer matter
+            filter.extensions.clear();
+            filter.exact_names.clear();
+            filter.globs.clear();
+            filter.source_spec = spec;
+            return filter;
+        }
+        std::string_view extension = std::string_view(pattern).substr(std::min<size_t>(2, pattern.size()));
+        if (pattern.compare(0, 2, "*.") == 0 && !hasWildcard(extension) && extension.find('.') == std::string_view::npos) {
+            filter.extensions.insert(std::string(extension));
+        } else if (!hasWildcard(pattern)) {
+            filter.exact_names.insert(pattern);
+        } else {
+            filter.globs.push_back(pattern);
+        }
+    }
+    return filter;
+}
+
+bool ExplorerFilter::acceptsAll() const {
+    return extensions.empty() && exact_names.empty() && globs.empty();
+}
+
+const std::string &ExplorerFilter::spec() const {
+    return source_spec;
+}
+
+bool ExplorerFilter::matches(std::string_view file_name) const {
+    if (acceptsAll()) {
+        return true;
+    }
+    std::string lower = toLower(file_name);
+    size_t dot = lower.rfind('.');
+    if (dot != std::string::npos && extensions.count(lower.substr(dot + 1))) {
+        return true;
+    }
+    if (exact_names.count(lower)) {
+        return true;
+    }
+    return std::any_of(globs.begin(), globs.end(), [&lower](const std::string &glob) { return globMatch(glob, lower); });
+}
+
+// '*' matches any run, '?' a single character. Backtracks only to the last
+// star, so it is linear for typical patterns.
+bool ExplorerFilter::globMatch(std::string_view pattern, std::string_view text) {
+    size_t p = 0;
+    size_t t = 0;
+    size_t star = std::string_view::npos;
+    size_t star_text = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            p++;
+            t++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_text = t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++star_text;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
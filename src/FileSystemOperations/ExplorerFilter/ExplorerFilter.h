@@ -0,0 +1,31 @@
+#ifndef EXPLORERFILTER_H
+#define EXPLORERFILTER_H
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// A set of file name globs ("*.cpp, *.in, Makefile, gen*.py") compiled once.
+// Plain "*.ext" patterns become a hash lookup on the extension and literal
+// names a hash lookup on the whole name; only the rest are matched as globs.
+// Matching ignores case.
+class ExplorerFilter {
+  public:
+    static ExplorerFilter compile(const std::string &spec);
+    static const char *defaultSpec();
+
+    bool matches(std::string_view file_name) const;
+    bool acceptsAll() const;
+    const std::string &spec() const;
+
+  private:
+    static bool globMatch(std::string_view pattern, std::string_view text);
+
+    std::string source_spec;
+    std::unordered_set<std::string> extensions; // without the dot
+    std::unordered_set<std::string> exact_names;
+    std::vector<std::string> globs;
+};
+
+#endif // EXPLORERFILTER_H
@@ -12,6 +12,14 @@ namespace FileDialog {
     QString getOpenCppFilePath(QWidget *parent) {
         return QFileDialog::getOpenFileName(parent, "Open C++ file", QString(), "C++ Files (*.cpp)");
     }
+
+    QString getOpenLibraryPath(QWidget *parent) {
+        return QFileDialog::getOpenFileName(parent, "Import library", QString(), "Kodetron library (*.jsonl);;All Files (*)");
+    }
+
+    QString getSaveLibraryPath(QWidget *parent) {
+        return QFileDialog::getSaveFileName(parent, "Export library", "kodetron-library.jsonl", "Kodetron library (*.jsonl)");
+    }
     QString readFileContents(const QString& filePath) {
         QFile file(filePath);
         if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -8,6 +8,8 @@ namespace FileDialog {
     QString getOpenFilePath(QWidget *parent = nullptr);
     QString getOpenDirectoryPath(QWidget *parent = nullptr);
     QString getOpenCppFilePath(QWidget *parent = nullptr);
+    QString getOpenLibraryPath(QWidget *parent = nullptr);
+    QString getSaveLibraryPath(QWidget *parent = nullptr);
     QString readFileContents(const QString& filePath);
     bool writeFileContents(const QString& filePath, const QString& contents);
 }
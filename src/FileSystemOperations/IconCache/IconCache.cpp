@@ -0,0 +1,27 @@
+#include "IconCache.h"
+#include <QFileInfo>
+
+IconCache &IconCache::instance() {
+    static IconCache instance;
+    return instance;
+}
+
+QIcon IconCache::folderIcon() {
+    if (folder_icon.isNull()) {
+        folder_icon = icon_provider.icon(QFileIconProvider::Folder);
+    }
+    return folder_icon;
+}
+
+QIcon IconCache::fileIcon(const QString &file_name) {
+    int dot = file_name.lastIndexOf('.');
+    QString extension = dot > 0 ? file_name.mid(dot + 1).toLower() : QString();
+    auto cached = icons_by_extension.constFind(extension);
+    if (cached != icons_by_extension.constEnd()) {
+        return cached.value();
+    }
+    // The provider resolves the type from the name, the file does not need to exist
+    QIcon icon = extension.isEmpty() ? icon_provider.icon(QFileIconProvider::File) : icon_provider.icon(QFileInfo("file." + extension));
+    icons_by_extension.insert(extension, icon);
+    return icon;
+}
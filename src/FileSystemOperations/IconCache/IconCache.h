@@ -0,0 +1,26 @@
+#ifndef ICONCACHE_H
+#define ICONCACHE_H
+
+#include <QFileIconProvider>
+#include <QHash>
+#include <QIcon>
+#include <QString>
+
+// File icons looked up once per extension and shared by every view, so
+// painting a large folder never asks the platform for the same icon twice.
+// GUI thread only.
+class IconCache {
+  public:
+    static IconCache &instance(); // Global access to the singleton
+
+    QIcon folderIcon();
+    QIcon fileIcon(const QString &file_name);
+
+  private:
+    IconCache() = default;
+    QFileIconProvider icon_provider;
+    QIcon folder_icon;
+    QHash<QString, QIcon> icons_by_extension;
+};
+
+#endif // ICONCACHE_H
@@ -0,0 +1,92 @@
+#include "ProblemGrouper.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    const std::unordered_set<std::string> SOURCE_EXTENSIONS = {"cpp", "cc", "cxx", "c", "py", "java", "kt", "rs"};
+    const std::vector<std::string> TEST_EXTENSIONS = {"in", "out", "ans"}; // also the order within one test
+
+    struct TestFile {
+        size_t group;
+        long number;
+        int kind;
+        std::string name;
+    };
+
+    std::string lowerExtension(const std::string &name, size_t dot) {
+        std::string extension = name.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+}
+
+namespace ProblemGrouper {
+    GroupedListing group(const std::vector<std::string> &file_names) {
+        GroupedListing listing;
+        std::unordered_map<std::string, size_t> group_by_stem;
+        std::vector<std::pair<std::string, int>> candidates; // test-looking files and their kind
+
+        // One pass sorts names into sources, possible tests and the rest
+        for (const std::string &name : file_names) {
+            size_t dot = name.rfind('.');
+            if (dot == std::string::npos || dot == 0) {
+                listing.ungrouped.push_back(name);
+                continue;
+            }
+            std::string extension = lowerExtension(name, dot);
+            if (SOURCE_EXTENSIONS.count(extension)) {
+                if (group_by_stem.emplace(name.substr(0, dot), listing.groups.size()).second) {
+                    listing.groups.push_back({name, {}});
+                } else {
+                    listing.ungrouped.push_back(name);
+                }
+                continue;
+            }
+            auto kind = std::find(TEST_EXTENSIONS.begin(), TEST_EXTENSIONS.end(), extension);
+            if (kind != TEST_EXTENSIONS.end()) {
+                candidates.emplace_back(name, static_cast<int>(kind - TEST_EXTENSIONS.begin()));
+            } else {
+                listing.ungrouped.push_back(name);
+            }
+        }
+
+        std::vector<TestFile> tests;
+        for (const auto &[name, kind] : candidates) {
+            std::string stem = name.substr(0, name.rfind('.'));
+            auto group = group_by_stem.find(stem);
+            long number = 0;
+            if (group == group_by_stem.end()) {
+                size_t digits = stem.size();
+                while (digits > 0 && std::isdigit(static_cast<unsigned char>(stem[digits - 1]))) {
+                    digits--;
+                }
+                size_t key_end = digits;
+                while (key_end > 0 && (stem[key_end - 1] == '_' || stem[key_end - 1] == '-' || stem[key_end - 1] == '.')) {
+                    key_end--;
+                }
+                if (digits < stem.size() && key_end > 0) {
+                    group = group_by_stem.find(stem.substr(0, key_end));
+                    number = std::stol(stem.substr(digits, 9));
+                }
+            }
+            if (group == group_by_stem.end()) {
+                listing.ungrouped.push_back(name);
+                continue;
+            }
+            tests.push_back({group->second, number, kind, name});
+        }
+
+        std::stable_sort(tests.begin(), tests.end(), [](const TestFile &a, const TestFile &b) {
+            if (a.number != b.number) {
+                return a.number < b.number;
+            }
+            return a.kind < b.kind;
+        });
+        for (TestFile &test : tests) {
+            listing.groups[test.group].tests.push_back(std::move(test.name));
+        }
+        return listing;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef PROBLEMGROUPER_H
+#define PROBLEMGROUPER_H
+
+#include <string>
+#include <vector>
+
+struct ProblemGroup {
+    std::string source;             // A.cpp
+    std::vector<std::string> tests; // A1.in, A1.out, A2.in, ... by test number
+};
+
+struct GroupedListing {
+    std::vector<ProblemGroup> groups;   // in the order the sources were given
+    std::vector<std::string> ungrouped; // everything that is neither a source nor one of its tests
+};
+
+// Pairs solution files with their test data by name alone, so a directory
+// can be grouped from its listing without touching the files. A test belongs
+// to a source when its stem equals the source's stem, optionally followed by
+// a separator and a test number: A.in, A1.out, A_2.in, A.3.ans.
+namespace ProblemGrouper {
+    GroupedListing group(const std::vector<std::string> &file_names);
+}
+
+#endif // PROBLEMGROUPER_H
@@ -1,63 +1,96 @@
 #include "AppState.h"
+#include <atomic>
 
 AppState &AppState::instance() {
     static AppState instance;
     return instance;
 }
 
-AppState::AppState(QObject *parent) : QObject(parent) {
-    selected_explorer_path = "";
-    selected_dir_path = "";
-    selected_file_path = "";
-    is_selected_explorer_path = false;
-    is_selected_dir_path = false;
-    is_selected_file_path = false;
-    enumExplorerPathType.dir_type = "DIR_TYPE";
-    enumExplorerPathType.file_type = "FILE_TYPE";
-    enumExplorerPathType.empty = "EMPTY";
-    selected_explorer_path_type = enumExplorerPathType.empty;
-}
+AppState::AppState(QObject *parent)
+    : QObject(parent), published(std::make_shared<const AppStateSnapshot>()), commit_scheduled(false) {}
 
 // Getters
 QString AppState::getSelectedExplorerPath() const {
-    return selected_explorer_path;
+    return state.explorer_path;
+}
+ExplorerPathType AppState::getSelectedExplorerPathType() const {
+    return state.explorer_path_type;
 }
 QString AppState::getSelectedDirPath() const {
-    return selected_dir_path;
+    return state.dir_path;
 }
 QString AppState::getSelectedFilePath() const {
-    return selected_file_path;
+    return state.file_path;
 }
 bool AppState::isSelectedExplorerPath() const {
-    return is_selected_explorer_path;
+    return state.explorer_path_type != ExplorerPathType::Empty;
 }
 bool AppState::isSelectedDirPath() const {
-    return is_selected_dir_path;
+    return !state.dir_path.isEmpty();
 }
 bool AppState::isSelectedFilePath() const {
-    return is_selected_file_path;
+    return !state.file_path.isEmpty();
 }
 
-// Setters with emitters
-void AppState::setSelectedExplorerPath(const QString &new_path, const std::string &new_path_type) {
-    if (selected_explorer_path != new_path || selected_explorer_path_type != new_path_type) {
-        selected_explorer_path = new_path;
-        selected_explorer_path_type = new_path_type;
-        is_selected_explorer_path = (new_path_type != enumExplorerPathType.empty);
-        emit selectedExplorerPathModified(new_path, new_path_type);
-    }
+std::shared_ptr<const AppStateSnapshot> AppState::snapshot() const {
+    return std::atomic_load(&published);
+}
+
+// Setters, notified on commit
+void AppState::setSelectedExplorerPath(const QString &new_path, ExplorerPathType new_path_type) {
+    state.explorer_path = new_path;
+    state.explorer_path_type = new_path_type;
+    scheduleCommit();
 }
 void AppState::setSelectedDirPath(const QString &new_path) {
-    if (selected_dir_path != new_path) {
-        selected_dir_path = new_path;
-        is_selected_dir_path = !new_path.isEmpty();
-        emit selectedDirPathModified(new_path);
-    }
+    state.dir_path = new_path;
+    scheduleCommit();
 }
 void AppState::setSelectedFilePath(const QString &new_path) {
-    if (selected_file_path != new_path) {
-        selected_file_path = new_path;
-        is_selected_file_path = !new_path.isEmpty();
-        emit selectedFilePathModified(new_path);
+    state.file_path = new_path;
+    scheduleCommit();
+}
+
+void AppState::scheduleCommit() {
+    if (commit_scheduled) {
+        return;
+    }
+    commit_scheduled = true;
+    QMetaObject::invokeMethod(this, &AppState::commit, Qt::QueuedConnection);
+}
+
+void AppState::commit() {
+    // Also reached from the queued call after an explicit commit, which finds nothing to do
+    commit_scheduled = false;
+    std::shared_ptr<const AppStateSnapshot> previous = std::atomic_load(&published);
+    int fields = 0;
+    if (state.explorer_path != previous->explorer_path || state.explorer_path_type != previous->explorer_path_type) {
+        fields |= AppStateChange::ExplorerPath;
+    }
+    if (state.dir_path != previous->dir_path) {
+        fields |= AppStateChange::DirPath;
+    }
+    if (state.file_path != previous->file_path) {
+        fields |= AppStateChange::FilePath;
+    }
+    if (fields == 0) {
+        return;
+    }
+
+    state.revision = previous->revision + 1;
+    auto current = std::make_shared<const AppStateSnapshot>(state);
+    std::atomic_store(&published, current);
+
+    // Slots may set values again, those start the next change-set
+    AppStateChange change{fields, previous, current};
+    emit stateChanged(change);
+    if (change.has(AppStateChange::ExplorerPath)) {
+        emit selectedExplorerPathModified(current->explorer_path, current->explorer_path_type);
+    }
+    if (change.has(AppStateChange::DirPath)) {
+        emit selectedDirPathModified(current->dir_path);
+    }
+    if (change.has(AppStateChange::FilePath)) {
+        emit selectedFilePathModified(current->file_path);
     }
 }
@@ -3,46 +3,74 @@
 
 #include <QObject>
 #include <QString>
+#include <memory>
 
-struct EnumExplorerPathType {
-    std::string dir_type;
-    std::string file_type;
-    std::string empty;
+enum class ExplorerPathType { Empty, Dir, File };
+
+// Everything AppState holds, as of one committed change-set. Never modified
+// once published, so any thread may keep and read one.
+struct AppStateSnapshot {
+    QString explorer_path;
+    ExplorerPathType explorer_path_type = ExplorerPathType::Empty;
+    QString dir_path;
+    QString file_path;
+    quint64 revision = 0; // bumped by every committed change-set
 };
 
+struct AppStateChange {
+    enum Field { ExplorerPath = 1, DirPath = 2, FilePath = 4 };
+    int fields; // Field bits
+    std::shared_ptr<const AppStateSnapshot> previous;
+    std::shared_ptr<const AppStateSnapshot> current;
+
+    bool has(Field field) const { return (fields & field) != 0; }
+};
+
+// Setters take effect for the getters at once, but notifications are held
+// back and sent as one change-set when control returns to the event loop,
+// so setting the folder and clearing the file is a single step for
+// subscribers. A value changed and then changed back within the same turn
+// notifies nobody. commit() sends the pending change-set right away, for
+// callers that act on its consequences in the same function.
+//
+// Setters, getters and signals are GUI thread only; other threads read
+// snapshot().
 class AppState : public QObject {
     Q_OBJECT
   public:
     static AppState &instance(); // Global access to the singleton
 
     QString getSelectedExplorerPath() const;
+    ExplorerPathType getSelectedExplorerPathType() const;
     QString getSelectedDirPath() const;
     QString getSelectedFilePath() const;
     bool isSelectedExplorerPath() const;
     bool isSelectedDirPath() const;
     bool isSelectedFilePath() const;
 
-    EnumExplorerPathType enumExplorerPathType;
+    // The last committed state, safe to call from any thread
+    std::shared_ptr<const AppStateSnapshot> snapshot() const;
 
   public slots:
-    void setSelectedExplorerPath(const QString &new_path, const std::string &new_path_type);
+    void setSelectedExplorerPath(const QString &new_path, ExplorerPathType new_path_type);
     void setSelectedDirPath(const QString &new_path);
     void setSelectedFilePath(const QString &new_path);
+    void commit();
 
   signals:
-    void selectedExplorerPathModified(const QString &new_path, const std::string &path_type);
+    // Once per change-set, before the per-field signals below
+    void stateChanged(const AppStateChange &change);
+    void selectedExplorerPathModified(const QString &new_path, ExplorerPathType path_type);
     void selectedDirPathModified(const QString &new_path);
     void selectedFilePathModified(const QString &new_path);
 
   private:
     explicit AppState(QObject *parent = nullptr);
-    std::string selected_explorer_path_type;
-    QString selected_explorer_path;
-    QString selected_dir_path;
-    QString selected_file_path;
-    bool is_selected_explorer_path;
-    bool is_selected_dir_path;
-    bool is_selected_file_path;
+    void scheduleCommit();
+
+    AppStateSnapshot state;                           // includes uncommitted changes
+    std::shared_ptr<const AppStateSnapshot> published; // read and replaced atomically
+    bool commit_scheduled;
 };
 
 #endif // APPSTATE_H
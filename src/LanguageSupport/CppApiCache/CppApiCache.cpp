@@ -0,0 +1,203 @@
+#include "CppApiCache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThread>
+#include <memory>
+
+CppApiCache::CppApiCache(QsciAPIs *apis, QObject *parent)
+    : QObject(parent), apis(apis), preprocessor(nullptr), save_when_prepared(false) {
+    connect(apis, &QsciAPIs::apiPreparationFinished, this, &CppApiCache::onPreparationFinished);
+}
+
+void CppApiCache::load(const QStringList &base_entries) {
+    this->base_entries = base_entries;
+    prepared_file_path = preparedFilePath();
+
+    // Fast path: the list for this compiler was already prepared on a previous run
+    if (!prepared_file_path.isEmpty() && apis->isPrepared(prepared_file_path) && apis->loadPrepared(prepared_file_path)) {
+        return;
+    }
+
+    // Offer the keywords right away while the standard library list is generated
+    for (const QString &entry : base_entries) {
+        apis->add(entry);
+    }
+    apis->prepare();
+
+    if (!prepared_file_path.isEmpty()) {
+        regenerate();
+    }
+}
+
+// The prepared file is keyed by the compiler binary and by the headers it
+// resolves, so upgrading g++ or only libstdc++ produces a new file name.
+QString CppApiCache::preparedFilePath() const {
+    QString compiler_path = QStandardPaths::findExecutable(COMPILER);
+    if (compiler_path.isEmpty()) {
+        return QString();
+    }
+    QFileInfo compiler_info(compiler_path);
+    QByteArray fingerprint = compiler_info.canonicalFilePath().toUtf8();
+    fingerprint += '|' + QByteArray::number(compiler_info.size());
+    fingerprint += '|' + QByteArray::number(compiler_info.lastModified().toMSecsSinceEpoch());
+    fingerprint += '|' + headerFingerprint(compiler_path);
+    fingerprint += '|' + QByteArray::number(EXTRACTOR_VERSION);
+    QString hash = QString::fromLatin1(QCryptographicHash::hash(fingerprint, QCryptographicHash::Sha1).toHex().left(16));
+
+    QString api_dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/apis";
+    QDir().mkpath(api_dir);
+    return api_dir + "/cpp-" + hash + ".pap";
+}
+
+// `g++ -v` on an empty translation unit prints the full version and the
+// include search list without reading a single header, which takes a few
+// milliseconds. The <bits/stdc++.h> it would resolve is then stat'ed.
+QByteArray CppApiCache::headerFingerprint(const QString &compiler_path) {
+    QProcess probe;
+    probe.start(compiler_path, {"-std=c++17", "-E", "-v", "-x", "c++", "-"});
+    probe.closeWriteChannel();
+    if (!probe.waitForFinished(PROBE_TIMEOUT_MS) || probe.exitStatus() != QProcess::NormalExit || probe.exitCode() != 0) {
+        return QByteArray();
+    }
+
+    QByteArray fingerprint;
+    bool in_search_list = false;
+    for (const QByteArray &line : probe.readAllStandardError().split('\n')) {
+        if (line.contains(" version ") && fingerprint.isEmpty()) {
+            fingerprint = line.trimmed();
+        } else if (line.startsWith("#include <...> search starts here:")) {
+            in_search_list = true;
+        } else if (line.startsWith("End of search list.")) {
+            break;
+        } else if (in_search_list) {
+            QFileInfo header(QString::fromLocal8Bit(line.trimmed()) + "/bits/stdc++.h");
+            if (header.exists()) {
+                fingerprint += '|' + header.canonicalFilePath().toUtf8();
+                fingerprint += '|' + QByteArray::number(header.size());
+                fingerprint += '|' + QByteArray::number(header.lastModified().toMSecsSinceEpoch());
+                break;
+            }
+        }
+    }
+    return fingerprint;
+}
+
+void CppApiCache::regenerate() {
+    if (preprocessor) {
+        return;
+    }
+    preprocessor = new QProcess(this);
+    connect(preprocessor, &QProcess::finished, this, &CppApiCache::onPreprocessorFinished);
+    preprocessor->start(COMPILER, {"-std=c++17", "-E", "-P", "-x", "c++", "-"});
+    preprocessor->write(STD_HEADER_SOURCE);
+    preprocessor->closeWriteChannel();
+}
+
+void CppApiCache::onPreprocessorFinished(int exit_code, QProcess::ExitStatus exit_status) {
+    QByteArray output = preprocessor->readAllStandardOutput();
+    preprocessor->deleteLater();
+    preprocessor = nullptr;
+    if (exit_status != QProcess::NormalExit || exit_code != 0 || output.isEmpty()) {
+        return;
+    }
+
+    // Scanning several megabytes of preprocessed headers stays off the GUI thread
+    auto entries = std::make_shared<QStringList>();
+    QThread *worker = QThread::create([output, entries]() {
+        *entries = extractDeclarations(QString::fromUtf8(output));
+    });
+    connect(worker, &QThread::finished, this, [this, entries]() { onExtractionFinished(*entries); });
+    connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+    worker->start(QThread::LowPriority);
+}
+
+void CppApiCache::onExtractionFinished(const QStringList &entries) {
+    if (entries.isEmpty()) {
+        return;
+    }
+    apis->cancelPreparation();
+    apis->clear();
+    for (const QString &entry : base_entries) {
+        apis->add(entry);
+    }
+    for (const QString &entry : entries) {
+        apis->add(entry);
+    }
+    save_when_prepared = true;
+    apis->prepare();
+}
+
+void CppApiCache::onPreparationFinished() {
+    if (!save_when_prepared) {
+        return;
+    }
+    save_when_prepared = false;
+    removeStalePreparedFiles();
+    apis->savePrepared(prepared_file_path);
+}
+
+void CppApiCache::removeStalePreparedFiles() const {
+    QFileInfo prepared_info(prepared_file_path);
+    QDir api_dir = prepared_info.dir();
+    for (const QString &file_name : api_dir.entryList({"cpp-*.pap"}, QDir::Files)) {
+        if (file_name != prepared_info.fileName()) {
+            api_dir.remove(file_name);
+        }
+    }
+}
+
+QStringList CppApiCache::extractDeclarations(const QString &preprocessed) {
+    static const QRegularExpression function_regex(R"(\b([A-Za-z][A-Za-z0-9_]*)\s*\(([^(){};]*)\)(?=\s*(?:const\b|noexcept\b|->|[;{])))");
+    static const QRegularExpression type_regex(R"(\b(?:class|struct)\s+([a-z][a-z0-9_]*)\b)");
+    static const QRegularExpression reserved_prefix_regex(R"(\b_+(?=[A-Za-z]))");
+    static const QRegularExpression whitespace_regex(R"(\s+)");
+    // Argument lists made only of lowercase names are calls inside inline bodies, not declarations
+    static const QRegularExpression call_arguments_regex(R"(^[*&]?[a-z][A-Za-z0-9_]*(?:, [*&]?[a-z][A-Za-z0-9_]*)*$)");
+    static const QSet<QString> builtin_types = {"void", "int", "long", "bool", "char", "double", "float", "unsigned", "size_t", "size_type"};
+    static const QSet<QString> ignored_names = {
+        "if", "for", "while", "switch", "return", "sizeof", "alignof", "alignas", "decltype", "noexcept",
+        "static_assert", "catch", "throw", "new", "delete", "operator", "typeid", "defined", "requires"
+    };
+
+    QStringList entries;
+    QSet<QString> seen;
+    QHash<QString, int> overload_count;
+
+    QRegularExpressionMatchIterator functions = function_regex.globalMatch(preprocessed);
+    while (functions.hasNext()) {
+        QRegularExpressionMatch match = functions.next();
+        QString name = match.captured(1);
+        if (ignored_names.contains(name) || overload_count.value(name) >= MAX_OVERLOADS_PER_NAME) {
+            continue;
+        }
+        QString params = match.captured(2);
+        params.replace(reserved_prefix_regex, QString());
+        params.replace(whitespace_regex, " ");
+        params = params.trimmed();
+        if (params.size() > MAX_PARAMETERS_LENGTH || (call_arguments_regex.match(params).hasMatch() && !builtin_types.contains(params))) {
+            continue;
+        }
+        QString entry = name + "(" + params + ")";
+        if (!seen.contains(entry)) {
+            seen.insert(entry);
+            overload_count[name]++;
+            entries << entry;
+        }
+    }
+
+    QRegularExpressionMatchIterator types = type_regex.globalMatch(preprocessed);
+    while (types.hasNext()) {
+        QString name = types.next().captured(1);
+        if (!seen.contains(name)) {
+            seen.insert(name);
+            entries << name;
+        }
+    }
+    return entries;
+}
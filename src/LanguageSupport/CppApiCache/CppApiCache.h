@@ -0,0 +1,46 @@
+#ifndef CPPAPICACHE_H
+#define CPPAPICACHE_H
+
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <Qsci/qsciapis.h>
+
+// Builds the autocompletion list for the standard library once per compiler
+// and keeps it on disk as a QsciAPIs prepared file, so later startups only
+// pay for QsciAPIs::loadPrepared.
+class CppApiCache : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit CppApiCache(QsciAPIs *apis, QObject *parent = nullptr);
+    void load(const QStringList &base_entries);
+
+  private:
+    QString preparedFilePath() const;
+    static QByteArray headerFingerprint(const QString &compiler_path);
+    void regenerate();
+    void onPreprocessorFinished(int exit_code, QProcess::ExitStatus exit_status);
+    void onExtractionFinished(const QStringList &entries);
+    void onPreparationFinished();
+    void removeStalePreparedFiles() const;
+    static QStringList extractDeclarations(const QString &preprocessed);
+
+    QsciAPIs *apis;
+    QProcess *preprocessor;
+    QStringList base_entries;
+    QString prepared_file_path;
+    bool save_when_prepared;
+
+    static constexpr const char *COMPILER = "g++";
+    static constexpr const char *STD_HEADER_SOURCE = "#include <bits/stdc++.h>\n";
+    // Bump when extractDeclarations changes so existing caches are rebuilt
+    static constexpr int EXTRACTOR_VERSION = 1;
+    static constexpr int MAX_OVERLOADS_PER_NAME = 6;
+    // Longer parameter lists are SFINAE and allocator noise nobody reads in a calltip
+    static constexpr int MAX_PARAMETERS_LENGTH = 120;
+    static constexpr int PROBE_TIMEOUT_MS = 2000;
+};
+
+#endif // CPPAPICACHE_H
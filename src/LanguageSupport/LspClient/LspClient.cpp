@@ -0,0 +1,341 @@
+#include "LspClient.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QUrl>
+
+LspClient::LspClient(QObject *parent)
+    : QObject(parent), server(nullptr), document_version(0), next_request_id(1), latest_hover_id(-1),
+      server_missing(false), initialized(false), utf8_columns(false) {
+    // Keystrokes are batched into a single didChange per pause in typing
+    change_timer = new QTimer(this);
+    change_timer->setSingleShot(true);
+    change_timer->setInterval(CHANGE_DEBOUNCE_MS);
+    connect(change_timer, &QTimer::timeout, this, &LspClient::flushChanges);
+}
+
+LspClient::~LspClient() {
+    if (server && server->state() != QProcess::NotRunning) {
+        disconnect(server, nullptr, this, nullptr);
+        // The protocol asks for shutdown and its reply before exit; the wait is
+        // bounded so a hung server cannot stall closing the window.
+        if (initialized) {
+            int shutdown_id = sendRequest("shutdown", QJsonObject(), RequestKind::Shutdown);
+            QElapsedTimer waited;
+            waited.start();
+            bool replied = false;
+            while (!replied && waited.elapsed() < SHUTDOWN_TIMEOUT_MS &&
+                   server->waitForReadyRead(SHUTDOWN_TIMEOUT_MS - static_cast<int>(waited.elapsed()))) {
+                read_buffer.append(server->readAllStandardOutput());
+                QJsonObject message;
+                while (!replied && takeMessage(message)) {
+                    replied = !message.contains("method") && message.value("id").toInt(-1) == shutdown_id;
+                }
+            }
+        }
+        sendNotification("exit", QJsonObject());
+        server->closeWriteChannel();
+        if (!server->waitForFinished(SHUTDOWN_TIMEOUT_MS)) {
+            server->kill();
+        }
+    }
+}
+
+bool LspClient::isAvailable() const {
+    return !server_missing;
+}
+
+bool LspClient::usesUtf8Columns() const {
+    return utf8_columns;
+}
+
+bool LspClient::isDocumentOpen() const {
+    return !document_uri.isEmpty();
+}
+
+// clangd is started lazily with the first document so an editor that never
+// opens a file does not pay for it.
+bool LspClient::ensureServer() {
+    if (server_missing) {
+        return false;
+    }
+    if (server) {
+        return true;
+    }
+    QString server_path = QStandardPaths::findExecutable(SERVER_EXECUTABLE);
+    if (server_path.isEmpty()) {
+        server_missing = true;
+        return false;
+    }
+
+    server = new QProcess(this);
+    connect(server, &QProcess::readyReadStandardOutput, this, &LspClient::onReadyRead);
+    connect(server, &QProcess::errorOccurred, this, [this](QProcess::ProcessError) {
+        server_missing = true;
+        document_uri.clear();
+        pending_requests.clear();
+    });
+    server->setProcessChannelMode(QProcess::SeparateChannels);
+    server->setStandardErrorFile(QProcess::nullDevice());
+    server->start(server_path, {"--log=error", "--pch-storage=memory", "--header-insertion=never"});
+
+    QJsonObject capabilities{
+        {"general", QJsonObject{{"positionEncodings", QJsonArray{"utf-8", "utf-16"}}}},
+        {"textDocument", QJsonObject{
+            {"synchronization", QJsonObject{{"didSave", false}}},
+            {"publishDiagnostics", QJsonObject{{"relatedInformation", false}}},
+            {"hover", QJsonObject{{"contentFormat", QJsonArray{"plaintext"}}}},
+            {"definition", QJsonObject{{"linkSupport", false}}},
+        }},
+        // clangd's pre-standard spelling of positionEncodings
+        {"offsetEncoding", QJsonArray{"utf-8", "utf-16"}},
+    };
+    QJsonObject params{
+        {"processId", static_cast<qint64>(QCoreApplication::applicationPid())},
+        {"rootUri", QJsonValue::Null},
+        {"capabilities", capabilities},
+        {"initializationOptions", QJsonObject{{"fallbackFlags", QJsonArray{"-std=c++17"}}}},
+    };
+    sendRequest("initialize", params, RequestKind::Initialize);
+    return true;
+}
+
+void LspClient::openDocument(const QString &file_path, const QByteArray &text) {
+    closeDocument();
+    if (file_path.isEmpty() || !ensureServer()) {
+        return;
+    }
+    document_uri = QUrl::fromLocalFile(file_path).toString();
+    document_version = 0;
+    QJsonObject text_document{
+        {"uri", document_uri},
+        {"languageId", "cpp"},
+        {"version", document_version},
+        {"text", QString::fromUtf8(text)},
+    };
+    sendNotification("textDocument/didOpen", QJsonObject{{"textDocument", text_document}});
+}
+
+void LspClient::closeDocument() {
+    if (document_uri.isEmpty()) {
+        return;
+    }
+    change_timer->stop();
+    pending_changes.clear();
+    sendNotification("textDocument/didClose", QJsonObject{{"textDocument", QJsonObject{{"uri", document_uri}}}});
+    document_uri.clear();
+    latest_hover_id = -1;
+    emit diagnosticsPublished(QList<LspDiagnostic>());
+}
+
+void LspClient::queueChange(const LspEditPosition &start, const LspEditPosition &end, const QByteArray &text) {
+    if (document_uri.isEmpty()) {
+        return;
+    }
+    pending_changes.append(PendingChange{start, end, text});
+    change_timer->start();
+}
+
+// Edits typed before the initialize reply wait here rather than in the outbox,
+// so their columns are written in the encoding the server actually chose.
+void LspClient::flushChanges() {
+    change_timer->stop();
+    if (pending_changes.isEmpty() || document_uri.isEmpty() || !initialized) {
+        return;
+    }
+    QJsonArray content_changes;
+    for (const PendingChange &change : pending_changes) {
+        QJsonObject range{{"start", textPosition(change.start)}, {"end", textPosition(change.end)}};
+        content_changes.append(QJsonObject{{"range", range}, {"text", QString::fromUtf8(change.text)}});
+    }
+    QJsonObject text_document{{"uri", document_uri}, {"version", ++document_version}};
+    sendNotification("textDocument/didChange", QJsonObject{{"textDocument", text_document}, {"contentChanges", content_changes}});
+    pending_changes.clear();
+}
+
+void LspClient::requestHover(int line, int column) {
+    // Columns are computed by the caller in the negotiated encoding, which is
+    // unknown until initialize returns
+    if (document_uri.isEmpty() || !initialized) {
+        return;
+    }
+    // Queries must see the buffer as it is on screen
+    flushChanges();
+    QJsonObject params{
+        {"textDocument", QJsonObject{{"uri", document_uri}}},
+        {"position", textPosition(line, column)},
+    };
+    latest_hover_id = sendRequest("textDocument/hover", params, RequestKind::Hover);
+    hover_positions.insert(latest_hover_id, qMakePair(line, column));
+}
+
+void LspClient::requestDefinition(int line, int column) {
+    if (document_uri.isEmpty() || !initialized) {
+        return;
+    }
+    flushChanges();
+    QJsonObject params{
+        {"textDocument", QJsonObject{{"uri", document_uri}}},
+        {"position", textPosition(line, column)},
+    };
+    sendRequest("textDocument/definition", params, RequestKind::Definition);
+}
+
+int LspClient::sendRequest(const QString &method, const QJsonObject &params, RequestKind kind) {
+    int id = next_request_id++;
+    pending_requests.insert(id, kind);
+    send(QJsonObject{{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", params}});
+    return id;
+}
+
+void LspClient::sendNotification(const QString &method, const QJsonObject &params) {
+    send(QJsonObject{{"jsonrpc", "2.0"}, {"method", method}, {"params", params}});
+}
+
+void LspClient::send(const QJsonObject &message) {
+    if (!server) {
+        return;
+    }
+    bool is_handshake = message.value("method").toString() == "initialize" || message.value("method").toString() == "exit";
+    if (!initialized && !is_handshake) {
+        outbox.append(message);
+        return;
+    }
+    QByteArray body = QJsonDocument(message).toJson(QJsonDocument::Compact);
+    server->write("Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+}
+
+void LspClient::onReadyRead() {
+    read_buffer.append(server->readAllStandardOutput());
+    QJsonObject message;
+    while (takeMessage(message)) {
+        handleMessage(message);
+    }
+}
+
+// Removes one complete Content-Length framed message from read_buffer
+bool LspClient::takeMessage(QJsonObject &message) {
+    while (true) {
+        int header_end = read_buffer.indexOf("\r\n\r\n");
+        if (header_end < 0) {
+            return false;
+        }
+        int content_length = -1;
+        for (const QByteArray &header : read_buffer.left(header_end).split('\n')) {
+            QByteArray trimmed = header.trimmed();
+            if (trimmed.toLower().startsWith("content-length:")) {
+                content_length = trimmed.mid(15).trimmed().toInt();
+            }
+        }
+        if (content_length < 0) {
+            // Unrecoverable framing error, drop what was received so far
+            read_buffer.clear();
+            return false;
+        }
+        int body_start = header_end + 4;
+        if (read_buffer.size() < body_start + content_length) {
+            return false;
+        }
+        QJsonDocument document = QJsonDocument::fromJson(read_buffer.mid(body_start, content_length));
+        read_buffer.remove(0, body_start + content_length);
+        if (document.isObject()) {
+            message = document.object();
+            return true;
+        }
+    }
+}
+
+void LspClient::handleMessage(const QJsonObject &message) {
+    QString method = message.value("method").toString();
+    if (!method.isEmpty()) {
+        if (method == "textDocument/publishDiagnostics") {
+            handleDiagnostics(message.value("params").toObject());
+        } else if (message.contains("id")) {
+            // Server-to-client requests (progress tokens, configuration) get an empty answer
+            send(QJsonObject{{"jsonrpc", "2.0"}, {"id", message.value("id")}, {"result", QJsonValue::Null}});
+        }
+        return;
+    }
+
+    int id = message.value("id").toInt(-1);
+    auto request = pending_requests.find(id);
+    if (request == pending_requests.end()) {
+        return;
+    }
+    RequestKind kind = request.value();
+    pending_requests.erase(request);
+    if (kind == RequestKind::Hover) {
+        QPair<int, int> position = hover_positions.take(id);
+        // Only the newest hover is still relevant to the mouse position
+        if (id != latest_hover_id) {
+            return;
+        }
+        QJsonObject contents = message.value("result").toObject().value("contents").toObject();
+        QString text = contents.value("value").toString().trimmed();
+        if (!text.isEmpty()) {
+            emit hoverReady(position.first, position.second, text);
+        }
+        return;
+    }
+    handleResponse(kind, message);
+}
+
+void LspClient::handleResponse(RequestKind kind, const QJsonObject &message) {
+    QJsonValue result = message.value("result");
+    if (kind == RequestKind::Initialize) {
+        QJsonObject server_info = result.toObject();
+        QString encoding = server_info.value("capabilities").toObject().value("positionEncoding").toString();
+        if (encoding.isEmpty()) {
+            encoding = server_info.value("offsetEncoding").toString();
+        }
+        utf8_columns = encoding == "utf-8";
+        initialized = true;
+        sendNotification("initialized", QJsonObject());
+        QList<QJsonObject> queued = outbox;
+        outbox.clear();
+        for (const QJsonObject &queued_message : queued) {
+            send(queued_message);
+        }
+        flushChanges();
+        return;
+    }
+    if (kind == RequestKind::Definition) {
+        QJsonArray locations = result.isArray() ? result.toArray() : QJsonArray{result};
+        if (locations.isEmpty()) {
+            return;
+        }
+        QJsonObject location = locations.first().toObject();
+        QJsonObject start = location.value("range").toObject().value("start").toObject();
+        QString uri = location.value("uri").toString();
+        if (!uri.isEmpty()) {
+            emit definitionReady(LspLocation{QUrl(uri).toLocalFile(), start.value("line").toInt(), start.value("character").toInt()});
+        }
+    }
+}
+
+void LspClient::handleDiagnostics(const QJsonObject &params) {
+    if (params.value("uri").toString() != document_uri) {
+        return;
+    }
+    QList<LspDiagnostic> diagnostics;
+    for (const QJsonValue &value : params.value("diagnostics").toArray()) {
+        QJsonObject diagnostic = value.toObject();
+        QJsonObject range = diagnostic.value("range").toObject();
+        QJsonObject start = range.value("start").toObject();
+        QJsonObject end = range.value("end").toObject();
+        diagnostics.append(LspDiagnostic{
+            start.value("line").toInt(), start.value("character").toInt(),
+            end.value("line").toInt(), end.value("character").toInt(),
+            diagnostic.value("severity").toInt(1), diagnostic.value("message").toString()});
+    }
+    emit diagnosticsPublished(diagnostics);
+}
+
+QJsonObject LspClient::textPosition(int line, int column) {
+    return QJsonObject{{"line", line}, {"character", column}};
+}
+
+QJsonObject LspClient::textPosition(const LspEditPosition &position) const {
+    return textPosition(position.line, utf8_columns ? position.utf8_column : position.utf16_column);
+}
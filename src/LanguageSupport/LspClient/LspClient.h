@@ -0,0 +1,103 @@
+#ifndef LSPCLIENT_H
+#define LSPCLIENT_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QProcess>
+#include <QString>
+#include <QTimer>
+
+struct LspDiagnostic {
+    int start_line;
+    int start_column;
+    int end_line;
+    int end_column;
+    int severity; // 1 = error, 2 = warning, 3 = information, 4 = hint
+    QString message;
+};
+
+// An edit position in both column encodings; the one the server negotiated
+// is only known once initialize returns, so didChange picks it when sent.
+struct LspEditPosition {
+    int line;
+    int utf8_column;
+    int utf16_column;
+};
+
+struct LspLocation {
+    QString file_path;
+    int line;
+    int column;
+};
+
+// Talks to a local clangd over stdio for the single buffer shown in the
+// editor. Every public method is a no-op when clangd is not installed.
+class LspClient : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit LspClient(QObject *parent = nullptr);
+    ~LspClient();
+    bool isAvailable() const;
+    bool usesUtf8Columns() const;
+    bool isDocumentOpen() const;
+
+    void openDocument(const QString &file_path, const QByteArray &text);
+    void closeDocument();
+    void queueChange(const LspEditPosition &start, const LspEditPosition &end, const QByteArray &text);
+    void requestHover(int line, int column);
+    void requestDefinition(int line, int column);
+
+  signals:
+    void diagnosticsPublished(const QList<LspDiagnostic> &diagnostics);
+    void hoverReady(int line, int column, const QString &text);
+    void definitionReady(const LspLocation &location);
+
+  private:
+    enum class RequestKind { Initialize, Hover, Definition, Shutdown };
+
+    struct PendingChange {
+        LspEditPosition start;
+        LspEditPosition end;
+        QByteArray text;
+    };
+
+    bool ensureServer();
+    int sendRequest(const QString &method, const QJsonObject &params, RequestKind kind);
+    void sendNotification(const QString &method, const QJsonObject &params);
+    void send(const QJsonObject &message);
+    void flushChanges();
+    void onReadyRead();
+    bool takeMessage(QJsonObject &message);
+    void handleMessage(const QJsonObject &message);
+    void handleResponse(RequestKind kind, const QJsonObject &message);
+    void handleDiagnostics(const QJsonObject &params);
+    static QJsonObject textPosition(int line, int column);
+    QJsonObject textPosition(const LspEditPosition &position) const;
+
+    QProcess *server;
+    QTimer *change_timer;
+    QByteArray read_buffer;
+    QList<QJsonObject> outbox; // messages written before the initialize handshake completes
+    QHash<int, RequestKind> pending_requests;
+    QHash<int, QPair<int, int>> hover_positions;
+    QList<PendingChange> pending_changes; // kept unencoded until the column encoding is negotiated
+    QString document_uri;
+    int document_version;
+    int next_request_id;
+    int latest_hover_id;
+    bool server_missing;
+    bool initialized;
+    bool utf8_columns;
+
+    static constexpr const char *SERVER_EXECUTABLE = "clangd";
+    static constexpr int CHANGE_DEBOUNCE_MS = 30;
+    static constexpr int SHUTDOWN_TIMEOUT_MS = 200;
+};
+
+#endif // LSPCLIENT_H
@@ -1,24 +1,47 @@
 #include "MainWindow.h"
 #include "../App/App.h"
-#include "../utils/StyleLoader/StyleReader.h"
+#include "../utils/StartupTracer/StartupTracer.h"
+#include <QStandardPaths>
+#include <QTimer>
 
 #include <iostream>
 
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
+MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), painted(false) {
     setWindowTitle("Kodetron");
     setMinimumSize(500, 350);
     setWindowIcon(QIcon("../assets/Logo.png"));
 
     setObjectName("main_window");
 
+    StartupTracer::instance().begin("App");
     App *app = new App(this);
     setCentralWidget(app);
-
-    loadStyleSheet();
+    StartupTracer::instance().end();
+}
+void MainWindow::paintEvent(QPaintEvent *event) {
+    QMainWindow::paintEvent(event);
+    if (painted) {
+        return;
+    }
+    painted = true;
+    StartupTracer::instance().mark("first paint", FIRST_PAINT_GOAL_MS);
+    // Zero timeout: runs once this frame has been flushed to the screen
+    QTimer::singleShot(0, this, &MainWindow::runDeferredStartup);
+}
+// One task per event loop turn, so input that arrives meanwhile is not held up
+void MainWindow::runDeferredStartup() {
+    if (StartupTracer::instance().runNextDeferred()) {
+        QTimer::singleShot(0, this, &MainWindow::runDeferredStartup);
+        return;
+    }
+    writeStartupReport();
 }
-void MainWindow::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/MainWindow/MainWindow.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
+void MainWindow::writeStartupReport() {
+    QString app_data_dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(app_data_dir);
+    StartupTracer::instance().writeReport((app_data_dir + "/startup-trace.txt").toStdString());
+    // A slow start is reported without being asked for
+    if (qEnvironmentVariableIsSet("KODETRON_TRACE_STARTUP") || StartupTracer::instance().missedGoal()) {
+        std::cerr << StartupTracer::instance().report();
     }
 }
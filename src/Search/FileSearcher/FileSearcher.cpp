@@ -0,0 +1,212 @@
+#include "FileSearcher.h"
+#include "../LiteralScanner/LiteralScanner.h"
+#include <QDirIterator>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStringDecoder>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+    QRegularExpression buildRegex(const SearchQuery &query) {
+        QString pattern = query.use_regex ? query.pattern : QRegularExpression::escape(query.pattern);
+        QRegularExpression::PatternOptions options = QRegularExpression::MultilineOption;
+        if (!query.case_sensitive) {
+            options |= QRegularExpression::CaseInsensitiveOption;
+        }
+        return QRegularExpression(pattern, options);
+    }
+
+    // The literal every match must contain, checked on raw bytes before decoding
+    std::string buildPrefilter(const SearchQuery &query) {
+        std::string literal = query.use_regex ? LiteralScanner::requiredLiteral(query.pattern.toStdString()) : query.pattern.toStdString();
+        bool has_non_ascii = std::any_of(literal.begin(), literal.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+        // The scanner folds ASCII only, so it could reject valid case-insensitive matches
+        if (!query.case_sensitive && has_non_ascii) {
+            return std::string();
+        }
+        return literal;
+    }
+}
+
+FileSearcher::FileSearcher(QObject *parent) : QObject(parent), cancelled(false), next_search_id(0) {
+    qRegisterMetaType<FileSearchResult>();
+}
+
+FileSearcher::~FileSearcher() {
+    cancel();
+}
+
+int FileSearcher::start(const QString &root_path, const SearchQuery &query, const QHash<QString, QString> &open_buffers) {
+    cancel();
+    cancelled = false;
+    int search_id = ++next_search_id;
+    coordinator = std::thread(&FileSearcher::runSearch, this, search_id, root_path, query, open_buffers);
+    return search_id;
+}
+
+void FileSearcher::cancel() {
+    cancelled = true;
+    joinCoordinator();
+}
+
+void FileSearcher::joinCoordinator() {
+    if (coordinator.joinable()) {
+        coordinator.join();
+    }
+}
+
+void FileSearcher::replaceAll(const QStringList &file_paths, const SearchQuery &query, const QString &replacement) {
+    cancel();
+    cancelled = false;
+    coordinator = std::thread(&FileSearcher::runReplace, this, file_paths, query, replacement);
+}
+
+QStringList FileSearcher::collectFiles(const QString &root_path) const {
+    QStringList file_paths;
+    QDirIterator iterator(root_path, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (iterator.hasNext() && !cancelled) {
+        file_paths << iterator.next();
+    }
+    return file_paths;
+}
+
+void FileSearcher::runSearch(int search_id, const QString &root_path, const SearchQuery &query, const QHash<QString, QString> &open_buffers) {
+    // Read by every worker at once, so only through const access
+    const QStringList file_paths = collectFiles(root_path);
+    std::string prefilter = buildPrefilter(query);
+
+    std::atomic<int> next_file(0);
+    unsigned worker_count = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < worker_count; i++) {
+        workers.emplace_back([&]() {
+            // Each worker compiles its own expression so matching never shares state
+            QRegularExpression regex = buildRegex(query);
+            int index = 0;
+            while (!cancelled && (index = next_file++) < file_paths.size()) {
+                const QString &file_path = file_paths.at(index);
+                auto open_buffer = open_buffers.constFind(file_path);
+                if (open_buffer != open_buffers.constEnd()) {
+                    searchText(search_id, file_path, open_buffer.value(), regex);
+                } else {
+                    searchFile(search_id, file_path, regex, !query.case_sensitive, prefilter);
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    emit searchFinished(search_id, static_cast<int>(file_paths.size()), cancelled);
+}
+
+void FileSearcher::searchFile(int search_id, const QString &file_path, const QRegularExpression &regex, bool ignore_case, const std::string &prefilter) {
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    qint64 size = file.size();
+    if (size <= 0 || size > MAX_FILE_BYTES) {
+        return;
+    }
+    QByteArray fallback;
+    const char *data = reinterpret_cast<const char *>(file.map(0, size));
+    if (!data) {
+        fallback = file.readAll();
+        data = fallback.constData();
+        size = fallback.size();
+    }
+
+    bool is_binary = std::memchr(data, '\0', static_cast<size_t>(std::min<qint64>(size, BINARY_SNIFF_BYTES))) != nullptr;
+    bool may_match = prefilter.empty() || LiteralScanner::find(data, static_cast<size_t>(size), prefilter, ignore_case) != LiteralScanner::NOT_FOUND;
+    if (is_binary || !may_match) {
+        return;
+    }
+
+    searchText(search_id, file_path, QString::fromUtf8(data, size), regex);
+}
+
+void FileSearcher::searchText(int search_id, const QString &file_path, const QString &text, const QRegularExpression &regex) {
+    FileSearchResult result{search_id, file_path, {}};
+    int line = 0;
+    qsizetype line_start = 0;
+    qsizetype scanned = 0;
+    QRegularExpressionMatchIterator matches = regex.globalMatch(text);
+    while (matches.hasNext() && result.matches.size() < MAX_MATCHES_PER_FILE) {
+        QRegularExpressionMatch match = matches.next();
+        if (match.capturedLength() == 0) {
+            continue;
+        }
+        qsizetype position = match.capturedStart();
+        for (; scanned < position; scanned++) {
+            if (text.at(scanned) == '\n') {
+                line++;
+                line_start = scanned + 1;
+            }
+        }
+        qsizetype line_end = text.indexOf('\n', position);
+        if (line_end < 0) {
+            line_end = text.size();
+        }
+        result.matches.append(SearchMatch{line, static_cast<int>(position - line_start), static_cast<int>(match.capturedLength()),
+                                          text.mid(line_start, std::min<qsizetype>(line_end - line_start, MAX_PREVIEW_CHARS))});
+    }
+    if (!result.matches.isEmpty() && !cancelled) {
+        emit fileMatched(result);
+    }
+}
+
+bool FileSearcher::replaceInText(QString &text, const SearchQuery &query, const QString &replacement) {
+    QString replaced = text;
+    if (query.use_regex) {
+        replaced.replace(buildRegex(query), replacement);
+    } else {
+        replaced.replace(query.pattern, replacement, query.case_sensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+    }
+    if (replaced == text) {
+        return false;
+    }
+    text = replaced;
+    return true;
+}
+
+// Every file is rewritten through QSaveFile, so a crash or a full disk leaves
+// either the old or the new content, never a truncated file.
+void FileSearcher::runReplace(const QStringList &file_paths, const SearchQuery &query, const QString &replacement) {
+    int files_changed = 0;
+    QStringList failed_paths;
+    for (const QString &file_path : file_paths) {
+        if (cancelled) {
+            break;
+        }
+        QFile file(file_path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            failed_paths << file_path;
+            continue;
+        }
+        QByteArray original = file.readAll();
+        file.close();
+
+        // Refuse to rewrite files that would not survive a UTF-8 round trip
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QString text = decoder(original);
+        if (decoder.hasError()) {
+            failed_paths << file_path;
+            continue;
+        }
+        if (!replaceInText(text, query, replacement)) {
+            continue;
+        }
+
+        QSaveFile output(file_path);
+        if (!output.open(QIODevice::WriteOnly) || output.write(text.toUtf8()) < 0 || !output.commit()) {
+            failed_paths << file_path;
+            continue;
+        }
+        files_changed++;
+    }
+    emit replaceFinished(files_changed, failed_paths);
+}
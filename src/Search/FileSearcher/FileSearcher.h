@@ -0,0 +1,76 @@
+#ifndef FILESEARCHER_H
+#define FILESEARCHER_H
+
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <string>
+#include <thread>
+
+struct SearchQuery {
+    QString pattern;
+    bool use_regex = false;
+    bool case_sensitive = false;
+};
+
+struct SearchMatch {
+    int line;   // 0-based
+    int column; // 0-based, in QString characters
+    int length;
+    QString line_text;
+};
+
+struct FileSearchResult {
+    int search_id;
+    QString file_path;
+    QList<SearchMatch> matches;
+};
+
+Q_DECLARE_METATYPE(FileSearchResult)
+
+// Searches every file under a folder on a pool of worker threads. Each file
+// is memory-mapped and rejected with a SIMD literal scan before the regex
+// runs, and results are streamed per file through queued signals. Files open
+// in an editor are passed in as open_buffers and searched as shown there,
+// and replaceAll() leaves them to the caller so unsaved edits survive.
+class FileSearcher : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit FileSearcher(QObject *parent = nullptr);
+    ~FileSearcher();
+    int start(const QString &root_path, const SearchQuery &query, const QHash<QString, QString> &open_buffers = {});
+    void cancel();
+    void replaceAll(const QStringList &file_paths, const SearchQuery &query, const QString &replacement);
+    // The replacement replaceAll() applies to each file, false when nothing matched
+    static bool replaceInText(QString &text, const SearchQuery &query, const QString &replacement);
+
+  signals:
+    void fileMatched(const FileSearchResult &result);
+    void searchFinished(int search_id, int files_scanned, bool cancelled);
+    void replaceFinished(int files_changed, const QStringList &failed_paths);
+
+  private:
+    void runSearch(int search_id, const QString &root_path, const SearchQuery &query, const QHash<QString, QString> &open_buffers);
+    void runReplace(const QStringList &file_paths, const SearchQuery &query, const QString &replacement);
+    void searchFile(int search_id, const QString &file_path, const QRegularExpression &regex, bool ignore_case, const std::string &prefilter);
+    void searchText(int search_id, const QString &file_path, const QString &text, const QRegularExpression &regex);
+    QStringList collectFiles(const QString &root_path) const;
+    void joinCoordinator();
+
+    std::thread coordinator;
+    std::atomic<bool> cancelled;
+    int next_search_id;
+
+    static constexpr qint64 MAX_FILE_BYTES = 8 * 1024 * 1024;
+    static constexpr int BINARY_SNIFF_BYTES = 4096;
+    static constexpr int MAX_MATCHES_PER_FILE = 1000;
+    static constexpr int MAX_PREVIEW_CHARS = 240;
+};
+
+#endif // FILESEARCHER_H
@@ -0,0 +1,242 @@
+#include "FuzzyMatcher.h"
+#include <algorithm>
+
+namespace {
+    constexpr int SCORE_MATCH = 16;
+    constexpr int BONUS_SEGMENT_START = 12;
+    constexpr int BONUS_CAMEL_CASE = 8;
+    constexpr int BONUS_CONSECUTIVE = 10;
+    constexpr int BONUS_FILE_NAME = 6;
+    constexpr int PENALTY_GAP = 1;
+    constexpr int MAX_GAP_PENALTY = 12;
+
+    // ASCII only, the locale-aware <cctype> calls dominate the scan otherwise
+    char toLower(char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool isUpper(char c) {
+        return c >= 'A' && c <= 'Z';
+    }
+
+    bool isLower(char c) {
+        return c >= 'a' && c <= 'z';
+    }
+
+    bool isSeparator(char c) {
+        return c == '/' || c == '\\' || c == '_' || c == '-' || c == '.' || c == ' ';
+    }
+
+    int charBit(char c) {
+        if (c >= 'a' && c <= 'z') {
+            return c - 'a';
+        }
+        if (c >= '0' && c <= '9') {
+            return 26 + (c - '0');
+        }
+        // Every other byte shares a handful of buckets
+        return 36 + (static_cast<unsigned char>(c) % 28);
+    }
+
+    size_t fileNameStart(std::string_view path) {
+        size_t start = path.size();
+        while (start > 0 && path[start - 1] != '/' && path[start - 1] != '\\') {
+            start--;
+        }
+        return start;
+    }
+
+    int lengthPenalty(size_t path_length) {
+        return static_cast<int>(std::min<size_t>(path_length, 255) / 16);
+    }
+
+    // The most scoreWindow() can give, so a full heap of results can skip
+    // scoring. The first character can at best start a segment; every later
+    // one either follows its predecessor, at best as a camelCase hump, or
+    // starts a segment after a gap of at least one. The file name bonus is
+    // only possible when the match window ends inside the file name.
+    int maxScore(size_t query_length, size_t path_length, bool ends_in_file_name) {
+        if (query_length == 0) {
+            return 0;
+        }
+        int file_name = ends_in_file_name ? BONUS_FILE_NAME : 0;
+        int first = SCORE_MATCH + BONUS_SEGMENT_START + file_name;
+        int next = SCORE_MATCH + std::max(BONUS_CONSECUTIVE + BONUS_CAMEL_CASE, BONUS_SEGMENT_START - PENALTY_GAP) + file_name;
+        return first + static_cast<int>(query_length - 1) * next - lengthPenalty(path_length);
+    }
+
+    // Finds where the earliest complete match ends; memchr does the skipping
+    bool findMatchEnd(std::string_view lower_path, std::string_view lower_query, size_t &end) {
+        size_t from = 0;
+        for (char c : lower_query) {
+            end = lower_path.find(c, from);
+            if (end == std::string_view::npos) {
+                return false;
+            }
+            from = end + 1;
+        }
+        return true;
+    }
+
+    int scoreWindow(std::string_view path, std::string_view lower_path, std::string_view lower_query, size_t end,
+                    size_t file_name_start) {
+        if (lower_query.empty()) {
+            return 0;
+        }
+        // Backward pass tightens the start so the window is as short as possible
+        size_t start = end;
+        size_t query_pos = lower_query.size();
+        for (size_t i = end + 1; i-- > 0;) {
+            if (lower_path[i] == lower_query[query_pos - 1] && --query_pos == 0) {
+                start = i;
+                break;
+            }
+        }
+
+        int total = 0;
+        int gap_penalty = 0;
+        size_t previous = std::string_view::npos;
+        query_pos = 0;
+        for (size_t i = start; i <= end && query_pos < lower_query.size(); i++) {
+            if (lower_path[i] != lower_query[query_pos]) {
+                continue;
+            }
+            total += SCORE_MATCH;
+            if (i == 0 || isSeparator(path[i - 1])) {
+                total += BONUS_SEGMENT_START;
+            } else if (isUpper(path[i]) && isLower(path[i - 1])) {
+                total += BONUS_CAMEL_CASE;
+            }
+            if (previous != std::string_view::npos && previous + 1 == i) {
+                total += BONUS_CONSECUTIVE;
+            } else if (previous != std::string_view::npos) {
+                gap_penalty += std::min<int>(static_cast<int>(i - previous - 1) * PENALTY_GAP, MAX_GAP_PENALTY);
+            }
+            if (i >= file_name_start) {
+                total += BONUS_FILE_NAME;
+            }
+            previous = i;
+            query_pos++;
+        }
+        // Among equal matches prefer shorter paths
+        return std::max(0, total - gap_penalty - lengthPenalty(lower_path.size()));
+    }
+}
+
+void PathList::clear() {
+    blob.clear();
+    lower_blob.clear();
+    offsets.assign(1, 0);
+    masks.clear();
+    file_name_starts.clear();
+}
+
+void PathList::reserve(size_t path_count, size_t total_bytes) {
+    blob.reserve(total_bytes);
+    lower_blob.reserve(total_bytes);
+    offsets.reserve(path_count + 1);
+    masks.reserve(path_count);
+    file_name_starts.reserve(path_count);
+}
+
+void PathList::append(std::string_view path) {
+    size_t start = lower_blob.size();
+    blob.append(path);
+    for (char c : path) {
+        lower_blob += toLower(c);
+    }
+    offsets.push_back(static_cast<uint32_t>(blob.size()));
+    masks.push_back(FuzzyMatcher::charMask(std::string_view(lower_blob).substr(start)));
+    file_name_starts.push_back(static_cast<uint32_t>(fileNameStart(path)));
+}
+
+std::string_view PathList::at(size_t index) const {
+    return std::string_view(blob).substr(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+std::string_view PathList::lowerAt(size_t index) const {
+    return std::string_view(lower_blob).substr(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+namespace FuzzyMatcher {
+    uint64_t charMask(std::string_view lower_text) {
+        uint64_t mask = 0;
+        for (char c : lower_text) {
+            mask |= uint64_t(1) << charBit(c);
+        }
+        return mask;
+    }
+
+    int score(std::string_view path, std::string_view lower_path, std::string_view lower_query) {
+        size_t end = 0;
+        if (!findMatchEnd(lower_path, lower_query, end)) {
+            return NO_MATCH;
+        }
+        return scoreWindow(path, lower_path, lower_query, end, fileNameStart(lower_path));
+    }
+
+    std::vector<FuzzyResult> match(const PathList &paths, const std::string &query, size_t limit,
+                                   const std::vector<uint32_t> *candidates, std::vector<uint32_t> *matched) {
+        std::string lower_query;
+        lower_query.reserve(query.size());
+        for (char c : query) {
+            if (c != ' ') {
+                lower_query += toLower(c);
+            }
+        }
+        uint64_t query_mask = charMask(lower_query);
+
+        auto better = [](const FuzzyResult &a, const FuzzyResult &b) {
+            return a.score != b.score ? a.score > b.score : a.index < b.index;
+        };
+        // Bounded heap with the worst kept result on top: most matches of a
+        // short query lose to it and are dropped without being stored
+        std::vector<FuzzyResult> results;
+        results.reserve(limit + 1);
+        if (matched) {
+            matched->clear();
+        }
+        auto consider = [&](uint32_t index) {
+            if ((paths.maskAt(index) & query_mask) != query_mask) {
+                return;
+            }
+            std::string_view lower_path = paths.lowerAt(index);
+            size_t end = 0;
+            if (!findMatchEnd(lower_path, lower_query, end)) {
+                return;
+            }
+            if (matched) {
+                matched->push_back(index);
+            }
+            // Indices arrive in increasing order, so a tie with the worst kept result loses too
+            size_t file_name_start = paths.fileNameStartAt(index);
+            if (!results.empty() && results.size() == limit) {
+                int best_possible = maxScore(lower_query.size(), lower_path.size(), end >= file_name_start);
+                if (!better({index, best_possible}, results.front())) {
+                    return;
+                }
+            }
+            FuzzyResult result{index, scoreWindow(paths.at(index), lower_path, lower_query, end, file_name_start)};
+            if (results.size() < limit) {
+                results.push_back(result);
+                std::push_heap(results.begin(), results.end(), better);
+            } else if (limit > 0 && better(result, results.front())) {
+                std::pop_heap(results.begin(), results.end(), better);
+                results.back() = result;
+                std::push_heap(results.begin(), results.end(), better);
+            }
+        };
+        if (candidates) {
+            for (uint32_t index : *candidates) {
+                consider(index);
+            }
+        } else {
+            for (uint32_t index = 0; index < paths.size(); index++) {
+                consider(index);
+            }
+        }
+
+        std::sort_heap(results.begin(), results.end(), better);
+        return results;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Paths packed back to back in one buffer so a full scan walks memory
+// linearly. A lowercase copy and a 64-bit character mask per path let most
+// candidates be rejected without looking at their bytes; where the file name
+// starts is kept too, so scoring does not search for the last separator.
+class PathList {
+  public:
+    void clear();
+    void reserve(size_t path_count, size_t total_bytes);
+    void append(std::string_view path);
+    size_t size() const { return masks.size(); }
+    std::string_view at(size_t index) const;
+    std::string_view lowerAt(size_t index) const;
+    uint64_t maskAt(size_t index) const { return masks[index]; }
+    size_t fileNameStartAt(size_t index) const { return file_name_starts[index]; }
+
+  private:
+    std::string blob;
+    std::string lower_blob;
+    std::vector<uint32_t> offsets{0}; // offsets[i] .. offsets[i + 1] is path i
+    std::vector<uint64_t> masks;
+    std::vector<uint32_t> file_name_starts; // relative to the path
+};
+
+struct FuzzyResult {
+    uint32_t index;
+    int score;
+};
+
+namespace FuzzyMatcher {
+    constexpr int NO_MATCH = -1;
+
+    uint64_t charMask(std::string_view lower_text);
+
+    // Subsequence match with bonuses for segment starts, camelCase humps,
+    // consecutive runs and hits inside the file name. NO_MATCH if the query
+    // is not a subsequence of the path.
+    int score(std::string_view path, std::string_view lower_path, std::string_view lower_query);
+
+    // Best `limit` results, highest score first. When `candidates` is given
+    // only those indices are scored; `matched` receives every matching index
+    // so the next, longer query can be narrowed to it.
+    std::vector<FuzzyResult> match(const PathList &paths, const std::string &query, size_t limit,
+                                   const std::vector<uint32_t> *candidates = nullptr,
+                                   std::vector<uint32_t> *matched = nullptr);
+}
+
+#endif // FUZZYMATCHER_H
@@ -0,0 +1,220 @@
+#include "LiteralScanner.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace LiteralScanner {
+    namespace {
+        char toLowerAscii(char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        char toUpperAscii(char c) {
+            return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        }
+
+        bool equalsAt(const char *data, const std::string &needle, bool ignore_case) {
+            if (!ignore_case) {
+                return std::memcmp(data, needle.data(), needle.size()) == 0;
+            }
+            for (size_t i = 0; i < needle.size(); i++) {
+                if (toLowerAscii(data[i]) != toLowerAscii(needle[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t findScalar(const char *data, size_t size, const std::string &needle, bool ignore_case, size_t from) {
+            size_t last_start = size - needle.size();
+            for (size_t i = from; i <= last_start; i++) {
+                if (equalsAt(data + i, needle, ignore_case)) {
+                    return i;
+                }
+            }
+            return NOT_FOUND;
+        }
+
+        bool isHexDigit(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        // pattern[i] is the character after a backslash. Returns the index of
+        // the last character of the escape, past any argument it takes, so
+        // \x41 or \cA are never mistaken for literal text.
+        size_t skipEscapeArgument(const std::string &pattern, size_t i) {
+            char escaped = pattern[i];
+            auto skipTo = [&](char close) {
+                while (i + 1 < pattern.size() && pattern[i + 1] != close) {
+                    i++;
+                }
+                return std::min(i + 1, pattern.size() - 1);
+            };
+            auto skipWhile = [&](bool (*accept)(char), size_t limit) {
+                for (size_t taken = 0; taken < limit && i + 1 < pattern.size() && accept(pattern[i + 1]); taken++) {
+                    i++;
+                }
+                return i;
+            };
+            char next = i + 1 < pattern.size() ? pattern[i + 1] : '\0';
+            if (escaped >= '0' && escaped <= '9') {
+                // Octal escape or back reference, \012 or \10
+                return skipWhile([](char c) { return c >= '0' && c <= '9'; }, 3);
+            }
+            switch (escaped) {
+                case 'Q':
+                    // Quoted text up to \E
+                    while (i + 2 < pattern.size() && !(pattern[i + 1] == '\\' && pattern[i + 2] == 'E')) {
+                        i++;
+                    }
+                    return std::min(i + 2, pattern.size() - 1);
+                case 'c':
+                    return std::min(i + 1, pattern.size() - 1);
+                case 'x':
+                case 'o':
+                case 'N':
+                case 'p':
+                case 'P':
+                case 'g':
+                case 'k':
+                    if (next == '{') {
+                        return skipTo('}');
+                    }
+                    if (next == '<') {
+                        return skipTo('>');
+                    }
+                    if (next == '\'') {
+                        return skipTo('\'');
+                    }
+                    if (escaped == 'x') {
+                        return skipWhile(isHexDigit, 2);
+                    }
+                    if (escaped == 'p' || escaped == 'P') {
+                        return std::min(i + 1, pattern.size() - 1); // one-letter property, \pL
+                    }
+                    if (escaped == 'g') {
+                        return skipWhile([](char c) { return (c >= '0' && c <= '9') || c == '-'; }, pattern.size());
+                    }
+                    return i;
+                default:
+                    return i;
+            }
+        }
+    }
+
+    size_t find(const char *data, size_t size, const std::string &needle, bool ignore_case, size_t from) {
+        if (needle.empty()) {
+            return from <= size ? from : NOT_FOUND;
+        }
+        if (needle.size() > size || from > size - needle.size()) {
+            return NOT_FOUND;
+        }
+        size_t i = from;
+
+#if defined(__SSE2__)
+        const size_t last_offset = needle.size() - 1;
+        const __m128i first_lower = _mm_set1_epi8(ignore_case ? toLowerAscii(needle.front()) : needle.front());
+        const __m128i first_upper = _mm_set1_epi8(ignore_case ? toUpperAscii(needle.front()) : needle.front());
+        const __m128i last_lower = _mm_set1_epi8(ignore_case ? toLowerAscii(needle.back()) : needle.back());
+        const __m128i last_upper = _mm_set1_epi8(ignore_case ? toUpperAscii(needle.back()) : needle.back());
+
+        while (i + last_offset + 16 <= size) {
+            const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + last_offset));
+            const __m128i first_hits = _mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower), _mm_cmpeq_epi8(block_first, first_upper));
+            const __m128i last_hits = _mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower), _mm_cmpeq_epi8(block_last, last_upper));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(first_hits, last_hits)));
+            while (mask != 0) {
+                size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+                if (equalsAt(data + candidate, needle, ignore_case)) {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+            i += 16;
+        }
+#endif
+
+        return findScalar(data, size, needle, ignore_case, i);
+    }
+
+    std::string requiredLiteral(const std::string &pattern) {
+        // Alternation or inline options make any single literal unreliable
+        for (size_t i = 0; i < pattern.size(); i++) {
+            if (pattern[i] == '\\') {
+                i++;
+            } else if (pattern[i] == '|' || (pattern[i] == '(' && i + 1 < pattern.size() && pattern[i + 1] == '?')) {
+                return std::string();
+            }
+        }
+
+        std::string best;
+        std::string run;
+        int group_depth = 0;
+        auto endRun = [&]() {
+            if (run.size() > best.size()) {
+                best = run;
+            }
+            run.clear();
+        };
+        for (size_t i = 0; i < pattern.size(); i++) {
+            char c = pattern[i];
+            std::string literal;
+            if (c == '\\' && i + 1 < pattern.size()) {
+                char escaped = pattern[++i];
+                if (std::strchr(".^$*+?()[]{}|\\/-", escaped) == nullptr) {
+                    // \d, \w, \b, ... are classes or assertions, \x41, \cA, ... take an argument
+                    endRun();
+                    i = skipEscapeArgument(pattern, i);
+                    continue;
+                }
+                literal = std::string(1, escaped);
+            } else if (c == '[') {
+                endRun();
+                while (i + 1 < pattern.size() && pattern[i + 1] != ']') {
+                    i += pattern[i + 1] == '\\' ? 2 : 1;
+                }
+                i++;
+                continue;
+            } else if (c == '{') {
+                endRun();
+                while (i + 1 < pattern.size() && pattern[i + 1] != '}') {
+                    i++;
+                }
+                i++;
+                continue;
+            } else if (c == '(') {
+                endRun();
+                group_depth++;
+                continue;
+            } else if (c == ')') {
+                group_depth--;
+                continue;
+            } else if (std::strchr(".^$*+?}", c) != nullptr) {
+                endRun();
+                continue;
+            } else {
+                literal = std::string(1, c);
+            }
+
+            if (group_depth > 0) {
+                continue;
+            }
+            // A quantifier that allows zero repetitions makes this character optional
+            char next = i + 1 < pattern.size() ? pattern[i + 1] : '\0';
+            if (next == '?' || next == '*' || next == '{') {
+                endRun();
+                continue;
+            }
+            run += literal;
+            if (next == '+') {
+                endRun();
+            }
+        }
+        endRun();
+        return best;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef LITERALSCANNER_H
+#define LITERALSCANNER_H
+
+#include <cstddef>
+#include <string>
+
+// Byte-level substring search used to reject files before running a regex.
+// On SSE2 targets candidates are found 16 bytes at a time by matching the
+// needle's first and last bytes together, which keeps false candidates rare.
+namespace LiteralScanner {
+    constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // ignore_case folds ASCII letters only
+    size_t find(const char *data, size_t size, const std::string &needle, bool ignore_case, size_t from = 0);
+
+    // Longest run of characters every match of the pattern must contain, or
+    // an empty string when none can be proven (alternation, groups, ...)
+    std::string requiredLiteral(const std::string &pattern);
+}
+
+#endif // LITERALSCANNER_H
@@ -0,0 +1,274 @@
+#include "PathIndex.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+PathIndex::PathIndex(DatabaseWorker *database, QObject *parent)
+    : QObject(parent), database(database), path_generation(0), loading_stored_paths(false), crawler(nullptr) {
+    connect(&DirectoryWatcher::instance(), &DirectoryWatcher::changesReady, this, &PathIndex::onFilesChanged);
+    connect(&DirectoryWatcher::instance(), &DirectoryWatcher::resyncRequired, this, &PathIndex::onResyncRequired);
+}
+
+PathIndex::~PathIndex() {
+    stopCrawl();
+}
+
+QString PathIndex::rootPath() const {
+    return root_path;
+}
+
+const PathList &PathIndex::paths() const {
+    return path_list;
+}
+
+quint64 PathIndex::generation() const {
+    return path_generation;
+}
+
+QString PathIndex::absolutePath(uint32_t index) const {
+    std::string_view path = path_list.at(index);
+    return root_path + "/" + QString::fromUtf8(path.data(), static_cast<qsizetype>(path.size()));
+}
+
+void PathIndex::setRoot(const QString &new_root_path) {
+    QString clean_root = new_root_path.isEmpty() ? QString() : QDir::cleanPath(new_root_path);
+    if (clean_root == root_path) {
+        return;
+    }
+    stopCrawl();
+    root_path = clean_root;
+    relative_paths.clear();
+    changes_during_crawl.clear();
+    rebuildPathList();
+    loading_stored_paths = !root_path.isEmpty();
+    if (!loading_stored_paths) {
+        return;
+    }
+
+    // The crawl is diffed against the stored list, so it starts once that is in
+    database->fetchIndexedPaths(root_path.toStdString()).then(this, [this, requested_root = root_path](std::vector<std::string> stored_paths) {
+        // Leaving and reopening a folder quickly answers twice, the first answer wins
+        if (requested_root != root_path || !loading_stored_paths) {
+            return;
+        }
+        loading_stored_paths = false;
+        for (std::string &path : stored_paths) {
+            if (relative_paths.size() >= MAX_INDEXED_FILES) {
+                break;
+            }
+            relative_paths.insert(std::move(path));
+        }
+        rebuildPathList();
+        startCrawl();
+    });
+}
+
+void PathIndex::startCrawl() {
+    crawl_cancelled = std::make_shared<std::atomic<bool>>(false);
+    auto cancelled = crawl_cancelled;
+    auto result = std::make_shared<std::vector<std::string>>();
+    QString crawl_root = root_path;
+    QThread *thread = QThread::create([crawl_root, cancelled, result]() {
+        *result = crawl(crawl_root, *cancelled);
+    });
+    connect(thread, &QThread::finished, this, [this, thread, cancelled, result]() {
+        // A queued notification can outlive a crawl that was already stopped
+        if (thread != crawler || *cancelled) {
+            return;
+        }
+        crawler->deleteLater();
+        crawler = nullptr;
+        onCrawlFinished(*result);
+    });
+    crawler = thread;
+    crawler->start(QThread::LowPriority);
+}
+
+void PathIndex::stopCrawl() {
+    if (!crawler) {
+        return;
+    }
+    *crawl_cancelled = true;
+    disconnect(crawler, nullptr, this, nullptr);
+    crawler->wait();
+    delete crawler;
+    crawler = nullptr;
+}
+
+bool PathIndex::isIgnoredDirectory(const QString &name) {
+    // VCS metadata and build trees only add noise to quick open
+    return name.startsWith('.') || name == "build" || name == "node_modules";
+}
+
+bool PathIndex::isIgnoredPath(const std::string &relative_path) {
+    size_t start = 0;
+    size_t slash;
+    while ((slash = relative_path.find('/', start)) != std::string::npos) {
+        if (isIgnoredDirectory(QString::fromStdString(relative_path.substr(start, slash - start)))) {
+            return true;
+        }
+        start = slash + 1;
+    }
+    return false;
+}
+
+// Directories go through one queue shared by a thread per core, so a deep
+// tree and a single flat folder of subdirectories spread out the same way.
+// Each worker lists one directory at a time and queues the subdirectories it
+// finds; the crawl ends when the queue is empty and no worker is listing.
+std::vector<std::string> PathIndex::crawl(const QString &root_path, const std::atomic<bool> &cancelled) {
+    std::vector<std::string> result;
+    QString root_prefix = root_path + "/";
+    std::mutex queue_mutex;
+    std::condition_variable queue_changed;
+    QStringList pending{root_path};
+    int listing = 0;
+
+    unsigned worker_count = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < worker_count; i++) {
+        workers.emplace_back([&]() {
+            std::vector<std::string> files;
+            QStringList subdirectories;
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            while (true) {
+                queue_changed.wait(lock, [&]() { return cancelled || !pending.isEmpty() || listing == 0; });
+                if (cancelled || pending.isEmpty()) {
+                    break;
+                }
+                QString directory = pending.takeLast();
+                listing++;
+                lock.unlock();
+
+                QDirIterator entries(directory, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+                while (entries.hasNext() && !cancelled) {
+                    entries.next();
+                    QFileInfo info = entries.fileInfo();
+                    if (info.isDir() && !info.isSymLink()) {
+                        if (!isIgnoredDirectory(info.fileName())) {
+                            subdirectories << info.filePath();
+                        }
+                    } else if (info.isFile()) {
+                        files.push_back(info.filePath().mid(root_prefix.size()).toStdString());
+                    }
+                }
+
+                lock.lock();
+                pending << subdirectories;
+                subdirectories.clear();
+                listing--;
+                queue_changed.notify_all();
+            }
+            queue_changed.notify_all();
+            result.insert(result.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    // Sorted first so every crawl of the same tree keeps the same files
+    if (result.size() > MAX_INDEXED_FILES) {
+        std::sort(result.begin(), result.end());
+        result.resize(MAX_INDEXED_FILES);
+    }
+    return result;
+}
+
+void PathIndex::onCrawlFinished(const std::vector<std::string> &files) {
+    std::set<std::string> crawled(files.begin(), files.end());
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    std::set_difference(crawled.begin(), crawled.end(), relative_paths.begin(), relative_paths.end(), std::back_inserter(added));
+    std::set_difference(relative_paths.begin(), relative_paths.end(), crawled.begin(), crawled.end(), std::back_inserter(removed));
+    applyChanges(added, removed);
+
+    // Anything that changed while the crawl ran may or may not be in its result
+    QList<FileChange> replay;
+    replay.swap(changes_during_crawl);
+    onFilesChanged(replay);
+}
+
+void PathIndex::onFilesChanged(const QList<FileChange> &changes) {
+    if (root_path.isEmpty()) {
+        return;
+    }
+    if (crawler || loading_stored_paths) {
+        changes_during_crawl << changes;
+        return;
+    }
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    QString root_prefix = root_path + "/";
+    for (const FileChange &change : changes) {
+        if (!change.path.startsWith(root_prefix)) {
+            continue;
+        }
+        std::string path = change.path.mid(root_prefix.size()).toStdString();
+        if (change.kind == FileChange::Kind::Added && !change.is_dir) {
+            if (!isIgnoredPath(path) && !relative_paths.count(path)) {
+                added.push_back(path);
+            }
+        } else if (change.kind == FileChange::Kind::Removed) {
+            // A removed directory takes its whole subtree with it
+            std::string subtree = path + "/";
+            if (relative_paths.count(path)) {
+                removed.push_back(path);
+            }
+            for (auto it = relative_paths.lower_bound(subtree); it != relative_paths.end() && it->compare(0, subtree.size(), subtree) == 0; ++it) {
+                removed.push_back(*it);
+            }
+        }
+    }
+    applyChanges(added, removed);
+}
+
+void PathIndex::onResyncRequired() {
+    // Without a root there is nothing to redo, while loading the crawl is still to come
+    if (root_path.isEmpty() || loading_stored_paths) {
+        return;
+    }
+    stopCrawl();
+    startCrawl();
+}
+
+void PathIndex::applyChanges(const std::vector<std::string> &added, const std::vector<std::string> &removed) {
+    if (added.empty() && removed.empty()) {
+        return;
+    }
+    for (const std::string &path : removed) {
+        relative_paths.erase(path);
+    }
+    // Only what made it under the cap is stored, so the next load matches
+    std::vector<std::string> indexed;
+    for (const std::string &path : added) {
+        if (relative_paths.size() >= MAX_INDEXED_FILES) {
+            break;
+        }
+        if (relative_paths.insert(path).second) {
+            indexed.push_back(path);
+        }
+    }
+    if (indexed.empty() && removed.empty()) {
+        return;
+    }
+    database->updateIndexedPaths(root_path.toStdString(), indexed, removed);
+    rebuildPathList();
+}
+
+void PathIndex::rebuildPathList() {
+    size_t total_bytes = 0;
+    for (const std::string &path : relative_paths) {
+        total_bytes += path.size();
+    }
+    path_list.clear();
+    path_list.reserve(relative_paths.size(), total_bytes);
+    for (const std::string &path : relative_paths) {
+        path_list.append(path);
+    }
+    path_generation++;
+    emit pathsChanged();
+}
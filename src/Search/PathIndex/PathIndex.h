@@ -0,0 +1,61 @@
+#ifndef PATHINDEX_H
+#define PATHINDEX_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "../FuzzyMatcher/FuzzyMatcher.h"
+#include "../../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../../FileSystemOperations/DirectoryWatcher/DirectoryWatcher.h"
+
+// Every file under the opened folder, for quick open. The last known list is
+// read from SQLite so the palette works immediately, then reconciled with a
+// parallel crawl and kept current from DirectoryWatcher batches.
+class PathIndex : public QObject {
+    Q_OBJECT
+
+  public:
+    PathIndex(DatabaseWorker *database, QObject *parent = nullptr);
+    ~PathIndex();
+    void setRoot(const QString &root_path);
+    QString rootPath() const;
+    const PathList &paths() const;
+    quint64 generation() const; // bumped whenever paths() changes
+    QString absolutePath(uint32_t index) const;
+
+  signals:
+    void pathsChanged();
+
+  private:
+    void startCrawl();
+    void stopCrawl();
+    void onCrawlFinished(const std::vector<std::string> &files);
+    void onFilesChanged(const QList<FileChange> &changes);
+    void onResyncRequired();
+    void applyChanges(const std::vector<std::string> &added, const std::vector<std::string> &removed);
+    void rebuildPathList();
+    static std::vector<std::string> crawl(const QString &root_path, const std::atomic<bool> &cancelled);
+    static bool isIgnoredDirectory(const QString &name);
+    static bool isIgnoredPath(const std::string &relative_path);
+
+    DatabaseWorker *database;
+    QString root_path;
+    std::set<std::string> relative_paths;
+    PathList path_list;
+    quint64 path_generation;
+    bool loading_stored_paths; // the last known list is still being read
+
+    QThread *crawler;
+    std::shared_ptr<std::atomic<bool>> crawl_cancelled;
+    QList<FileChange> changes_during_crawl; // replayed once the crawl result is in
+
+    static constexpr size_t MAX_INDEXED_FILES = 200000;
+};
+
+#endif // PATHINDEX_H
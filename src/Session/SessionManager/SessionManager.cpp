@@ -0,0 +1,178 @@
+#include "SessionManager.h"
+#include "../../utils/StartupTracer/StartupTracer.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QScrollBar>
+#include <QStandardPaths>
+
+SessionManager::SessionManager(KodetronEditor *code_editor, QSplitter *splitter, StandardIOSection *standard_io, QObject *parent)
+    : QObject(parent), code_editor(code_editor), splitter(splitter), standard_io(standard_io), restored_panel{0, QString()} {
+    save_timer = new QTimer(this);
+    save_timer->setSingleShot(true);
+    save_timer->setInterval(SAVE_DELAY_MS);
+    connect(save_timer, &QTimer::timeout, this, &SessionManager::save);
+
+    // The editor subscribed first, so the file is loaded by the time this runs
+    connect(&AppState::instance(), &AppState::selectedFilePathModified, this, &SessionManager::onFilePathChanged);
+    connect(&AppState::instance(), &AppState::stateChanged, this, &SessionManager::scheduleSave);
+    connect(code_editor, &QsciScintilla::cursorPositionChanged, this, &SessionManager::onViewChanged);
+    connect(code_editor->verticalScrollBar(), &QScrollBar::valueChanged, this, &SessionManager::onViewChanged);
+    connect(splitter, &QSplitter::splitterMoved, this, &SessionManager::scheduleSave);
+    connect(standard_io, &StandardIOSection::panelStateChanged, this, &SessionManager::scheduleSave);
+
+    // Changes made in the last second before quitting are still written
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        if (save_timer->isActive()) {
+            save();
+        }
+    });
+}
+
+QString SessionManager::sessionFilePath() const {
+    QString app_data_dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(app_data_dir);
+    return app_data_dir + "/session.dat";
+}
+
+void SessionManager::restore() {
+    if (!read()) {
+        return;
+    }
+    if (restored_splitter_sizes.size() == splitter->count()) {
+        splitter->setSizes(restored_splitter_sizes);
+    }
+
+    // The visible buffer is the only thing loaded before the first paint
+    QString file_path = restored_state.file_path;
+    if (!file_path.isEmpty() && QFileInfo(file_path).isFile()) {
+        standard_io->restorePanelState(file_path, restored_panel);
+        AppState::instance().setSelectedFilePath(file_path);
+        AppState::instance().commit();
+    }
+
+    QString explorer_path = restored_state.explorer_path;
+    ExplorerPathType explorer_path_type = restored_state.explorer_path_type;
+    if (explorer_path_type == ExplorerPathType::Empty || !QFileInfo::exists(explorer_path)) {
+        return;
+    }
+    StartupTracer::instance().defer("explorer restore", [explorer_path, explorer_path_type]() {
+        AppState &state = AppState::instance();
+        QString open_file_path = state.getSelectedFilePath();
+        state.setSelectedExplorerPath(explorer_path, explorer_path_type);
+        state.commit();
+        // Opening a folder closes the file; within the same change-set this
+        // keeps the file open instead of reloading it
+        if (explorer_path_type == ExplorerPathType::Dir) {
+            state.setSelectedFilePath(open_file_path);
+        }
+    });
+}
+
+void SessionManager::onFilePathChanged(const QString &file_path) {
+    view_file_path = file_path;
+    for (int i = 0; i < view_states.size(); i++) {
+        if (view_states[i].first != file_path) {
+            continue;
+        }
+        EditorViewState view = view_states[i].second;
+        code_editor->setCursorPosition(qMin(view.line, qMax(code_editor->lines() - 1, 0)), view.column);
+        code_editor->setFirstVisibleLine(view.first_visible_line);
+        view_states.move(i, 0);
+        break;
+    }
+    scheduleSave();
+}
+
+void SessionManager::onViewChanged() {
+    // While a new file loads the editor reports positions that belong to it, not to view_file_path
+    if (view_file_path.isEmpty() || view_file_path != AppState::instance().getSelectedFilePath()) {
+        return;
+    }
+    EditorViewState view{0, 0, code_editor->firstVisibleLine()};
+    code_editor->getCursorPosition(&view.line, &view.column);
+    if (!view_states.isEmpty() && view_states.first().first == view_file_path) {
+        view_states.first().second = view;
+    } else {
+        for (int i = 0; i < view_states.size(); i++) {
+            if (view_states[i].first == view_file_path) {
+                view_states.removeAt(i);
+                break;
+            }
+        }
+        view_states.prepend(qMakePair(view_file_path, view));
+        while (view_states.size() > MAX_VIEW_STATES) {
+            view_states.removeLast();
+        }
+    }
+    scheduleSave();
+}
+
+void SessionManager::scheduleSave() {
+    save_timer->start();
+}
+
+void SessionManager::save() {
+    save_timer->stop();
+    // Written to a temporary file and renamed, a crash never leaves half a session
+    QSaveFile file(sessionFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << FILE_MAGIC << FILE_VERSION;
+
+    std::shared_ptr<const AppStateSnapshot> state = AppState::instance().snapshot();
+    out << state->explorer_path << static_cast<qint32>(state->explorer_path_type) << state->dir_path << state->file_path;
+    out << splitter->sizes();
+    TestPanelState panel = standard_io->panelState();
+    out << static_cast<qint32>(panel.test_index) << panel.input;
+    out << static_cast<quint32>(view_states.size());
+    for (const QPair<QString, EditorViewState> &entry : view_states) {
+        out << entry.first << static_cast<qint32>(entry.second.line) << static_cast<qint32>(entry.second.column)
+            << static_cast<qint32>(entry.second.first_visible_line);
+    }
+    file.commit();
+}
+
+bool SessionManager::read() {
+    QFile file(sessionFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    // Sessions of other versions are dropped rather than converted
+    if (magic != FILE_MAGIC || version != FILE_VERSION) {
+        return false;
+    }
+
+    qint32 explorer_path_type = 0;
+    in >> restored_state.explorer_path >> explorer_path_type >> restored_state.dir_path >> restored_state.file_path;
+    if (explorer_path_type < static_cast<qint32>(ExplorerPathType::Empty) || explorer_path_type > static_cast<qint32>(ExplorerPathType::File)) {
+        return false;
+    }
+    restored_state.explorer_path_type = static_cast<ExplorerPathType>(explorer_path_type);
+    in >> restored_splitter_sizes;
+    qint32 test_index = 0;
+    in >> test_index >> restored_panel.input;
+    restored_panel.test_index = test_index;
+
+    quint32 view_count = 0;
+    in >> view_count;
+    for (quint32 i = 0; i < view_count && i < static_cast<quint32>(MAX_VIEW_STATES) && in.status() == QDataStream::Ok; i++) {
+        QString path;
+        qint32 line = 0;
+        qint32 column = 0;
+        qint32 first_visible_line = 0;
+        in >> path >> line >> column >> first_visible_line;
+        view_states.append(qMakePair(path, EditorViewState{line, column, first_visible_line}));
+    }
+    return in.status() == QDataStream::Ok;
+}
@@ -0,0 +1,62 @@
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QSplitter>
+#include <QString>
+#include <QTimer>
+#include "../../Global/AppState.h"
+#include "../../widgets/KodetronEditor/KodetronEditor.h"
+#include "../../widgets/StandardIO/StandardIOSection/StandardIOSection.h"
+
+struct EditorViewState {
+    int line;
+    int column;
+    int first_visible_line;
+};
+
+// Keeps the workspace across restarts: the opened folder and file, the caret
+// and scroll position of recently opened files, the splitter sizes and the
+// test panel. Every change restarts a short timer and the whole session is
+// then written to one small binary file, so bursts of typing or dragging
+// cost a single write.
+//
+// restore() loads the open file into the editor before the window is shown;
+// the explorer, which crawls the folder, is restored as a deferred startup
+// task, and the view state of other files is applied when they are opened.
+class SessionManager : public QObject {
+    Q_OBJECT
+
+  public:
+    SessionManager(KodetronEditor *code_editor, QSplitter *splitter, StandardIOSection *standard_io, QObject *parent = nullptr);
+    void restore();
+
+  private:
+    void onFilePathChanged(const QString &file_path);
+    void onViewChanged();
+    void scheduleSave();
+    void save();
+    bool read();
+    QString sessionFilePath() const;
+
+    KodetronEditor *code_editor;
+    QSplitter *splitter;
+    StandardIOSection *standard_io;
+    QTimer *save_timer;
+    QString view_file_path; // file whose view the editor shows, empty while another one loads
+    QList<QPair<QString, EditorViewState>> view_states; // most recently used first
+
+    // Read by restore()
+    AppStateSnapshot restored_state;
+    QList<int> restored_splitter_sizes;
+    TestPanelState restored_panel;
+
+    static constexpr quint32 FILE_MAGIC = 0x4B534553; // "KSES"
+    static constexpr quint16 FILE_VERSION = 1;
+    static constexpr int SAVE_DELAY_MS = 1000;
+    static constexpr int MAX_VIEW_STATES = 100;
+};
+
+#endif // SESSIONMANAGER_H
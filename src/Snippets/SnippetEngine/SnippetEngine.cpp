@@ -0,0 +1,38 @@
+#include "SnippetEngine.h"
+
+SnippetEngine &SnippetEngine::instance() {
+    static SnippetEngine instance;
+    return instance;
+}
+
+void SnippetEngine::load(DatabaseWorker *database, int user_id) {
+    // Until the list arrives nothing expands, which only matters for the first few ms
+    database->fetchSnippets(user_id).then(database, [this](std::vector<Snippet> snippets) {
+        snippets_by_trigger.clear();
+        triggers_by_id.clear();
+        for (const Snippet &snippet : snippets) {
+            upsert(snippet);
+        }
+    });
+}
+
+void SnippetEngine::upsert(const Snippet &snippet) {
+    // A rename leaves the old trigger behind unless it is dropped here
+    remove(snippet.id);
+    snippets_by_trigger[snippet.name] = SnippetParser::parse(snippet.content);
+    triggers_by_id[snippet.id] = snippet.name;
+}
+
+void SnippetEngine::remove(int snippet_id) {
+    auto trigger = triggers_by_id.find(snippet_id);
+    if (trigger == triggers_by_id.end()) {
+        return;
+    }
+    snippets_by_trigger.erase(trigger->second);
+    triggers_by_id.erase(trigger);
+}
+
+const ParsedSnippet *SnippetEngine::find(const std::string &trigger) const {
+    auto snippet = snippets_by_trigger.find(trigger);
+    return snippet == snippets_by_trigger.end() ? nullptr : &snippet->second;
+}
@@ -0,0 +1,26 @@
+#ifndef SNIPPETENGINE_H
+#define SNIPPETENGINE_H
+
+#include <string>
+#include <unordered_map>
+#include "../SnippetParser/SnippetParser.h"
+#include "../../Database/DatabaseWorker/DatabaseWorker.h"
+
+// In-memory trigger -> parsed snippet map. Loaded once from the database and
+// kept in sync by SnippetsModal, so expanding never queries SQLite.
+class SnippetEngine {
+  public:
+    static SnippetEngine &instance(); // Global access to the singleton
+
+    void load(DatabaseWorker *database, int user_id);
+    void upsert(const Snippet &snippet);
+    void remove(int snippet_id);
+    const ParsedSnippet *find(const std::string &trigger) const;
+
+  private:
+    SnippetEngine() = default;
+    std::unordered_map<std::string, ParsedSnippet> snippets_by_trigger;
+    std::unordered_map<int, std::string> triggers_by_id;
+};
+
+#endif // SNIPPETENGINE_H
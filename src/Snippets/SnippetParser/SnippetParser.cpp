@@ -0,0 +1,149 @@
+#include "SnippetParser.h"
+#include "../../utils/RangeShift/RangeShift.h"
+#include <algorithm>
+#include <cctype>
+#include <map>
+
+namespace SnippetParser {
+    namespace {
+        bool readIndex(const std::string &content, size_t &pos, int &index) {
+            size_t start = pos;
+            index = 0;
+            while (pos < content.size() && std::isdigit(static_cast<unsigned char>(content[pos]))) {
+                index = index * 10 + (content[pos] - '0');
+                pos++;
+            }
+            return pos > start;
+        }
+    }
+
+    ParsedSnippet parse(const std::string &content) {
+        ParsedSnippet snippet;
+        snippet.body.reserve(content.size());
+        size_t pos = 0;
+        while (pos < content.size()) {
+            char c = content[pos];
+            if (c == '\\' && pos + 1 < content.size() && (content[pos + 1] == '$' || content[pos + 1] == '}' || content[pos + 1] == '\\')) {
+                snippet.body += content[pos + 1];
+                pos += 2;
+                continue;
+            }
+            if (c != '$' || pos + 1 >= content.size()) {
+                snippet.body += c;
+                pos++;
+                continue;
+            }
+
+            size_t cursor = pos + 1;
+            int index = 0;
+            if (readIndex(content, cursor, index)) {
+                snippet.tab_stops.push_back({index, snippet.body.size(), 0});
+                pos = cursor;
+                continue;
+            }
+            if (content[cursor] != '{') {
+                snippet.body += c;
+                pos++;
+                continue;
+            }
+            cursor++;
+            if (!readIndex(content, cursor, index) || cursor >= content.size() || (content[cursor] != '}' && content[cursor] != ':')) {
+                // Not a placeholder, keep the text as written
+                snippet.body += c;
+                pos++;
+                continue;
+            }
+
+            size_t offset = snippet.body.size();
+            if (content[cursor] == ':') {
+                cursor++;
+                while (cursor < content.size() && content[cursor] != '}') {
+                    if (content[cursor] == '\\' && cursor + 1 < content.size()) {
+                        cursor++;
+                    }
+                    snippet.body += content[cursor];
+                    cursor++;
+                }
+            }
+            snippet.tab_stops.push_back({index, offset, snippet.body.size() - offset});
+            pos = std::min(cursor + 1, content.size());
+        }
+
+        // Still in document order: fill each bare repeat with its index's default
+        std::map<int, std::string> defaults;
+        for (const SnippetTabStop &stop : snippet.tab_stops) {
+            if (stop.length > 0 && stop.index != 0) {
+                defaults.emplace(stop.index, snippet.body.substr(stop.offset, stop.length));
+            }
+        }
+        if (!defaults.empty()) {
+            std::string mirrored;
+            mirrored.reserve(snippet.body.size());
+            size_t copied = 0;
+            for (SnippetTabStop &stop : snippet.tab_stops) {
+                mirrored.append(snippet.body, copied, stop.offset - copied);
+                copied = stop.offset;
+                stop.offset = mirrored.size();
+                auto found = defaults.find(stop.index);
+                if (stop.length == 0 && found != defaults.end()) {
+                    mirrored += found->second;
+                    stop.length = found->second.size();
+                } else {
+                    mirrored.append(snippet.body, copied, stop.length);
+                    copied += stop.length;
+                }
+            }
+            mirrored.append(snippet.body, copied, std::string::npos);
+            snippet.body = std::move(mirrored);
+        }
+
+        // Visit $1, $2, ... in order and finish on $0, or at the end when absent
+        std::stable_sort(snippet.tab_stops.begin(), snippet.tab_stops.end(), [](const SnippetTabStop &a, const SnippetTabStop &b) {
+            if (a.index == 0 || b.index == 0) {
+                return b.index == 0 && a.index != 0;
+            }
+            return a.index < b.index;
+        });
+        if (snippet.tab_stops.empty() || snippet.tab_stops.back().index != 0) {
+            snippet.tab_stops.push_back({0, snippet.body.size(), 0});
+        }
+        return snippet;
+    }
+
+    ParsedSnippet indent(const ParsedSnippet &snippet, const std::string &line_indent) {
+        if (line_indent.empty()) {
+            return snippet;
+        }
+        ParsedSnippet indented;
+        indented.body.reserve(snippet.body.size());
+        // new_offsets[i] is where byte i of the original body lands
+        std::vector<size_t> new_offsets(snippet.body.size() + 1);
+        for (size_t i = 0; i < snippet.body.size(); i++) {
+            new_offsets[i] = indented.body.size();
+            indented.body += snippet.body[i];
+            if (snippet.body[i] == '\n') {
+                indented.body += line_indent;
+            }
+        }
+        new_offsets[snippet.body.size()] = indented.body.size();
+
+        for (const SnippetTabStop &stop : snippet.tab_stops) {
+            size_t start = new_offsets[stop.offset];
+            size_t end = new_offsets[stop.offset + stop.length];
+            indented.tab_stops.push_back({stop.index, start, end - start});
+        }
+        return indented;
+    }
+
+    void shiftForInsert(std::vector<SnippetTabStop> &tab_stops, size_t position, size_t length, int active_index) {
+        for (SnippetTabStop &stop : tab_stops) {
+            RangeShift::forInsert(stop.offset, stop.length, position, length, stop.index == active_index);
+        }
+    }
+
+    void shiftForDelete(std::vector<SnippetTabStop> &tab_stops, size_t position, size_t length) {
+        for (SnippetTabStop &stop : tab_stops) {
+            RangeShift::forDelete(stop.offset, stop.length, position, length);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef SNIPPETPARSER_H
+#define SNIPPETPARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct SnippetTabStop {
+    int index;     // $1, ${2:x}, ... ; 0 is the final caret position
+    size_t offset; // byte offset into the expanded body
+    size_t length; // length of the placeholder default text
+};
+
+struct ParsedSnippet {
+    std::string body;                      // content with placeholders replaced by their defaults
+    std::vector<SnippetTabStop> tab_stops; // in visiting order, final stop last
+};
+
+// Placeholder syntax: $1, ${1}, ${1:default} and $0 for the final caret
+// position. \$ and \} insert literal characters. A placeholder repeated
+// without a default mirrors the default given elsewhere, and every stop of
+// one index is kept so the editor can edit them together.
+namespace SnippetParser {
+    ParsedSnippet parse(const std::string &content);
+    ParsedSnippet indent(const ParsedSnippet &snippet, const std::string &line_indent);
+
+    // Keep tracked tab stops in place while the expanded text is edited. Text
+    // typed at the edge of a stop extends it only if it belongs to active_index,
+    // the placeholder being edited; other stops starting there move instead.
+    void shiftForInsert(std::vector<SnippetTabStop> &tab_stops, size_t position, size_t length, int active_index);
+    void shiftForDelete(std::vector<SnippetTabStop> &tab_stops, size_t position, size_t length);
+}
+
+#endif // SNIPPETPARSER_H
@@ -0,0 +1,39 @@
+#include "TemplateCache.h"
+#include <algorithm>
+
+TemplateCache &TemplateCache::instance() {
+    static TemplateCache instance;
+    return instance;
+}
+
+void TemplateCache::load(DatabaseWorker *database, int user_id) {
+    database->fetchTemplates(user_id).then(database, [this](std::vector<Template> templates) {
+        cached_templates.clear();
+        for (const Template &template_obj : templates) {
+            upsert(template_obj);
+        }
+    });
+}
+
+void TemplateCache::upsert(const Template &template_obj) {
+    CachedTemplate cached{template_obj.id, template_obj.name, TemplateRenderer::parse(template_obj.content)};
+    auto existing = std::find_if(cached_templates.begin(), cached_templates.end(), [&](const CachedTemplate &entry) { return entry.id == template_obj.id; });
+    if (existing != cached_templates.end()) {
+        *existing = std::move(cached);
+    } else {
+        cached_templates.push_back(std::move(cached));
+    }
+}
+
+void TemplateCache::remove(int template_id) {
+    cached_templates.erase(std::remove_if(cached_templates.begin(), cached_templates.end(), [&](const CachedTemplate &entry) { return entry.id == template_id; }), cached_templates.end());
+}
+
+const std::vector<CachedTemplate> &TemplateCache::templates() const {
+    return cached_templates;
+}
+
+const CachedTemplate *TemplateCache::findById(int template_id) const {
+    auto existing = std::find_if(cached_templates.begin(), cached_templates.end(), [&](const CachedTemplate &entry) { return entry.id == template_id; });
+    return existing == cached_templates.end() ? nullptr : &*existing;
+}
@@ -0,0 +1,32 @@
+#ifndef TEMPLATECACHE_H
+#define TEMPLATECACHE_H
+
+#include <string>
+#include <vector>
+#include "../TemplateRenderer/TemplateRenderer.h"
+#include "../../Database/DatabaseWorker/DatabaseWorker.h"
+
+struct CachedTemplate {
+    int id;
+    std::string name;
+    ParsedTemplate parsed;
+};
+
+// Parsed templates kept in memory so instantiating files only renders.
+// TemplatesModal keeps it in sync with the Templates table.
+class TemplateCache {
+  public:
+    static TemplateCache &instance(); // Global access to the singleton
+
+    void load(DatabaseWorker *database, int user_id);
+    void upsert(const Template &template_obj);
+    void remove(int template_id);
+    const std::vector<CachedTemplate> &templates() const;
+    const CachedTemplate *findById(int template_id) const;
+
+  private:
+    TemplateCache() = default;
+    std::vector<CachedTemplate> cached_templates;
+};
+
+#endif // TEMPLATECACHE_H
@@ -0,0 +1,76 @@
+#include "TemplateRenderer.h"
+#include <cctype>
+
+namespace TemplateRenderer {
+    namespace {
+        bool isVariableName(const std::string &name) {
+            if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+                return false;
+            }
+            for (char c : name) {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void appendLiteral(ParsedTemplate &parsed, const std::string &text) {
+            if (text.empty()) {
+                return;
+            }
+            if (!parsed.segments.empty() && !parsed.segments.back().is_variable) {
+                parsed.segments.back().text += text;
+            } else {
+                parsed.segments.push_back({false, text});
+            }
+            parsed.literal_size += text.size();
+        }
+    }
+
+    ParsedTemplate parse(const std::string &content) {
+        ParsedTemplate parsed;
+        size_t pos = 0;
+        while (pos < content.size()) {
+            size_t open = content.find("${", pos);
+            if (open == std::string::npos) {
+                appendLiteral(parsed, content.substr(pos));
+                break;
+            }
+            size_t close = content.find('}', open + 2);
+            if (close == std::string::npos) {
+                appendLiteral(parsed, content.substr(pos));
+                break;
+            }
+            std::string name = content.substr(open + 2, close - open - 2);
+            if (!isVariableName(name)) {
+                // Not ours (for example a snippet placeholder), keep it verbatim
+                appendLiteral(parsed, content.substr(pos, open + 2 - pos));
+                pos = open + 2;
+                continue;
+            }
+            appendLiteral(parsed, content.substr(pos, open - pos));
+            parsed.segments.push_back({true, name});
+            pos = close + 1;
+        }
+        return parsed;
+    }
+
+    std::string render(const ParsedTemplate &parsed, const std::unordered_map<std::string, std::string> &variables) {
+        std::string rendered;
+        rendered.reserve(parsed.literal_size + 64);
+        for (const TemplateSegment &segment : parsed.segments) {
+            if (!segment.is_variable) {
+                rendered += segment.text;
+                continue;
+            }
+            auto value = variables.find(segment.text);
+            if (value != variables.end()) {
+                rendered += value->second;
+            } else {
+                rendered += "${" + segment.text + "}";
+            }
+        }
+        return rendered;
+    }
+}
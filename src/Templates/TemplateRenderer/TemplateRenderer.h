@@ -0,0 +1,25 @@
+#ifndef TEMPLATERENDERER_H
+#define TEMPLATERENDERER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TemplateSegment {
+    bool is_variable;
+    std::string text; // literal text, or the variable name without ${}
+};
+
+struct ParsedTemplate {
+    std::vector<TemplateSegment> segments;
+    size_t literal_size = 0; // used to reserve the rendered string up front
+};
+
+// Templates reference variables as ${name}, e.g. ${problem}, ${date} or
+// ${handle}. Unknown variables are rendered back as written.
+namespace TemplateRenderer {
+    ParsedTemplate parse(const std::string &content);
+    std::string render(const ParsedTemplate &parsed, const std::unordered_map<std::string, std::string> &variables);
+}
+
+#endif // TEMPLATERENDERER_H
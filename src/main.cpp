@@ -1,15 +1,35 @@
 #include <QApplication> // Core application class
 
 #include "MainWindow/MainWindow.h"
+#include "utils/LatencyWatchdog/LatencyWatchdog.h"
+#include "utils/StartupTracer/StartupTracer.h"
+#include "utils/StyleLoader/StyleReader.h"
 
 int main(int argc, char *argv[]) {
+    // Time zero of the startup report
+    StartupTracer &tracer = StartupTracer::instance();
+
     // Creates application instance
+    tracer.begin("QApplication");
     QApplication application(argc, argv);
+    tracer.end();
+
+    // One style sheet for every widget, set before any of them is created
+    tracer.begin("style sheet");
+    StyleLoader::install(application);
+    tracer.end();
 
     // Links the main window for the application
+    tracer.begin("MainWindow");
     MainWindow main_window;
+    tracer.end();
+    tracer.begin("show");
     main_window.showMaximized();
     main_window.show();
+    tracer.end();
+
+    // From here on every late event loop turn is recorded, see LatencyPanel
+    LatencyWatchdog::instance().start();
 
     // Starts the application event loop, this makes the GUI responsive.
     return application.exec();
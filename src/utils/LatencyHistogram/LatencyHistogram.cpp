@@ -0,0 +1,75 @@
+#include "LatencyHistogram.h"
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+void LatencyHistogram::record(double latency_ms) {
+    if (latency_ms < 0) {
+        latency_ms = 0;
+    }
+    counts[bucketFor(latency_ms)]++;
+    sample_count++;
+    if (latency_ms > max_ms) {
+        max_ms = latency_ms;
+    }
+}
+
+void LatencyHistogram::clear() {
+    counts.fill(0);
+    sample_count = 0;
+    max_ms = 0;
+}
+
+long long LatencyHistogram::count(int bucket) const {
+    return bucket >= 0 && bucket < BUCKET_COUNT ? counts[bucket] : 0;
+}
+
+long long LatencyHistogram::total() const {
+    return sample_count;
+}
+
+double LatencyHistogram::maxMs() const {
+    return max_ms;
+}
+
+double LatencyHistogram::percentileMs(double fraction) const {
+    if (sample_count == 0) {
+        return 0;
+    }
+    long long wanted = static_cast<long long>(std::ceil(fraction * sample_count));
+    long long seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT - 1; bucket++) {
+        seen += counts[bucket];
+        if (seen >= wanted) {
+            // Never report more than was actually seen
+            return std::fmin(bucketLowerMs(bucket + 1), max_ms);
+        }
+    }
+    return max_ms;
+}
+
+int LatencyHistogram::bucketFor(double latency_ms) {
+    int bucket = 0;
+    // Bucket b > 0 covers [2^(b-1), 2^b) ms
+    while (bucket < BUCKET_COUNT - 1 && latency_ms >= bucketLowerMs(bucket + 1)) {
+        bucket++;
+    }
+    return bucket;
+}
+
+double LatencyHistogram::bucketLowerMs(int bucket) {
+    return bucket <= 0 ? 0 : std::ldexp(1.0, bucket - 1);
+}
+
+std::string LatencyHistogram::bucketLabel(int bucket) {
+    if (bucket <= 0) {
+        return "<1 ms";
+    }
+    std::string lower = std::to_string(static_cast<long long>(bucketLowerMs(bucket)));
+    if (bucket >= BUCKET_COUNT - 1) {
+        return lower + "+ ms";
+    }
+    return lower + "-" + std::to_string(static_cast<long long>(bucketLowerMs(bucket + 1))) + " ms";
+}
@@ -0,0 +1,34 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <array>
+#include <string>
+
+// Event loop delays counted in power-of-two millisecond buckets: under 1 ms,
+// 1-2 ms, 2-4 ms and so on, the last one open-ended. Fixed size, so a
+// recording is a few arithmetic operations however long the app runs.
+class LatencyHistogram {
+  public:
+    static constexpr int BUCKET_COUNT = 13; // the last bucket starts at 2048 ms
+
+    LatencyHistogram();
+    void record(double latency_ms);
+    void clear();
+
+    long long count(int bucket) const;
+    long long total() const;
+    double maxMs() const;
+    // Upper bound of the bucket holding the given fraction of samples, 0 when empty
+    double percentileMs(double fraction) const;
+
+    static int bucketFor(double latency_ms);
+    static double bucketLowerMs(int bucket);
+    static std::string bucketLabel(int bucket); // e.g. "4-8 ms", "2048+ ms"
+
+  private:
+    std::array<long long, BUCKET_COUNT> counts;
+    long long sample_count;
+    double max_ms;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,207 @@
+#include "LatencyWatchdog.h"
+#include <QCoreApplication>
+#include <chrono>
+#include <iostream>
+
+#if defined(__linux__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+#if defined(__linux__)
+namespace {
+    constexpr int MAX_FRAMES = 64;
+    constexpr int SIGNAL_FRAMES = 2; // the handler and the kernel's signal trampoline
+    constexpr int CAPTURE_TIMEOUT_MS = 100;
+    constexpr int STACK_SIGNAL = SIGUSR2; // SIGPROF belongs to profilers
+
+    // The GUI thread writes its own stack here from a signal handler, the
+    // watcher waits for frame_count to become non-negative
+    void *captured_frames[MAX_FRAMES];
+    std::atomic<int> frame_count{-1};
+    pthread_t gui_thread;
+
+    void onStackSignal(int) {
+        frame_count.store(backtrace(captured_frames, MAX_FRAMES));
+    }
+
+    // "binary(_ZN3Foo3barEv+0x1c) [0x...]" -> "Foo::bar() +0x1c  (binary)"
+    QString describeFrame(const char *symbol) {
+        const char *open = std::strchr(symbol, '(');
+        const char *plus = open ? std::strchr(open, '+') : nullptr;
+        const char *close = plus ? std::strchr(plus, ')') : nullptr;
+        if (!close || plus == open + 1) {
+            return QString::fromLocal8Bit(symbol);
+        }
+        std::string mangled(open + 1, plus);
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+        QString name = QString::fromStdString(status == 0 && demangled ? std::string(demangled) : mangled);
+        std::free(demangled);
+        return name + " " + QString::fromLatin1(plus, close - plus) + "  (" + QString::fromLocal8Bit(symbol, open - symbol) + ")";
+    }
+}
+#endif
+
+LatencyWatchdog &LatencyWatchdog::instance() {
+    static LatencyWatchdog instance;
+    return instance;
+}
+
+LatencyWatchdog::LatencyWatchdog()
+    : heartbeat(new QTimer(this)), previous_beat_ms(0), stall_total(0), stopping(false), last_beat_ms(0), beat_count(0), stall_beat(0) {
+    heartbeat->setInterval(HEARTBEAT_MS);
+    heartbeat->setTimerType(Qt::PreciseTimer);
+    connect(heartbeat, &QTimer::timeout, this, &LatencyWatchdog::onHeartbeat);
+}
+
+LatencyWatchdog::~LatencyWatchdog() {
+    stop();
+}
+
+void LatencyWatchdog::start() {
+    if (isRunning()) {
+        return;
+    }
+#if defined(__linux__)
+    gui_thread = pthread_self();
+    // The first backtrace() loads libgcc's unwinder, which must not happen inside the handler
+    void *warm_up[1];
+    backtrace(warm_up, 1);
+    struct sigaction action = {};
+    action.sa_handler = onStackSignal;
+    action.sa_flags = SA_RESTART; // a blocked read or wait carries on after the sample
+    sigemptyset(&action.sa_mask);
+    sigaction(STACK_SIGNAL, &action, nullptr);
+#endif
+    clock.start();
+    previous_beat_ms = 0;
+    last_beat_ms.store(0);
+    stopping = false;
+    heartbeat->start();
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &LatencyWatchdog::stop, Qt::UniqueConnection);
+    watcher = std::thread(&LatencyWatchdog::watch, this);
+}
+
+void LatencyWatchdog::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    heartbeat->stop();
+    {
+        std::lock_guard<std::mutex> lock(watcher_mutex);
+        stopping = true;
+    }
+    watcher_wake.notify_all();
+    watcher.join();
+}
+
+bool LatencyWatchdog::isRunning() const {
+    return watcher.joinable();
+}
+
+void LatencyWatchdog::clear() {
+    latency.clear();
+    recent_stalls.clear();
+    stall_total = 0;
+}
+
+const LatencyHistogram &LatencyWatchdog::histogram() const {
+    return latency;
+}
+
+const std::deque<StallReport> &LatencyWatchdog::stalls() const {
+    return recent_stalls;
+}
+
+quint64 LatencyWatchdog::stallTotal() const {
+    return stall_total;
+}
+
+// A tick due every HEARTBEAT_MS; anything beyond that is time the event loop
+// spent on something else
+void LatencyWatchdog::onHeartbeat() {
+    qint64 now_ms = clock.elapsed();
+    qint64 gap_ms = now_ms - previous_beat_ms;
+    previous_beat_ms = now_ms;
+    latency.record(static_cast<double>(gap_ms - HEARTBEAT_MS));
+
+    QStringList frames;
+    {
+        std::lock_guard<std::mutex> lock(watcher_mutex);
+        if (stall_beat == beat_count.load()) {
+            frames.swap(stall_frames);
+        }
+        last_beat_ms.store(now_ms);
+        beat_count++;
+    }
+    if (gap_ms - HEARTBEAT_MS < STALL_THRESHOLD_MS) {
+        return;
+    }
+
+    StallReport report{QDateTime::currentDateTime().addMSecs(-gap_ms), gap_ms - HEARTBEAT_MS, frames};
+    std::cerr << "LatencyWatchdog: event loop blocked for " << report.duration_ms << " ms" << std::endl;
+    for (const QString &frame : report.frames) {
+        std::cerr << "    " << frame.toStdString() << std::endl;
+    }
+    recent_stalls.push_back(report);
+    stall_total++;
+    if (recent_stalls.size() > static_cast<size_t>(MAX_STALLS)) {
+        recent_stalls.pop_front();
+    }
+    emit stallDetected(report);
+}
+
+// Watcher thread: samples the GUI stack once per stall, when the heartbeat
+// is STALL_THRESHOLD_MS late
+void LatencyWatchdog::watch() {
+    std::unique_lock<std::mutex> lock(watcher_mutex);
+    quint64 sampled_beat = 0;
+    bool sampled = false;
+    while (!watcher_wake.wait_for(lock, std::chrono::milliseconds(WATCH_INTERVAL_MS), [this]() { return stopping; })) {
+        quint64 beat = beat_count.load();
+        qint64 overdue_ms = clock.elapsed() - last_beat_ms.load() - HEARTBEAT_MS;
+        if (overdue_ms < STALL_THRESHOLD_MS || (sampled && sampled_beat == beat)) {
+            continue;
+        }
+        sampled = true;
+        sampled_beat = beat;
+        // Captured without the lock, the GUI thread may be waiting for it
+        lock.unlock();
+        QStringList frames = captureGuiStack();
+        lock.lock();
+        stall_frames = frames;
+        stall_beat = beat;
+    }
+}
+
+QStringList LatencyWatchdog::captureGuiStack() {
+    QStringList frames;
+#if defined(__linux__)
+    frame_count.store(-1);
+    if (pthread_kill(gui_thread, STACK_SIGNAL) != 0) {
+        return frames;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CAPTURE_TIMEOUT_MS);
+    while (frame_count.load() < 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    int count = frame_count.load();
+    if (count <= SIGNAL_FRAMES) {
+        return frames;
+    }
+    char **symbols = backtrace_symbols(captured_frames + SIGNAL_FRAMES, count - SIGNAL_FRAMES);
+    if (!symbols) {
+        return frames;
+    }
+    for (int i = 0; i < count - SIGNAL_FRAMES; i++) {
+        frames << describeFrame(symbols[i]);
+    }
+    std::free(symbols);
+#endif
+    return frames;
+}
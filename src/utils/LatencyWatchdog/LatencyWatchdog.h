@@ -0,0 +1,78 @@
+#ifndef LATENCYWATCHDOG_H
+#define LATENCYWATCHDOG_H
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "../LatencyHistogram/LatencyHistogram.h"
+
+// One time the GUI thread did not get back to its event loop in time
+struct StallReport {
+    QDateTime started_at;
+    qint64 duration_ms;
+    QStringList frames; // GUI thread stack taken while it was blocked, innermost first; empty if unavailable
+};
+
+// Measures how late the GUI thread's event loop runs. A heartbeat timer on
+// the GUI thread records how far behind schedule each tick fires; a watchdog
+// thread checks the heartbeat and, once it is STALL_THRESHOLD_MS overdue,
+// samples the GUI thread's stack so the stall can be traced to the call that
+// blocked. The report is logged and kept when the event loop comes back.
+// Stacks are captured on Linux only; elsewhere stalls are reported without.
+class LatencyWatchdog : public QObject {
+    Q_OBJECT
+
+  public:
+    static LatencyWatchdog &instance(); // Global access to the singleton
+
+    void start(); // from the GUI thread
+    void stop();
+    bool isRunning() const;
+    void clear();
+
+    // GUI thread only
+    const LatencyHistogram &histogram() const;
+    const std::deque<StallReport> &stalls() const; // oldest first, the last MAX_STALLS
+    quint64 stallTotal() const;                    // every stall since start or clear
+
+    static constexpr int HEARTBEAT_MS = 50;
+    static constexpr int STALL_THRESHOLD_MS = 200;
+
+  signals:
+    void stallDetected(const StallReport &report);
+
+  private:
+    LatencyWatchdog();
+    ~LatencyWatchdog();
+    void onHeartbeat();
+    void watch();
+    static QStringList captureGuiStack();
+
+    QTimer *heartbeat;
+    QElapsedTimer clock;
+    qint64 previous_beat_ms;
+    LatencyHistogram latency;
+    std::deque<StallReport> recent_stalls;
+    quint64 stall_total;
+
+    std::thread watcher;
+    std::mutex watcher_mutex;
+    std::condition_variable watcher_wake;
+    bool stopping;
+    std::atomic<qint64> last_beat_ms; // read by the watcher
+    std::atomic<quint64> beat_count;
+    QStringList stall_frames;         // guarded by watcher_mutex, taken by the next heartbeat
+    quint64 stall_beat;               // beat the frames were captured after
+
+    static constexpr int WATCH_INTERVAL_MS = 20;
+    static constexpr int MAX_STALLS = 50;
+};
+
+#endif // LATENCYWATCHDOG_H
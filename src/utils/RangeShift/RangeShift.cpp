@@ -0,0 +1,30 @@
+#include "RangeShift.h"
+#include <algorithm>
+
+namespace RangeShift {
+    void forInsert(size_t &start, size_t &length, size_t position, size_t inserted, bool grow_at_edges) {
+        size_t end = start + length;
+        bool inside = position > start && position < end;
+        bool at_edge = position == start || position == end;
+        if (inside || (at_edge && grow_at_edges)) {
+            length += inserted;
+        } else if (position <= start) {
+            start += inserted;
+        }
+    }
+
+    void forDelete(size_t &start, size_t &length, size_t position, size_t deleted) {
+        size_t end = start + length;
+        size_t deleted_end = position + deleted;
+        if (end <= position) {
+            return;
+        }
+        if (start >= deleted_end) {
+            start -= deleted;
+            return;
+        }
+        size_t overlap = std::min(end, deleted_end) - std::max(start, position);
+        start = std::min(start, position);
+        length -= overlap;
+    }
+}
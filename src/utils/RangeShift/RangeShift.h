@@ -0,0 +1,17 @@
+#ifndef RANGESHIFT_H
+#define RANGESHIFT_H
+
+#include <cstddef>
+
+// Keeps a range of a text buffer, start and length in bytes, on the same
+// characters while the text around it is edited. Shared by snippet tab
+// stops and diagnostic ranges, which both outlive many keystrokes.
+namespace RangeShift {
+    // Text inserted strictly inside the range extends it, text before it
+    // moves it. At either edge it extends the range only if grow_at_edges.
+    void forInsert(size_t &start, size_t &length, size_t position, size_t inserted, bool grow_at_edges);
+    // Deleted text overlapping the range shrinks it, text before it moves it
+    void forDelete(size_t &start, size_t &length, size_t position, size_t deleted);
+}
+
+#endif // RANGESHIFT_H
@@ -0,0 +1,109 @@
+#include "StartupTracer.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+StartupTracer &StartupTracer::instance() {
+    static StartupTracer instance([start = std::chrono::steady_clock::now()]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    });
+    return instance;
+}
+
+StartupTracer::StartupTracer(std::function<double()> now_ms) : now_ms(std::move(now_ms)), finished(false) {}
+
+void StartupTracer::begin(const std::string &name) {
+    if (finished) {
+        return;
+    }
+    open_phases.push_back(recorded.size());
+    recorded.push_back({name, static_cast<int>(open_phases.size()) - 1, now_ms(), 0.0});
+}
+
+void StartupTracer::end() {
+    if (finished || open_phases.empty()) {
+        return;
+    }
+    StartupPhase &phase = recorded[open_phases.back()];
+    phase.duration_ms = now_ms() - phase.start_ms;
+    open_phases.pop_back();
+}
+
+void StartupTracer::mark(const std::string &name, double goal_ms) {
+    if (finished) {
+        return;
+    }
+    recorded.push_back({name, static_cast<int>(open_phases.size()), now_ms(), -1.0, goal_ms});
+}
+
+void StartupTracer::defer(const std::string &name, std::function<void()> task) {
+    if (finished) {
+        task();
+        return;
+    }
+    deferred.push_back({name, std::move(task)});
+}
+
+bool StartupTracer::runNextDeferred() {
+    if (deferred.empty()) {
+        finished = true;
+        return false;
+    }
+    // Popped first, a task may defer more work behind the others
+    DeferredTask next = std::move(deferred.front());
+    deferred.pop_front();
+    {
+        Scope scope("deferred: " + next.name, *this);
+        next.task();
+    }
+    return true;
+}
+
+bool StartupTracer::isFinished() const {
+    return finished;
+}
+
+bool StartupTracer::missedGoal() const {
+    for (const StartupPhase &phase : recorded) {
+        if (phase.goal_ms > 0 && phase.start_ms > phase.goal_ms) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<StartupPhase> &StartupTracer::phases() const {
+    return recorded;
+}
+
+std::string StartupTracer::report() const {
+    std::string text = "phase                                      start ms   duration ms\n";
+    char line[160];
+    for (const StartupPhase &phase : recorded) {
+        std::string name = std::string(phase.depth * 2, ' ') + phase.name;
+        if (phase.duration_ms < 0 && phase.goal_ms > 0) {
+            std::snprintf(line, sizeof(line), "%-40s %10.1f   goal %.0f ms, %s\n", name.c_str(), phase.start_ms, phase.goal_ms,
+                          phase.start_ms > phase.goal_ms ? "MISSED" : "met");
+        } else if (phase.duration_ms < 0) {
+            std::snprintf(line, sizeof(line), "%-40s %10.1f\n", name.c_str(), phase.start_ms);
+        } else {
+            std::snprintf(line, sizeof(line), "%-40s %10.1f %13.1f\n", name.c_str(), phase.start_ms, phase.duration_ms);
+        }
+        text += line;
+    }
+    return text;
+}
+
+bool StartupTracer::writeReport(const std::string &file_path) const {
+    std::ofstream out(file_path, std::ios::trunc);
+    out << report();
+    return static_cast<bool>(out);
+}
+
+StartupTracer::Scope::Scope(const std::string &name, StartupTracer &tracer) : tracer(tracer) {
+    tracer.begin(name);
+}
+
+StartupTracer::Scope::~Scope() {
+    tracer.end();
+}
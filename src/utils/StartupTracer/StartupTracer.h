@@ -0,0 +1,68 @@
+#ifndef STARTUPTRACER_H
+#define STARTUPTRACER_H
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct StartupPhase {
+    std::string name;
+    int depth;          // nesting level, 0 for top-level phases
+    double start_ms;    // since the tracer was created
+    double duration_ms; // negative for instant marks such as the first paint
+    double goal_ms = 0; // latest acceptable start of a mark, 0 when it has none
+};
+
+// Times the phases of startup and holds the work that can wait until the
+// window has been painted once. Phases nest: begin()/end() pairs, usually
+// through a Scope, inside other phases are reported indented. Deferred tasks
+// are traced too, so the report covers everything up to the moment startup
+// is over. GUI thread only.
+class StartupTracer {
+  public:
+    static StartupTracer &instance(); // Global access to the singleton, its creation is time zero
+
+    explicit StartupTracer(std::function<double()> now_ms);
+
+    void begin(const std::string &name);
+    void end();
+    void mark(const std::string &name, double goal_ms = 0);
+
+    // Queues task for after the first paint, or runs it right away once startup is over
+    void defer(const std::string &name, std::function<void()> task);
+    // Runs the oldest deferred task; false when none is left, which ends startup
+    bool runNextDeferred();
+    bool isFinished() const;
+    // True if a mark came later than its goal
+    bool missedGoal() const;
+
+    const std::vector<StartupPhase> &phases() const;
+    std::string report() const;
+    bool writeReport(const std::string &file_path) const;
+
+    class Scope {
+      public:
+        explicit Scope(const std::string &name, StartupTracer &tracer = StartupTracer::instance());
+        ~Scope();
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        StartupTracer &tracer;
+    };
+
+  private:
+    struct DeferredTask {
+        std::string name;
+        std::function<void()> task;
+    };
+
+    std::function<double()> now_ms;
+    std::vector<StartupPhase> recorded;
+    std::vector<size_t> open_phases; // indexes into recorded
+    std::deque<DeferredTask> deferred;
+    bool finished;
+};
+
+#endif // STARTUPTRACER_H
@@ -1,4 +1,6 @@
 #include "StyleReader.h"
+#include <QDirIterator>
+#include <QFileSystemWatcher>
 
 QString StyleLoader::read(const QString &filePath) {
     QFile file(filePath);
@@ -10,3 +12,44 @@ QString StyleLoader::read(const QString &filePath) {
     }
     return QString(); // Return an empty string if the file cannot be read
 }
+
+// Paths relative to the resource directory, which mirror those under src/
+QStringList StyleLoader::styleFiles() {
+    QStringList files;
+    QDirIterator resources(RESOURCE_DIR, {"*.qss"}, QDir::Files, QDirIterator::Subdirectories);
+    while (resources.hasNext()) {
+        files << resources.next().mid(QString(RESOURCE_DIR).size() + 1);
+    }
+    // Later rules win between equally specific selectors, keep the order stable
+    files.sort();
+    return files;
+}
+
+QString StyleLoader::applicationStyleSheet(const QString &base_dir) {
+    QString styleSheet;
+    for (const QString &file : styleFiles()) {
+        styleSheet += "/* " + file + " */\n" + read(base_dir + "/" + file) + "\n";
+    }
+    return styleSheet;
+}
+
+void StyleLoader::install(QApplication &application) {
+#ifdef KODETRON_STYLE_SOURCE_DIR
+    const QString source_dir = QStringLiteral(KODETRON_STYLE_SOURCE_DIR);
+    application.setStyleSheet(applicationStyleSheet(source_dir));
+
+    QFileSystemWatcher *watcher = new QFileSystemWatcher(&application);
+    for (const QString &file : styleFiles()) {
+        watcher->addPath(source_dir + "/" + file);
+    }
+    QObject::connect(watcher, &QFileSystemWatcher::fileChanged, &application, [&application, watcher, source_dir](const QString &path) {
+        // Editors that save by renaming drop the watched file, watch the new one
+        if (!watcher->files().contains(path) && QFile::exists(path)) {
+            watcher->addPath(path);
+        }
+        application.setStyleSheet(applicationStyleSheet(source_dir));
+    });
+#else
+    application.setStyleSheet(applicationStyleSheet(RESOURCE_DIR));
+#endif
+}
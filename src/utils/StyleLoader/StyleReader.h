@@ -1,6 +1,7 @@
 #ifndef STYLE_LOADER_H
 #define STYLE_LOADER_H
 
+#include <QApplication>
 #include <QString>
 #include <QFile>
 #include <QTextStream>
@@ -8,6 +9,18 @@
 class StyleLoader {
   public:
     static QString read(const QString &filePath);
+
+    // Applies every style sheet listed in styles.qrc to the whole application
+    // as one sheet, so it is parsed once and widgets are polished once. Builds
+    // with KODETRON_STYLE_HOT_RELOAD read the files from the source tree
+    // instead and apply them again whenever one is saved.
+    static void install(QApplication &application);
+
+  private:
+    static QStringList styleFiles();
+    static QString applicationStyleSheet(const QString &base_dir);
+
+    static constexpr const char *RESOURCE_DIR = ":/styles";
 };
 
 #endif // STYLE_LOADER_H
@@ -0,0 +1,153 @@
+#include "LatencyPanel.h"
+#include <QHeaderView>
+#include <algorithm>
+
+LatencyPanel::LatencyPanel(QWidget *parent) : QDialog(parent), shown_stall_total(0) {
+    setWindowTitle("Event Loop Latency");
+    resize(700, 600);
+
+    summary_label = new QLabel(this);
+
+    // One row per bucket, the bar scaled to the fullest one
+    histogram_tree = new QTreeWidget(this);
+    histogram_tree->setColumnCount(3);
+    histogram_tree->setHeaderLabels({"Delay", "Heartbeats", ""});
+    histogram_tree->setRootIsDecorated(false);
+    histogram_tree->setUniformRowHeights(true);
+    histogram_tree->setSelectionMode(QAbstractItemView::NoSelection);
+    for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        QTreeWidgetItem *item = new QTreeWidgetItem(histogram_tree);
+        item->setText(0, QString::fromStdString(LatencyHistogram::bucketLabel(bucket)));
+        item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    stalls_label = new QLabel(this);
+    stalls_list = new QListWidget(this);
+    connect(stalls_list, &QListWidget::currentRowChanged, this, &LatencyPanel::onStallSelected);
+
+    stack_view = new QPlainTextEdit(this);
+    stack_view->setReadOnly(true);
+    stack_view->setLineWrapMode(QPlainTextEdit::NoWrap);
+    stack_view->setPlaceholderText("Select a stall to see where the GUI thread was blocked");
+
+    reset_button = new QPushButton("Reset", this);
+    connect(reset_button, &QPushButton::clicked, this, &LatencyPanel::onReset);
+    footer_layout = new QHBoxLayout();
+    footer_layout->addStretch(1);
+    footer_layout->addWidget(reset_button);
+
+    layout = new QVBoxLayout(this);
+    layout->addWidget(summary_label);
+    layout->addWidget(histogram_tree, 2);
+    layout->addWidget(stalls_label);
+    layout->addWidget(stalls_list, 1);
+    layout->addWidget(stack_view, 2);
+    layout->addLayout(footer_layout);
+    setLayout(layout);
+
+    refresh_timer = new QTimer(this);
+    refresh_timer->setInterval(REFRESH_MS);
+    connect(refresh_timer, &QTimer::timeout, this, &LatencyPanel::refresh);
+    connect(&LatencyWatchdog::instance(), &LatencyWatchdog::stallDetected, this, &LatencyPanel::refresh);
+
+    assignObjectNames();
+    applyQtStyles();
+}
+
+void LatencyPanel::assignObjectNames() {
+    setObjectName("latency_panel");
+    histogram_tree->setObjectName("latency_histogram_tree");
+    stalls_list->setObjectName("latency_stalls_list");
+    stack_view->setObjectName("latency_stack_view");
+}
+
+void LatencyPanel::applyQtStyles() {
+    layout->setContentsMargins(10, 10, 10, 10);
+    layout->setSpacing(10);
+    histogram_tree->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    histogram_tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    stack_view->setFont(QFont("Monospace"));
+}
+
+void LatencyPanel::showEvent(QShowEvent *event) {
+    refresh();
+    refresh_timer->start();
+    QDialog::showEvent(event);
+}
+
+void LatencyPanel::hideEvent(QHideEvent *event) {
+    refresh_timer->stop();
+    QDialog::hideEvent(event);
+}
+
+void LatencyPanel::refresh() {
+    const LatencyWatchdog &watchdog = LatencyWatchdog::instance();
+    const LatencyHistogram &histogram = watchdog.histogram();
+    if (!watchdog.isRunning()) {
+        summary_label->setText("The latency watchdog is not running");
+    } else {
+        summary_label->setText(QString("%1 heartbeats every %2 ms    p50 < %3 ms    p99 < %4 ms    max %5 ms")
+                                   .arg(histogram.total())
+                                   .arg(LatencyWatchdog::HEARTBEAT_MS)
+                                   .arg(histogram.percentileMs(0.5))
+                                   .arg(histogram.percentileMs(0.99))
+                                   .arg(histogram.maxMs()));
+    }
+
+    long long fullest = 1;
+    for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        fullest = std::max(fullest, histogram.count(bucket));
+    }
+    for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        long long count = histogram.count(bucket);
+        QTreeWidgetItem *item = histogram_tree->topLevelItem(bucket);
+        item->setText(1, QString::number(count));
+        // At least one block for any non-empty bucket, rare long delays are the point
+        int width = count == 0 ? 0 : std::max(1, static_cast<int>(count * BAR_WIDTH / fullest));
+        item->setText(2, QString(width, QChar(0x2588)));
+    }
+
+    // Rebuilt only when a stall came in, so the selection stays put between refreshes
+    const std::deque<StallReport> &stalls = watchdog.stalls();
+    stalls_label->setText(QString("Stalls over %1 ms: %2").arg(LatencyWatchdog::STALL_THRESHOLD_MS).arg(watchdog.stallTotal()));
+    if (shown_stall_total == watchdog.stallTotal()) {
+        return;
+    }
+    shown_stall_total = watchdog.stallTotal();
+    stalls_list->clear();
+    for (const StallReport &stall : stalls) {
+        QString culprit = culpritFrame(stall.frames);
+        stalls_list->addItem(QString("%1    %2 ms    %3")
+                                 .arg(stall.started_at.toString("HH:mm:ss"))
+                                 .arg(stall.duration_ms)
+                                 .arg(culprit.isEmpty() ? "no stack" : culprit));
+    }
+    stalls_list->scrollToBottom();
+}
+
+void LatencyPanel::onStallSelected(int row) {
+    const std::deque<StallReport> &stalls = LatencyWatchdog::instance().stalls();
+    if (row < 0 || row >= static_cast<int>(stalls.size())) {
+        stack_view->clear();
+        return;
+    }
+    const StallReport &stall = stalls[row];
+    stack_view->setPlainText(stall.frames.isEmpty() ? "No stack was captured for this stall" : stall.frames.join('\n'));
+}
+
+void LatencyPanel::onReset() {
+    LatencyWatchdog::instance().clear();
+    refresh();
+}
+
+// The innermost frame in Kodetron's own code rather than in libc or Qt is
+// usually the call that blocked
+QString LatencyPanel::culpritFrame(const QStringList &frames) {
+    for (const QString &frame : frames) {
+        int module_start = frame.lastIndexOf("  (");
+        if (module_start >= 0 && !frame.mid(module_start).contains(".so")) {
+            return frame.left(module_start);
+        }
+    }
+    return frames.isEmpty() ? QString() : frames.first();
+}
@@ -0,0 +1,53 @@
+#ifndef LATENCYPANEL_H
+#define LATENCYPANEL_H
+
+#include <QDialog>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QListWidget>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+#include "../../../utils/LatencyWatchdog/LatencyWatchdog.h"
+
+// Event loop latency as LatencyWatchdog sees it: the histogram of heartbeat
+// delays and the recent stalls, each with the GUI thread stack taken while
+// it was blocked. Refreshed while shown.
+class LatencyPanel : public QDialog {
+    Q_OBJECT
+
+  public:
+    explicit LatencyPanel(QWidget *parent = nullptr);
+    void assignObjectNames();
+    void applyQtStyles();
+
+  protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+  private slots:
+    void refresh();
+    void onStallSelected(int row);
+    void onReset();
+
+  private:
+    static QString culpritFrame(const QStringList &frames);
+
+    QVBoxLayout *layout;
+    QHBoxLayout *footer_layout;
+    QLabel *summary_label;
+    QTreeWidget *histogram_tree;
+    QLabel *stalls_label;
+    QListWidget *stalls_list;
+    QPlainTextEdit *stack_view;
+    QPushButton *reset_button;
+    QTimer *refresh_timer;
+    quint64 shown_stall_total; // stalls listed at the last refresh
+
+    static constexpr int REFRESH_MS = 500;
+    static constexpr int BAR_WIDTH = 40; // characters for the fullest bucket
+};
+
+#endif // LATENCYPANEL_H
@@ -1,5 +1,4 @@
 #include "EditorSection.h"
-#include "../utils/StyleLoader/StyleReader.h"
 
 EditorSection::EditorSection(QWidget *parent) : QWidget(parent) {
     // Childs initialization
@@ -14,19 +13,12 @@ EditorSection::EditorSection(QWidget *parent) : QWidget(parent) {
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void EditorSection::assignObjectNames() {
     setObjectName("editor_section");
+    code_editor->setObjectName("code_editor");
 }
 void EditorSection::applyQtStyles() {
     layout->setContentsMargins(10, 10, 10, 10);
     layout->setSpacing(20);
-    code_editor->setStyleSheet("border: none;");
-}
-void EditorSection::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/Editor/EditorSection/EditorSection.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
 }
@@ -12,7 +12,6 @@ class EditorSection : public QWidget {
     explicit EditorSection(QWidget *parent = nullptr);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
     KodetronEditor* getCodeEditor() const { return code_editor; }
 
   private:
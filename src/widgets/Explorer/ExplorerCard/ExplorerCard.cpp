@@ -1,62 +1,89 @@
 #include "ExplorerCard.h"
+#include "../../../FileSystemOperations/IconCache/IconCache.h"
 #include "../../../Global/AppState.h"
-#include "../../../utils/StyleLoader/StyleReader.h"
+#include <QDir>
 
-ExplorerCard::ExplorerCard(QWidget *parent) : QWidget(parent) {
+ExplorerCard::ExplorerCard(DatabaseWorker *database, QWidget *parent) : QWidget(parent), database(database) {
     // Models initialization
-    file_system_model = new QFileSystemModel();
+    explorer_model = new ExplorerTreeModel(this);
     single_file_model = new QStandardItemModel();
     
     // Tree initialization
     tree_view = new QTreeView();
 
+    // Filter bar, shown while a folder is open
+    filter_bar = new QWidget(this);
+    filter_edit = new QLineEdit(filter_bar);
+    filter_edit->setPlaceholderText("*.cpp, *.in, *.out");
+    filter_edit->setToolTip("File name patterns, separated by commas");
+    group_problems_checkbox = new QCheckBox("Group by problem", filter_bar);
+    group_problems_checkbox->setToolTip("List A1.in, A1.out, ... under A.cpp");
+    filter_layout = new QHBoxLayout(filter_bar);
+    filter_layout->addWidget(filter_edit, 1);
+    filter_layout->addWidget(group_problems_checkbox);
+    filter_bar->setLayout(filter_layout);
+    filter_bar->hide();
+    connect(filter_edit, &QLineEdit::editingFinished, this, &ExplorerCard::onFilterEdited);
+    connect(group_problems_checkbox, &QCheckBox::toggled, this, &ExplorerCard::onGroupProblemsToggled);
+
     // Subscribe to the AppState signal to update the tree view when the selected path changes
     connect(&AppState::instance(), &AppState::selectedExplorerPathModified, this, &ExplorerCard::onSelectedExplorerPathModified);
     connect(tree_view, &QTreeView::clicked, this, &ExplorerCard::onTreeViewItemClicked);
+
+    // External changes patch the tree in place instead of rebuilding it
+    connect(&DirectoryWatcher::instance(), &DirectoryWatcher::changesReady, explorer_model, &ExplorerTreeModel::applyChanges);
+    connect(&DirectoryWatcher::instance(), &DirectoryWatcher::resyncRequired, explorer_model, &ExplorerTreeModel::resync);
+    connect(&DirectoryWatcher::instance(), &DirectoryWatcher::rootRemoved, this, &ExplorerCard::onRootRemoved);
     
     // Layout
     layout = new QVBoxLayout();
+    layout->addWidget(filter_bar);
     layout->addWidget(tree_view);
     setLayout(layout);
 
     // Styles
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 
 void ExplorerCard::renderDir(const QString &dir_path) {
-    QModelIndex index = file_system_model->index(dir_path);
-    if (index.isValid()) {
-        file_system_model->setNameFilters(QStringList() << "*.cpp");
-        file_system_model->setNameFilterDisables(false);
-        tree_view->setModel(file_system_model);
-        file_system_model->setRootPath(dir_path);
-        tree_view->setRootIndex(file_system_model->index(dir_path));
-
-        for (int i = 1; i < file_system_model->columnCount(); ++i) {
-            tree_view->hideColumn(i);
-        }
+    if (QFileInfo(dir_path).isDir()) {
+        // Both reach subscribers as one change-set
         AppState::instance().setSelectedFilePath(QString());
         AppState::instance().setSelectedDirPath(dir_path);
+
+        // Each folder remembers its own filter; the tree is built once it is read
+        database->fetchExplorerFilter(dir_path.toStdString()).then(this, [this, dir_path](std::optional<ExplorerFilterSetting> stored) {
+            if (AppState::instance().getSelectedDirPath() != dir_path) {
+                return;
+            }
+            ExplorerFilterSetting setting = stored.value_or(ExplorerFilterSetting{ExplorerFilter::defaultSpec(), false});
+            filter_edit->setText(QString::fromStdString(setting.patterns));
+            group_problems_checkbox->blockSignals(true);
+            group_problems_checkbox->setChecked(setting.group_problems);
+            group_problems_checkbox->blockSignals(false);
+            filter_bar->show();
+
+            explorer_model->setRootPath(dir_path);
+            explorer_model->setFilter(ExplorerFilter::compile(setting.patterns));
+            explorer_model->setGroupProblems(setting.group_problems);
+            tree_view->setModel(explorer_model);
+            tree_view->setRootIndex(QModelIndex());
+        });
     }
 }
 void ExplorerCard::renderFile(const QString &file_path) {
     QFileInfo file_info(file_path);
-    QFileIconProvider icon_provider;
-    
-    QStandardItem *item = new QStandardItem(icon_provider.icon(file_info), file_info.fileName());
+    QStandardItem *item = new QStandardItem(IconCache::instance().fileIcon(file_info.fileName()), file_info.fileName());
     item->setData(file_path, Qt::UserRole);
     item->setFlags(item->flags() & ~Qt::ItemIsEditable);
 
+    filter_bar->hide();
     single_file_model->clear();
     single_file_model->appendRow(item);
     tree_view->setModel(single_file_model);
     tree_view->expandAll();
 
-    for (int i = 1; i < file_system_model->columnCount(); ++i) {
-        tree_view->hideColumn(i);
-    }
     AppState::instance().setSelectedFilePath(file_path);
     AppState::instance().setSelectedDirPath(QString());
 }
@@ -66,8 +93,8 @@ void ExplorerCard::onTreeViewItemClicked(const QModelIndex &index) {
     // Try to get file path from Qt::UserRole first (single_file_model)
     file_path = index.data(Qt::UserRole).toString();
     if (file_path.isEmpty()) {
-        // If not present, try to get file path from QFileSystemModel (column 0)
-        file_path = file_system_model->filePath(index);
+        // If not present, ask the explorer model for it
+        file_path = explorer_model->filePath(index);
     }
     if (!file_path.isEmpty()) {
         QFileInfo info(file_path);
@@ -77,21 +104,50 @@ void ExplorerCard::onTreeViewItemClicked(const QModelIndex &index) {
     }
 }
 
-void ExplorerCard::onSelectedExplorerPathModified(const QString &new_path, const std::string &path_type) {  
-    if (path_type == AppState::instance().enumExplorerPathType.dir_type) {
+void ExplorerCard::onFilterEdited() {
+    std::string patterns = filter_edit->text().toStdString();
+    if (patterns == explorer_model->filter().spec()) {
+        return;
+    }
+    explorer_model->setFilter(ExplorerFilter::compile(patterns));
+    saveFilter();
+}
+
+void ExplorerCard::onGroupProblemsToggled(bool checked) {
+    explorer_model->setGroupProblems(checked);
+    saveFilter();
+}
+
+void ExplorerCard::saveFilter() {
+    if (!explorer_model->rootPath().isEmpty()) {
+        database->saveExplorerFilter(explorer_model->rootPath().toStdString(), ExplorerFilterSetting{filter_edit->text().toStdString(), group_problems_checkbox->isChecked()});
+    }
+}
+
+void ExplorerCard::onSelectedExplorerPathModified(const QString &new_path, ExplorerPathType path_type) {
+    if (path_type == ExplorerPathType::Dir) {
         renderDir(new_path);
-    } 
-    if (path_type == AppState::instance().enumExplorerPathType.file_type) {
+    }
+    if (path_type == ExplorerPathType::File) {
         renderFile(new_path);
     }
+    if (path_type == ExplorerPathType::Empty) {
+        filter_bar->hide();
+        tree_view->setModel(nullptr);
+    }
+}
+
+// The open folder was deleted or renamed behind our back, close it
+void ExplorerCard::onRootRemoved(const QString &root_path) {
+    if (QDir::cleanPath(AppState::instance().getSelectedDirPath()) != root_path) {
+        return;
+    }
+    AppState::instance().setSelectedExplorerPath(QString(), ExplorerPathType::Empty);
+    AppState::instance().setSelectedDirPath(QString());
 }
 
 void ExplorerCard::assignObjectNames() {}
 void ExplorerCard::applyQtStyles() {
-}
-void ExplorerCard::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/Explorer/ExplorerCard/ExplorerCard.qss");
-    if (!styleSheet.isEmpty()) {
-        tree_view->setStyleSheet(styleSheet);
-    }
+    // Every row is one line high, so the view never measures rows to lay out a large folder
+    tree_view->setUniformRowHeights(true);
 }
@@ -1,32 +1,45 @@
 #ifndef EXPLORERCARD_H
 #define EXPLORERCARD_H
 
-#include <QFileIconProvider>
+#include <QCheckBox>
 #include <QFileInfo>
-#include <QFileSystemModel>
+#include <QHBoxLayout>
+#include <QLineEdit>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QTreeView>
 #include <QVBoxLayout>
+#include "../ExplorerTreeModel/ExplorerTreeModel.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../../../Global/AppState.h"
 
 class ExplorerCard : public QWidget {
     Q_OBJECT
 
   public:
-    explicit ExplorerCard(QWidget *parent = nullptr);
-    void onSelectedExplorerPathModified(const QString &new_path, const std::string &path_type);
+    ExplorerCard(DatabaseWorker *database, QWidget *parent = nullptr);
+    void onSelectedExplorerPathModified(const QString &new_path, ExplorerPathType path_type);
     void renderDir(const QString &dir_path);
     void renderFile(const QString &file_path);
     void onTreeViewItemClicked(const QModelIndex &index);
+    void onFilterEdited();
+    void onGroupProblemsToggled(bool checked);
+    void onRootRemoved(const QString &root_path);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
 
   private:
-    QFileSystemModel *file_system_model;
+    ExplorerTreeModel *explorer_model;
     QStandardItemModel *single_file_model;
     QTreeView *tree_view;
     QVBoxLayout *layout;
+    QWidget *filter_bar;
+    QHBoxLayout *filter_layout;
+    QLineEdit *filter_edit;
+    QCheckBox *group_problems_checkbox;
+
+    DatabaseWorker *database;
+    void saveFilter();
 };
 
 #endif // EXPLORERCARD_H
\ No newline at end of file
@@ -1,9 +1,8 @@
 #include "ExplorerSection.h"
-#include "../utils/StyleLoader/StyleReader.h"
 
-ExplorerSection::ExplorerSection(QWidget *parent) : QWidget(parent) {
+ExplorerSection::ExplorerSection(DatabaseWorker *database, QWidget *parent) : QWidget(parent) {
     // Childs initialization
-    explorer_card = new ExplorerCard(this);
+    explorer_card = new ExplorerCard(database, this);
 
     // Layout
     layout = new QVBoxLayout(this);
@@ -14,19 +13,12 @@ ExplorerSection::ExplorerSection(QWidget *parent) : QWidget(parent) {
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void ExplorerSection::assignObjectNames() {
     setObjectName("explorer_section");
+    explorer_card->setObjectName("explorer_card");
 }
 void ExplorerSection::applyQtStyles() {
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
-    explorer_card->setStyleSheet("background-color: #000000; border: none; border-radius: 4px;");
-}
-void ExplorerSection::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/Explorer/ExplorerSection/ExplorerSection.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
 }
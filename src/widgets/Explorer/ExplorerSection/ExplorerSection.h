@@ -9,10 +9,9 @@ class ExplorerSection : public QWidget {
     Q_OBJECT
 
   public:
-    explicit ExplorerSection(QWidget *parent = nullptr);
+    ExplorerSection(DatabaseWorker *database, QWidget *parent = nullptr);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
 
   private:
     ExplorerCard *explorer_card;
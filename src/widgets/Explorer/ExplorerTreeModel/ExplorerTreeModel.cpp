@@ -0,0 +1,435 @@
+#include "ExplorerTreeModel.h"
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include "../../../FileSystemOperations/DirectoryEnumerator/DirectoryEnumerator.h"
+#include "../../../FileSystemOperations/IconCache/IconCache.h"
+#include "../../../FileSystemOperations/ProblemGrouper/ProblemGrouper.h"
+
+ExplorerTreeModel::ExplorerTreeModel(QObject *parent) : QAbstractItemModel(parent), root_generation(0), group_problems(false) {
+    root = makeNode(QString(), true, nullptr);
+    listing_pool.setMaxThreadCount(2);
+
+    append_timer = new QTimer(this);
+    append_timer->setSingleShot(true);
+    append_timer->setInterval(0);
+    connect(append_timer, &QTimer::timeout, this, &ExplorerTreeModel::appendPendingRows);
+}
+
+ExplorerTreeModel::~ExplorerTreeModel() {
+    // Workers post back to this object, let them finish first
+    listing_pool.waitForDone();
+}
+
+std::unique_ptr<ExplorerTreeModel::Node> ExplorerTreeModel::makeNode(const QString &name, bool is_dir, Node *parent) {
+    // Files have nothing to list, only grouped tests added by hand
+    return std::make_unique<Node>(Node{name, is_dir, !is_dir, false, false, parent, {}});
+}
+
+// Switching folders is the only full reset, every later change is a row diff
+void ExplorerTreeModel::setRootPath(const QString &new_root_path) {
+    beginResetModel();
+    root_path = QDir::cleanPath(new_root_path);
+    root_generation++;
+    pending_appends.clear();
+    root = makeNode(QString(), true, nullptr);
+    endResetModel();
+}
+
+QString ExplorerTreeModel::rootPath() const {
+    return root_path;
+}
+
+// Both settings re-list what is already shown and patch the difference
+void ExplorerTreeModel::setFilter(const ExplorerFilter &new_filter) {
+    name_filter = new_filter;
+    resync();
+}
+
+const ExplorerFilter &ExplorerTreeModel::filter() const {
+    return name_filter;
+}
+
+void ExplorerTreeModel::setGroupProblems(bool enabled) {
+    if (group_problems == enabled) {
+        return;
+    }
+    group_problems = enabled;
+    resync();
+}
+
+bool ExplorerTreeModel::accepts(const ExplorerFilter &filter, const QString &name, bool is_dir) {
+    if (name.startsWith('.')) {
+        return false;
+    }
+    return is_dir || filter.matches(name.toStdString());
+}
+
+bool ExplorerTreeModel::lessThan(const QString &a_name, bool a_is_dir, const QString &b_name, bool b_is_dir) {
+    if (a_is_dir != b_is_dir) {
+        return a_is_dir;
+    }
+    int order = QString::compare(a_name, b_name, Qt::CaseInsensitive);
+    return order != 0 ? order < 0 : a_name < b_name;
+}
+
+ExplorerTreeModel::Node *ExplorerTreeModel::nodeFor(const QModelIndex &index) const {
+    return index.isValid() ? static_cast<Node *>(index.internalPointer()) : root.get();
+}
+
+int ExplorerTreeModel::rowOf(const Node *node) const {
+    const std::vector<std::unique_ptr<Node>> &siblings = node->parent->children;
+    if (!node->parent->is_dir) {
+        // Tests keep their test order, not the name order
+        auto it = std::find_if(siblings.begin(), siblings.end(), [node](const std::unique_ptr<Node> &sibling) { return sibling.get() == node; });
+        return static_cast<int>(it - siblings.begin());
+    }
+    auto it = std::lower_bound(siblings.begin(), siblings.end(), node, [](const std::unique_ptr<Node> &sibling, const Node *target) {
+        return lessThan(sibling->name, sibling->is_dir, target->name, target->is_dir);
+    });
+    return static_cast<int>(it - siblings.begin());
+}
+
+QModelIndex ExplorerTreeModel::indexFor(Node *node) const {
+    if (!node || node == root.get()) {
+        return QModelIndex();
+    }
+    return createIndex(rowOf(node), 0, node);
+}
+
+QString ExplorerTreeModel::pathOf(const Node *node) const {
+    QStringList parts;
+    if (node && node != root.get()) {
+        parts.prepend(node->name);
+        node = node->parent;
+    }
+    // Tests sit under their source in the tree but next to it on disk
+    for (; node && node != root.get(); node = node->parent) {
+        if (node->is_dir) {
+            parts.prepend(node->name);
+        }
+    }
+    return parts.isEmpty() ? root_path : root_path + "/" + parts.join('/');
+}
+
+// Directory node for a path, if every directory on the way has rows
+ExplorerTreeModel::Node *ExplorerTreeModel::findDirectory(const QString &dir_path) const {
+    if (dir_path == root_path) {
+        return root.get();
+    }
+    if (!dir_path.startsWith(root_path + "/")) {
+        return nullptr;
+    }
+    Node *node = root.get();
+    for (const QString &part : dir_path.mid(root_path.size() + 1).split('/')) {
+        auto it = std::lower_bound(node->children.begin(), node->children.end(), part, [](const std::unique_ptr<Node> &child, const QString &name) {
+            return lessThan(child->name, child->is_dir, name, true);
+        });
+        if (it == node->children.end() || !(*it)->is_dir || (*it)->name != part) {
+            return nullptr;
+        }
+        node = it->get();
+    }
+    return node;
+}
+
+QString ExplorerTreeModel::filePath(const QModelIndex &index) const {
+    return index.isValid() ? pathOf(nodeFor(index)) : QString();
+}
+
+bool ExplorerTreeModel::isDir(const QModelIndex &index) const {
+    return nodeFor(index)->is_dir;
+}
+
+// Runs on a worker: everything up to the final sorted rows happens here
+std::vector<ExplorerTreeModel::Entry> ExplorerTreeModel::listDirectory(const QString &dir_path, const ExplorerFilter &filter, bool group_problems) {
+    std::vector<DirectoryEntry> listing;
+    DirectoryEnumerator::list(QFile::encodeName(dir_path).toStdString(), listing);
+
+    std::vector<Entry> entries;
+    entries.reserve(listing.size());
+    std::vector<std::string> file_names;
+    for (DirectoryEntry &item : listing) {
+        QString name = QFile::decodeName(item.name.c_str());
+        if (!accepts(filter, name, item.is_dir)) {
+            continue;
+        }
+        if (item.is_dir || !group_problems) {
+            entries.push_back(Entry{name, item.is_dir, {}});
+        } else {
+            file_names.push_back(std::move(item.name));
+        }
+    }
+    if (group_problems) {
+        // Grouping works on the names collected above, no file is opened or stat'ed
+        GroupedListing grouped = ProblemGrouper::group(file_names);
+        for (const ProblemGroup &group : grouped.groups) {
+            Entry entry{QFile::decodeName(group.source.c_str()), false, {}};
+            for (const std::string &test : group.tests) {
+                entry.tests << QFile::decodeName(test.c_str());
+            }
+            entries.push_back(entry);
+        }
+        for (const std::string &name : grouped.ungrouped) {
+            entries.push_back(Entry{QFile::decodeName(name.c_str()), false, {}});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return lessThan(a.name, a.is_dir, b.name, b.is_dir); });
+    return entries;
+}
+
+void ExplorerTreeModel::requestListing(Node *node) {
+    if (node->loading) {
+        node->stale = true;
+        return;
+    }
+    node->loading = true;
+    node->stale = false;
+    QString dir_path = pathOf(node);
+    quint64 generation = root_generation;
+    ExplorerFilter filter = name_filter;
+    bool grouped = group_problems;
+    listing_pool.start([this, dir_path, generation, filter, grouped]() {
+        Listing entries = std::make_shared<const std::vector<Entry>>(listDirectory(dir_path, filter, grouped));
+        QMetaObject::invokeMethod(this, [this, dir_path, generation, entries]() { onListingReady(dir_path, generation, entries); }, Qt::QueuedConnection);
+    });
+}
+
+void ExplorerTreeModel::onListingReady(const QString &dir_path, quint64 generation, const Listing &entries) {
+    Node *node = generation == root_generation ? findDirectory(dir_path) : nullptr;
+    if (!node || !node->loading) {
+        return;
+    }
+    if (node->fetched) {
+        applyListing(node, *entries);
+        finishLoading(node);
+        return;
+    }
+    // A first listing can hold tens of thousands of rows, hand them to the view in slices
+    pending_appends.push_back(PendingAppend{dir_path, generation, entries, 0});
+    append_timer->start();
+}
+
+void ExplorerTreeModel::appendPendingRows() {
+    int budget = ROWS_PER_BATCH;
+    while (budget > 0 && !pending_appends.empty()) {
+        PendingAppend &pending = pending_appends.front();
+        Node *node = pending.generation == root_generation ? findDirectory(pending.dir_path) : nullptr;
+        if (!node || node->fetched || !node->loading) {
+            pending_appends.pop_front();
+            continue;
+        }
+        size_t count = std::min<size_t>(budget, pending.entries->size() - pending.next);
+        if (count > 0) {
+            int first_row = static_cast<int>(node->children.size());
+            beginInsertRows(indexFor(node), first_row, first_row + static_cast<int>(count) - 1);
+            for (size_t i = pending.next; i < pending.next + count; i++) {
+                const Entry &entry = (*pending.entries)[i];
+                Node *child = node->children.emplace_back(makeNode(entry.name, entry.is_dir, node)).get();
+                for (const QString &test : entry.tests) {
+                    child->children.push_back(makeNode(test, false, child));
+                }
+            }
+            endInsertRows();
+            pending.next += count;
+            budget -= static_cast<int>(count);
+        }
+        if (pending.next == pending.entries->size()) {
+            node->fetched = true;
+            pending_appends.pop_front();
+            finishLoading(node);
+        }
+    }
+    if (!pending_appends.empty()) {
+        append_timer->start();
+    }
+}
+
+void ExplorerTreeModel::finishLoading(Node *node) {
+    node->loading = false;
+    if (node->stale) {
+        requestListing(node);
+    }
+}
+
+void ExplorerTreeModel::applyListing(Node *node, const std::vector<Entry> &entries) {
+    auto entry_less = [](const Entry &a, const Entry &b) { return lessThan(a.name, a.is_dir, b.name, b.is_dir); };
+    for (int row = static_cast<int>(node->children.size()) - 1; row >= 0; row--) {
+        const Node *child = node->children[row].get();
+        if (!std::binary_search(entries.begin(), entries.end(), Entry{child->name, child->is_dir, {}}, entry_less)) {
+            removeRow(node, row);
+        }
+    }
+    for (const Entry &entry : entries) {
+        insertEntry(node, entry);
+    }
+}
+
+void ExplorerTreeModel::insertEntry(Node *parent, const Entry &entry) {
+    auto position = std::lower_bound(parent->children.begin(), parent->children.end(), entry, [](const std::unique_ptr<Node> &child, const Entry &target) {
+        return lessThan(child->name, child->is_dir, target.name, target.is_dir);
+    });
+    if (position != parent->children.end() && (*position)->name == entry.name && (*position)->is_dir == entry.is_dir) {
+        syncTests(position->get(), entry.tests);
+        return;
+    }
+    int row = static_cast<int>(position - parent->children.begin());
+    beginInsertRows(indexFor(parent), row, row);
+    Node *node = parent->children.insert(position, makeNode(entry.name, entry.is_dir, parent))->get();
+    for (const QString &test : entry.tests) {
+        node->children.push_back(makeNode(test, false, node));
+    }
+    endInsertRows();
+}
+
+// Test lists are short, a changed one is simply replaced
+void ExplorerTreeModel::syncTests(Node *source, const QStringList &tests) {
+    if (source->is_dir) {
+        return;
+    }
+    QStringList current;
+    for (const std::unique_ptr<Node> &child : source->children) {
+        current << child->name;
+    }
+    if (current == tests) {
+        return;
+    }
+    QModelIndex source_index = indexFor(source);
+    if (!source->children.empty()) {
+        beginRemoveRows(source_index, 0, static_cast<int>(source->children.size()) - 1);
+        source->children.clear();
+        endRemoveRows();
+    }
+    if (!tests.isEmpty()) {
+        beginInsertRows(source_index, 0, static_cast<int>(tests.size()) - 1);
+        for (const QString &test : tests) {
+            source->children.push_back(makeNode(test, false, source));
+        }
+        endInsertRows();
+    }
+}
+
+void ExplorerTreeModel::removeRow(Node *parent, int row) {
+    beginRemoveRows(indexFor(parent), row, row);
+    parent->children.erase(parent->children.begin() + row);
+    endRemoveRows();
+}
+
+void ExplorerTreeModel::applyChanges(const QList<FileChange> &changes) {
+    for (const FileChange &change : changes) {
+        int slash = change.path.lastIndexOf('/');
+        Node *parent = findDirectory(change.path.left(slash));
+        // Directories nobody expanded are listed fresh when they are
+        if (!parent || (!parent->fetched && !parent->loading)) {
+            continue;
+        }
+        // Which file a test hangs under depends on its siblings, so grouped
+        // directories and those still loading are listed again instead
+        if (parent->loading || (group_problems && !change.is_dir)) {
+            requestListing(parent);
+            continue;
+        }
+        QString name = change.path.mid(slash + 1);
+        // A path replaced by the other kind (file <-> directory) drops the old row
+        for (int row = 0; row < static_cast<int>(parent->children.size()); row++) {
+            const Node *child = parent->children[row].get();
+            if (child->name == name && (change.kind == FileChange::Kind::Removed || child->is_dir != change.is_dir)) {
+                removeRow(parent, row);
+                break;
+            }
+        }
+        if (change.kind == FileChange::Kind::Added && accepts(name_filter, name, change.is_dir)) {
+            insertEntry(parent, Entry{name, change.is_dir, {}});
+        }
+    }
+}
+
+// After lost events or a settings change every listed directory is compared
+// with the disk and patched in place
+void ExplorerTreeModel::resync() {
+    resyncNode(root.get());
+}
+
+void ExplorerTreeModel::resyncNode(Node *node) {
+    if (!node->fetched && !node->loading) {
+        return;
+    }
+    requestListing(node);
+    for (const std::unique_ptr<Node> &child : node->children) {
+        if (child->is_dir) {
+            resyncNode(child.get());
+        }
+    }
+}
+
+QModelIndex ExplorerTreeModel::index(int row, int column, const QModelIndex &parent) const {
+    Node *parent_node = nodeFor(parent);
+    if (column != 0 || row < 0 || row >= static_cast<int>(parent_node->children.size())) {
+        return QModelIndex();
+    }
+    return createIndex(row, 0, parent_node->children[row].get());
+}
+
+QModelIndex ExplorerTreeModel::parent(const QModelIndex &child) const {
+    if (!child.isValid()) {
+        return QModelIndex();
+    }
+    return indexFor(nodeFor(child)->parent);
+}
+
+int ExplorerTreeModel::rowCount(const QModelIndex &parent) const {
+    if (parent.column() > 0) {
+        return 0;
+    }
+    return static_cast<int>(nodeFor(parent)->children.size());
+}
+
+int ExplorerTreeModel::columnCount(const QModelIndex &) const {
+    return 1;
+}
+
+QVariant ExplorerTreeModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid()) {
+        return QVariant();
+    }
+    Node *node = nodeFor(index);
+    switch (role) {
+    case Qt::DisplayRole:
+        return node->name;
+    case Qt::DecorationRole:
+        return node->is_dir ? IconCache::instance().folderIcon() : IconCache::instance().fileIcon(node->name);
+    case Qt::UserRole:
+        return pathOf(node);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ExplorerTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (section == 0 && orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        return QString("Name");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ExplorerTreeModel::flags(const QModelIndex &index) const {
+    return index.isValid() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable : Qt::NoItemFlags;
+}
+
+bool ExplorerTreeModel::hasChildren(const QModelIndex &parent) const {
+    Node *node = nodeFor(parent);
+    // Unlisted directories show an expander until they are opened
+    return (node->is_dir && !node->fetched) || !node->children.empty();
+}
+
+bool ExplorerTreeModel::canFetchMore(const QModelIndex &parent) const {
+    Node *node = nodeFor(parent);
+    return node->is_dir && !node->fetched && !node->loading && !root_path.isEmpty();
+}
+
+void ExplorerTreeModel::fetchMore(const QModelIndex &parent) {
+    Node *node = nodeFor(parent);
+    if (!node->fetched && !node->loading) {
+        requestListing(node);
+    }
+}
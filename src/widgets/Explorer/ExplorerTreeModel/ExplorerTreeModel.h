@@ -0,0 +1,105 @@
+#ifndef EXPLORERTREEMODEL_H
+#define EXPLORERTREEMODEL_H
+
+#include <QAbstractItemModel>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "../../../FileSystemOperations/DirectoryWatcher/DirectoryWatcher.h"
+#include "../../../FileSystemOperations/ExplorerFilter/ExplorerFilter.h"
+
+// File tree for the explorer. Directories are listed when first expanded and
+// then only patched with row inserts and removals as DirectoryWatcher reports
+// changes, so expansion state and selection survive external edits. With
+// problem grouping on, a solution's test files are listed under it.
+//
+// Listing, filtering, grouping and sorting run on a worker; a new listing is
+// appended to the view a batch of rows per event loop turn.
+class ExplorerTreeModel : public QAbstractItemModel {
+    Q_OBJECT
+
+  public:
+    explicit ExplorerTreeModel(QObject *parent = nullptr);
+    ~ExplorerTreeModel();
+    void setRootPath(const QString &root_path);
+    QString rootPath() const;
+    void setFilter(const ExplorerFilter &new_filter); // applies to files only
+    const ExplorerFilter &filter() const;
+    void setGroupProblems(bool enabled);
+    QString filePath(const QModelIndex &index) const;
+    bool isDir(const QModelIndex &index) const;
+    void applyChanges(const QList<FileChange> &changes);
+    void resync();
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+  private:
+    struct Node {
+        QString name;
+        bool is_dir;
+        bool fetched; // children hold the full listing
+        bool loading; // a listing is being read or appended
+        bool stale;   // changed while loading, list again when done
+        Node *parent;
+        std::vector<std::unique_ptr<Node>> children; // directories first, then by name; tests of a grouped source in test order
+    };
+    struct Entry {
+        QString name;
+        bool is_dir;
+        QStringList tests;
+    };
+    using Listing = std::shared_ptr<const std::vector<Entry>>;
+    struct PendingAppend {
+        QString dir_path;
+        quint64 generation;
+        Listing entries;
+        size_t next;
+    };
+
+    static std::unique_ptr<Node> makeNode(const QString &name, bool is_dir, Node *parent);
+    Node *nodeFor(const QModelIndex &index) const;
+    QModelIndex indexFor(Node *node) const;
+    int rowOf(const Node *node) const;
+    Node *findDirectory(const QString &dir_path) const;
+    QString pathOf(const Node *node) const;
+    void requestListing(Node *node);
+    void onListingReady(const QString &dir_path, quint64 generation, const Listing &entries);
+    void appendPendingRows();
+    void finishLoading(Node *node);
+    void applyListing(Node *node, const std::vector<Entry> &entries);
+    void insertEntry(Node *parent, const Entry &entry);
+    void removeRow(Node *parent, int row);
+    void syncTests(Node *source, const QStringList &tests);
+    void resyncNode(Node *node);
+    static std::vector<Entry> listDirectory(const QString &dir_path, const ExplorerFilter &filter, bool group_problems);
+    static bool accepts(const ExplorerFilter &filter, const QString &name, bool is_dir);
+    static bool lessThan(const QString &a_name, bool a_is_dir, const QString &b_name, bool b_is_dir);
+
+    std::unique_ptr<Node> root;
+    QString root_path;
+    quint64 root_generation; // listings for a previous root are dropped
+    ExplorerFilter name_filter;
+    bool group_problems;
+
+    QThreadPool listing_pool;
+    QTimer *append_timer;
+    std::deque<PendingAppend> pending_appends;
+
+    static constexpr int ROWS_PER_BATCH = 2000;
+};
+
+#endif // EXPLORERTREEMODEL_H
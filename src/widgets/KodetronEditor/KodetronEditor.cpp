@@ -1,5 +1,9 @@
 #include "KodetronEditor.h"
 #include "KodetronTheme.h"
+#include "../../Snippets/SnippetEngine/SnippetEngine.h"
+#include "../../utils/RangeShift/RangeShift.h"
+#include "../../utils/StartupTracer/StartupTracer.h"
+#include <QKeyEvent>
 
 KodetronEditor::KodetronEditor(QWidget* parent)
     : QsciScintilla(parent)
@@ -13,6 +17,7 @@ KodetronEditor::KodetronEditor(QWidget* parent)
     setupCaretLineHighlight();
     setupAutocompletion();
     setupDefaultTheme();
+    setupLanguageServer();
 
     // Subscribe to AppState file path changes
     connect(&AppState::instance(), &AppState::selectedFilePathModified,
@@ -21,6 +26,10 @@ KodetronEditor::KodetronEditor(QWidget* parent)
     // Add Ctrl+S shortcut for saving
     QShortcut* saveShortcut = new QShortcut(QKeySequence(Qt::CTRL + Qt::Key_S), this);
     connect(saveShortcut, &QShortcut::activated, this, &KodetronEditor::saveCurrentFile);
+
+    // Add F12 shortcut for go-to-definition
+    QShortcut* definitionShortcut = new QShortcut(QKeySequence(Qt::Key_F12), this);
+    connect(definitionShortcut, &QShortcut::activated, this, &KodetronEditor::goToDefinition);
 }
 
 void KodetronEditor::saveCurrentFile() {
@@ -32,12 +41,31 @@ void KodetronEditor::saveCurrentFile() {
 }
 
 void KodetronEditor::onFilePathChanged(const QString& file_path) {
+    snippetTabStops.clear();
+    // Close first so the buffer swap is not sent to the server as an edit
+    lspClient->closeDocument();
     if (file_path.isEmpty()) {
         setText(QString()); // Clear editor if no file path is set
         return;
     }
     QString content = FileDialog::readFileContents(file_path);
     setText(content);
+    lspClient->openDocument(file_path, text().toUtf8());
+}
+
+// Picks up changes written by other tools while keeping the caret where it was
+// One undo step that keeps the caret and scroll position, the buffer stays unsaved
+void KodetronEditor::replaceAllText(const QString& new_text) {
+    int line = 0;
+    int column = 0;
+    getCursorPosition(&line, &column);
+    int first_line = firstVisibleLine();
+    beginUndoAction();
+    selectAll();
+    replaceSelectedText(new_text);
+    endUndoAction();
+    setCursorPosition(qMin(line, lines() - 1), column);
+    setFirstVisibleLine(first_line);
 }
 
 void KodetronEditor::setupCppSyntaxHighlighting() {
@@ -79,10 +107,16 @@ void KodetronEditor::setupAutocompletion() {
         const char* keywords[] = {
             "int", "long", "double", "char", "bool", "string", "vector", "pair", "map", "set", "queue", "stack", "priority_queue", "for", "while", "else", "return", "break", "continue", "const", "auto", "void", "true", "false"
         };
+        QStringList base_entries;
         for (const char* kw : keywords) {
-            cppAPIs->add(QString::fromLatin1(kw));
+            base_entries << QString::fromLatin1(kw);
         }
-        cppAPIs->prepare();
+        // Standard library names come from a prepared file cached per compiler.
+        // Reading it takes a while and nobody completes before the first paint.
+        cppApiCache = new CppApiCache(cppAPIs, this);
+        StartupTracer::instance().defer("API preparation", [cache = cppApiCache, base_entries]() {
+            cache->load(base_entries);
+        });
     }
     setAutoCompletionSource(QsciScintilla::AcsAll);
     setAutoCompletionCaseSensitivity(false);
@@ -187,3 +221,227 @@ void KodetronEditor::applyCodeColors() {
     cppLexer->setColor(theme.synString,         QsciLexerCPP::VerbatimString);
 
 }
+
+void KodetronEditor::setupLanguageServer() {
+    lspClient = new LspClient(this);
+    KodetronTheme theme;
+
+    indicatorDefine(QsciScintilla::SquiggleIndicator, DIAGNOSTIC_ERROR_INDICATOR);
+    setIndicatorForegroundColor(theme.diagnosticError, DIAGNOSTIC_ERROR_INDICATOR);
+    indicatorDefine(QsciScintilla::SquiggleIndicator, DIAGNOSTIC_WARNING_INDICATOR);
+    setIndicatorForegroundColor(theme.diagnosticWarning, DIAGNOSTIC_WARNING_INDICATOR);
+    indicatorDefine(QsciScintilla::DotsIndicator, DIAGNOSTIC_INFO_INDICATOR);
+    setIndicatorForegroundColor(theme.diagnosticInfo, DIAGNOSTIC_INFO_INDICATOR);
+    SendScintilla(SCI_SETMOUSEDWELLTIME, HOVER_DWELL_MS);
+
+    connect(this, &QsciScintillaBase::SCN_MODIFIED, this, &KodetronEditor::onTextModified);
+    connect(this, &QsciScintillaBase::SCN_DWELLSTART, this, &KodetronEditor::onDwellStart);
+    connect(this, &QsciScintillaBase::SCN_DWELLEND, this, [this](int, int, int) { SendScintilla(SCI_CALLTIPCANCEL); });
+    connect(lspClient, &LspClient::diagnosticsPublished, this, &KodetronEditor::onDiagnosticsPublished);
+    connect(lspClient, &LspClient::hoverReady, this, &KodetronEditor::onHoverReady);
+    connect(lspClient, &LspClient::definitionReady, this, &KodetronEditor::onDefinitionReady);
+}
+
+// Forwards each Scintilla insertion/deletion as an incremental didChange range
+void KodetronEditor::onTextModified(int position, int modification_type, const char* text, int length, int, int, int, int, int, int) {
+    if (!snippetTabStops.empty()) {
+        if (modification_type & SC_MOD_INSERTTEXT) {
+            int active_index = snippetTabStopIndex >= 0 ? snippetTabStops[snippetTabStopIndex].index : -1;
+            SnippetParser::shiftForInsert(snippetTabStops, position, length, active_index);
+        } else if (modification_type & SC_MOD_BEFOREDELETE) {
+            SnippetParser::shiftForDelete(snippetTabStops, position, length);
+        }
+    }
+    if (!diagnostics.empty()) {
+        shiftDiagnostics(position, length, modification_type);
+    }
+    if (!lspClient->isDocumentOpen()) {
+        return;
+    }
+    if (modification_type & SC_MOD_INSERTTEXT) {
+        LspEditPosition start = lspEditPositionAt(position);
+        lspClient->queueChange(start, start, QByteArray(text, length));
+    } else if (modification_type & SC_MOD_BEFOREDELETE) {
+        // The deleted text is still in the buffer here, so both ends resolve
+        lspClient->queueChange(lspEditPositionAt(position), lspEditPositionAt(position + length), QByteArray());
+    }
+}
+
+// Scintilla moves the squiggles with the text itself; the ranges kept for
+// hover messages follow the same rules until the next publish replaces them.
+void KodetronEditor::shiftDiagnostics(int position, int length, int modification_type) {
+    for (DiagnosticRange& diagnostic : diagnostics) {
+        if (modification_type & SC_MOD_INSERTTEXT) {
+            RangeShift::forInsert(diagnostic.start, diagnostic.length, position, length, false);
+        } else if (modification_type & SC_MOD_BEFOREDELETE) {
+            RangeShift::forDelete(diagnostic.start, diagnostic.length, position, length);
+        }
+    }
+}
+
+void KodetronEditor::onDwellStart(int position, int, int) {
+    if (position < 0) {
+        return;
+    }
+    for (const DiagnosticRange& diagnostic : diagnostics) {
+        if (static_cast<size_t>(position) >= diagnostic.start && static_cast<size_t>(position) <= diagnostic.start + diagnostic.length) {
+            SendScintilla(SCI_CALLTIPSHOW, position, diagnostic.message.toUtf8().constData());
+            return;
+        }
+    }
+    int line = 0;
+    int column = 0;
+    lspPositionAt(position, line, column);
+    lspClient->requestHover(line, column);
+}
+
+void KodetronEditor::onHoverReady(int line, int column, const QString& hover_text) {
+    SendScintilla(SCI_CALLTIPSHOW, positionFromLsp(line, column), hover_text.toUtf8().constData());
+}
+
+void KodetronEditor::goToDefinition() {
+    int line = 0;
+    int column = 0;
+    lspPositionAt(static_cast<int>(SendScintilla(SCI_GETCURRENTPOS)), line, column);
+    lspClient->requestDefinition(line, column);
+}
+
+void KodetronEditor::onDefinitionReady(const LspLocation& location) {
+    if (location.file_path.isEmpty()) {
+        return;
+    }
+    if (location.file_path != AppState::instance().getSelectedFilePath()) {
+        // Committed now so onFilePathChanged loads the target before the jump
+        AppState::instance().setSelectedFilePath(location.file_path);
+        AppState::instance().commit();
+    }
+    SendScintilla(SCI_GOTOPOS, positionFromLsp(location.line, location.column));
+    setFocus();
+}
+
+void KodetronEditor::onDiagnosticsPublished(const QList<LspDiagnostic>& published) {
+    const int indicators[] = {DIAGNOSTIC_ERROR_INDICATOR, DIAGNOSTIC_WARNING_INDICATOR, DIAGNOSTIC_INFO_INDICATOR};
+    int document_length = static_cast<int>(SendScintilla(SCI_GETLENGTH));
+    for (int indicator : indicators) {
+        SendScintilla(SCI_SETINDICATORCURRENT, indicator);
+        SendScintilla(SCI_INDICATORCLEARRANGE, 0, document_length);
+    }
+
+    diagnostics.clear();
+    for (const LspDiagnostic& diagnostic : published) {
+        int start = positionFromLsp(diagnostic.start_line, diagnostic.start_column);
+        int end = positionFromLsp(diagnostic.end_line, diagnostic.end_column);
+        if (end <= start) {
+            // Zero-width ranges still get one visible character
+            end = qMin(start + 1, document_length);
+        }
+        int indicator = diagnostic.severity == 1 ? DIAGNOSTIC_ERROR_INDICATOR
+                      : diagnostic.severity == 2 ? DIAGNOSTIC_WARNING_INDICATOR
+                                                 : DIAGNOSTIC_INFO_INDICATOR;
+        SendScintilla(SCI_SETINDICATORCURRENT, indicator);
+        SendScintilla(SCI_INDICATORFILLRANGE, start, end - start);
+        diagnostics.push_back({static_cast<size_t>(start), static_cast<size_t>(end - start), diagnostic.message});
+    }
+}
+
+// Scintilla positions are byte offsets; LSP columns are UTF-8 or UTF-16 units
+void KodetronEditor::lspPositionAt(int position, int& line, int& column) const {
+    line = static_cast<int>(SendScintilla(SCI_LINEFROMPOSITION, position));
+    int line_start = static_cast<int>(SendScintilla(SCI_POSITIONFROMLINE, line));
+    column = lspClient->usesUtf8Columns() ? position - line_start
+                                          : static_cast<int>(SendScintilla(SCI_COUNTCODEUNITS, line_start, position));
+}
+
+// Edits may be queued before the encoding is negotiated, so they carry both
+LspEditPosition KodetronEditor::lspEditPositionAt(int position) const {
+    int line = static_cast<int>(SendScintilla(SCI_LINEFROMPOSITION, position));
+    int line_start = static_cast<int>(SendScintilla(SCI_POSITIONFROMLINE, line));
+    return LspEditPosition{line, position - line_start, static_cast<int>(SendScintilla(SCI_COUNTCODEUNITS, line_start, position))};
+}
+
+int KodetronEditor::positionFromLsp(int line, int column) const {
+    int line_start = static_cast<int>(SendScintilla(SCI_POSITIONFROMLINE, line));
+    if (line_start < 0) {
+        return static_cast<int>(SendScintilla(SCI_GETLENGTH));
+    }
+    int position = lspClient->usesUtf8Columns() ? line_start + column
+                                                : static_cast<int>(SendScintilla(SCI_POSITIONRELATIVECODEUNITS, line_start, column));
+    int line_end = static_cast<int>(SendScintilla(SCI_GETLINEENDPOSITION, line));
+    return qMin(position, line_end);
+}
+
+void KodetronEditor::keyPressEvent(QKeyEvent* event) {
+    // Tab expands a trigger word or walks the active snippet's tab stops,
+    // unless the autocompletion list is open and wants it
+    if (event->key() == Qt::Key_Tab && event->modifiers() == Qt::NoModifier && !isListActive()) {
+        if (advanceSnippetTabStop() || expandSnippetAtCaret()) {
+            event->accept();
+            return;
+        }
+    }
+    if (event->key() == Qt::Key_Escape) {
+        snippetTabStops.clear();
+    }
+    QsciScintilla::keyPressEvent(event);
+}
+
+bool KodetronEditor::expandSnippetAtCaret() {
+    if (!SendScintilla(SCI_GETSELECTIONEMPTY)) {
+        return false;
+    }
+    int caret = static_cast<int>(SendScintilla(SCI_GETCURRENTPOS));
+    int word_start = static_cast<int>(SendScintilla(SCI_WORDSTARTPOSITION, caret, true));
+    if (word_start == caret) {
+        return false;
+    }
+    const ParsedSnippet* snippet = SnippetEngine::instance().find(bytes(word_start, caret).toStdString());
+    if (!snippet) {
+        return false;
+    }
+
+    // Continuation lines follow the indentation of the trigger's line
+    int line_start = static_cast<int>(SendScintilla(SCI_POSITIONFROMLINE, SendScintilla(SCI_LINEFROMPOSITION, caret)));
+    QByteArray line_prefix = bytes(line_start, word_start);
+    int indent_length = 0;
+    while (indent_length < line_prefix.size() && (line_prefix[indent_length] == ' ' || line_prefix[indent_length] == '\t')) {
+        indent_length++;
+    }
+    ParsedSnippet expanded = SnippetParser::indent(*snippet, line_prefix.left(indent_length).toStdString());
+
+    beginUndoAction();
+    SendScintilla(SCI_SETTARGETRANGE, word_start, caret);
+    SendScintilla(SCI_REPLACETARGET, expanded.body.size(), expanded.body.c_str());
+    endUndoAction();
+
+    snippetTabStops = expanded.tab_stops;
+    for (SnippetTabStop& stop : snippetTabStops) {
+        stop.offset += word_start;
+    }
+    snippetTabStopIndex = -1;
+    advanceSnippetTabStop();
+    return true;
+}
+
+bool KodetronEditor::advanceSnippetTabStop() {
+    if (snippetTabStops.empty()) {
+        return false;
+    }
+    snippetTabStopIndex++;
+    const SnippetTabStop& stop = snippetTabStops[snippetTabStopIndex];
+    SendScintilla(SCI_SETSEL, stop.offset, stop.offset + stop.length);
+    // Repeats of the same placeholder are selected too, so typing edits them all
+    SendScintilla(SCI_SETMULTIPLESELECTION, true);
+    SendScintilla(SCI_SETADDITIONALSELECTIONTYPING, true);
+    while (snippetTabStopIndex + 1 < static_cast<int>(snippetTabStops.size()) &&
+           snippetTabStops[snippetTabStopIndex + 1].index == stop.index && stop.index != 0) {
+        snippetTabStopIndex++;
+        const SnippetTabStop& mirror = snippetTabStops[snippetTabStopIndex];
+        SendScintilla(SCI_ADDSELECTION, mirror.offset + mirror.length, mirror.offset);
+    }
+    SendScintilla(SCI_SETMAINSELECTION, 0);
+    if (snippetTabStopIndex + 1 >= static_cast<int>(snippetTabStops.size())) {
+        // The final stop ends the session
+        snippetTabStops.clear();
+    }
+    return true;
+}
@@ -7,15 +7,23 @@
 #include "KodetronTheme.h"
 #include "../../Global/AppState.h"
 #include "../../FileSystemOperations/FileDialog/FileDialog.h"
+#include "../../LanguageSupport/CppApiCache/CppApiCache.h"
+#include "../../LanguageSupport/LspClient/LspClient.h"
+#include "../../Snippets/SnippetParser/SnippetParser.h"
+#include <vector>
 
 class KodetronEditor : public QsciScintilla {
     Q_OBJECT
 public:
     explicit KodetronEditor(QWidget* parent = nullptr);
     void showThemeDialog(QWidget* parent = nullptr);
+    void replaceAllText(const QString& new_text);
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
 private:
     QsciLexerCPP* cppLexer = nullptr;
     QsciAPIs* cppAPIs = nullptr;
+    CppApiCache* cppApiCache = nullptr;
     void setupCppSyntaxHighlighting();
     void setupMargins();
     void setupBraceMatching();
@@ -26,4 +34,34 @@ private:
     void applyCodeColors();
     void onFilePathChanged(const QString& new_path);
     void saveCurrentFile();
+
+    // Language server integration
+    struct DiagnosticRange {
+        size_t start;
+        size_t length;
+        QString message;
+    };
+    LspClient* lspClient = nullptr;
+    std::vector<DiagnosticRange> diagnostics;
+    void setupLanguageServer();
+    void onTextModified(int position, int modification_type, const char* text, int length, int lines_added, int line, int fold_now, int fold_prev, int token, int annotation_lines_added);
+    void shiftDiagnostics(int position, int length, int modification_type);
+    void onDwellStart(int position, int x, int y);
+    void onHoverReady(int line, int column, const QString& hover_text);
+    void onDefinitionReady(const LspLocation& location);
+    void onDiagnosticsPublished(const QList<LspDiagnostic>& published);
+    void goToDefinition();
+    void lspPositionAt(int position, int& line, int& column) const;
+    LspEditPosition lspEditPositionAt(int position) const;
+    int positionFromLsp(int line, int column) const;
+    static constexpr int DIAGNOSTIC_ERROR_INDICATOR = 8;
+    static constexpr int DIAGNOSTIC_WARNING_INDICATOR = 9;
+    static constexpr int DIAGNOSTIC_INFO_INDICATOR = 10;
+    static constexpr int HOVER_DWELL_MS = 500;
+
+    // Snippet expansion
+    std::vector<SnippetTabStop> snippetTabStops; // absolute positions, empty when no session is active
+    int snippetTabStopIndex = -1;
+    bool expandSnippetAtCaret();
+    bool advanceSnippetTabStop();
 };
\ No newline at end of file
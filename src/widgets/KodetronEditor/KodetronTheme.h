@@ -39,4 +39,9 @@ struct KodetronTheme {
     QColor synOperator     = QColor("#D4D4D4");
     QColor synUnclosed     = QColor("#F44747"); // error-ish
 
+    // Language server diagnostics
+    QColor diagnosticError   = QColor("#F44747");
+    QColor diagnosticWarning = QColor("#CCA700");
+    QColor diagnosticInfo    = QColor("#3794FF");
+
 };
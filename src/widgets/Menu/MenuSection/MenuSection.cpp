@@ -1,19 +1,48 @@
 #include "MenuSection.h"
-#include "../../../utils/StyleLoader/StyleReader.h"
 #include "../../../FileSystemOperations/FileDialog/FileDialog.h"
 #include "../../../Global/AppState.h"
+#include "../../../Snippets/SnippetEngine/SnippetEngine.h"
+#include "../../../Templates/TemplateCache/TemplateCache.h"
+#include <QMessageBox>
+#include <QProgressDialog>
+#include <QStringList>
 
-MenuSection::MenuSection(QWidget *parent) : QWidget(parent) {
+MenuSection::MenuSection(DatabaseWorker *database, int user_id, QWidget *parent)
+    : QWidget(parent), database(database), user_id(user_id), new_from_template_dialog(nullptr) {
     file_button = new QPushButton("File", this);
     file_menu = new QMenu(this);
 
     // Add actions to the File menu
+    new_from_template_action = file_menu->addAction("New from template");
+    new_from_template_action->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_N));
+    file_menu->addSeparator();
     open_file_action = file_menu->addAction("Open file");
     open_dir_action = file_menu->addAction("Open folder");
+    file_menu->addSeparator();
+    quick_open_action = file_menu->addAction("Go to file");
+    quick_open_action->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_P));
+    find_in_folder_action = file_menu->addAction("Find in folder");
+    find_in_folder_action->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_F));
+    file_menu->addSeparator();
+    import_library_action = file_menu->addAction("Import library");
+    export_library_action = file_menu->addAction("Export library");
+    file_menu->addSeparator();
+    latency_panel_action = file_menu->addAction("Event loop latency");
+
+    // Shortcuts only fire for actions attached to a visible widget
+    addAction(new_from_template_action);
+    addAction(find_in_folder_action);
+    addAction(quick_open_action);
 
     // Connect actions to slots
+    connect(new_from_template_action, &QAction::triggered, this, &MenuSection::onNewFromTemplate);
     connect(open_file_action, &QAction::triggered, this, &MenuSection::onOpenFile);
     connect(open_dir_action, &QAction::triggered, this, &MenuSection::onOpenDir);
+    connect(find_in_folder_action, &QAction::triggered, this, &MenuSection::findInFolderRequested);
+    connect(quick_open_action, &QAction::triggered, this, &MenuSection::quickOpenRequested);
+    connect(import_library_action, &QAction::triggered, this, &MenuSection::onImportLibrary);
+    connect(export_library_action, &QAction::triggered, this, &MenuSection::onExportLibrary);
+    connect(latency_panel_action, &QAction::triggered, this, &MenuSection::latencyPanelRequested);
 
     file_button->setMenu(file_menu);
     file_button->setCursor(Qt::PointingHandCursor);
@@ -26,19 +55,72 @@ MenuSection::MenuSection(QWidget *parent) : QWidget(parent) {
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void MenuSection::onOpenDir() {
     QString dirPath = FileDialog::getOpenDirectoryPath(this);
     if (!dirPath.isEmpty()) {
-        AppState::instance().setSelectedExplorerPath(dirPath, AppState::instance().enumExplorerPathType.dir_type);
+        AppState::instance().setSelectedExplorerPath(dirPath, ExplorerPathType::Dir);
     }
 }
 void MenuSection::onOpenFile() {
     QString filePath = FileDialog::getOpenCppFilePath(this);
     if (!filePath.isEmpty()) {
-        AppState::instance().setSelectedExplorerPath(filePath, AppState::instance().enumExplorerPathType.file_type);
+        AppState::instance().setSelectedExplorerPath(filePath, ExplorerPathType::File);
+    }
+}
+void MenuSection::onNewFromTemplate() {
+    if (!new_from_template_dialog) {
+        // Create the NewFromTemplateDialog if it hasn't been created yet
+        new_from_template_dialog = new NewFromTemplateDialog(database, user_id, this);
+    }
+    new_from_template_dialog->exec();
+}
+void MenuSection::onImportLibrary() {
+    QString archive_path = FileDialog::getOpenLibraryPath(this);
+    if (archive_path.isEmpty()) {
+        return;
     }
+    // Only shows up when the import takes long enough to notice
+    QProgressDialog *progress = new QProgressDialog("Importing library...", QString(), 0, 100, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    connect(database, &DatabaseWorker::libraryProgress, progress, [progress](qint64 bytes_done, qint64 bytes_total) {
+        progress->setValue(bytes_total > 0 ? static_cast<int>(bytes_done * 100 / bytes_total) : 100);
+    });
+
+    database->importLibrary(archive_path.toStdString(), user_id).then(this, [this, progress](LibraryTransfer transfer) {
+        progress->deleteLater();
+        if (!transfer.ok) {
+            QMessageBox::warning(this, "Import library", "Nothing was imported. " + QString::fromStdString(transfer.error));
+            return;
+        }
+        // Expansion and New from template read these, not the database
+        SnippetEngine::instance().load(database, user_id);
+        TemplateCache::instance().load(database, user_id);
+        QString message = QString("Imported %1 snippets and templates.").arg(transfer.records);
+        if (!transfer.skipped.empty()) {
+            QStringList names;
+            for (const std::string &name : transfer.skipped) {
+                names.append(QString::fromStdString(name));
+            }
+            message += QString("\n\nSkipped %1 snippets whose names belong to another user: %2")
+                           .arg(names.size()).arg(names.join(", "));
+        }
+        QMessageBox::information(this, "Import library", message);
+    });
+}
+void MenuSection::onExportLibrary() {
+    QString archive_path = FileDialog::getSaveLibraryPath(this);
+    if (archive_path.isEmpty()) {
+        return;
+    }
+    database->exportLibrary(archive_path.toStdString(), user_id).then(this, [this](LibraryTransfer transfer) {
+        if (!transfer.ok) {
+            QMessageBox::warning(this, "Export library", QString::fromStdString(transfer.error));
+            return;
+        }
+        QMessageBox::information(this, "Export library", QString("Exported %1 snippets and templates.").arg(transfer.records));
+    });
 }
 
 void MenuSection::assignObjectNames() {
@@ -47,9 +129,3 @@ void MenuSection::assignObjectNames() {
 void MenuSection::applyQtStyles() {
     layout->addWidget(file_button, 0, Qt::AlignVCenter | Qt::AlignLeft);
 }
-void MenuSection::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/Menu/MenuSection/MenuSection.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
-}
@@ -6,16 +6,25 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QWidget>
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../NewFromTemplateDialog/NewFromTemplateDialog.h"
 
 class MenuSection : public QWidget {
     Q_OBJECT
   public:
-    MenuSection(QWidget *parent = nullptr);
+    MenuSection(DatabaseWorker *database, int user_id, QWidget *parent = nullptr);
     void onOpenFile();
     void onOpenDir();
+    void onNewFromTemplate();
+    void onImportLibrary();
+    void onExportLibrary();
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
+
+  signals:
+    void findInFolderRequested();
+    void quickOpenRequested();
+    void latencyPanelRequested();
 
   private:
     QPushButton *file_button;
@@ -24,6 +33,16 @@ class MenuSection : public QWidget {
 
     QAction *open_dir_action;
     QAction *open_file_action;
+    QAction *new_from_template_action;
+    QAction *find_in_folder_action;
+    QAction *quick_open_action;
+    QAction *import_library_action;
+    QAction *export_library_action;
+    QAction *latency_panel_action;
+
+    DatabaseWorker *database;
+    int user_id;
+    NewFromTemplateDialog *new_from_template_dialog;
 };
 
 #endif // MENUSECTION_H
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "NewFromTemplateDialog.h"
+#include "../../../Global/AppState.h"
+#include "../../../FileSystemOperations/FileDialog/FileDialog.h"
+#include "../../../Templates/TemplateCache/TemplateCache.h"
+#include <QDate>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTime>
+#include <unordered_map>
+
+namespace {
+    const QRegularExpression& invalidNameRegex() {
+        static const QRegularExpression regex(R"([\\/:*?"<>|])");
+        return regex;
+    }
+}
+
+NewFromTemplateDialog::NewFromTemplateDialog(DatabaseWorker* database, int userId, QWidget* parent)
+    : QDialog(parent), database(database), currentUserId(userId) {
+    setWindowTitle("New from Template");
+    setModal(true);
+    resize(450, 200);
+
+    setupUI();
+}
+
+NewFromTemplateDialog::~NewFromTemplateDialog() = default;
+
+int NewFromTemplateDialog::exec() {
+    // The target folder, the template list and the handle may have changed since the last use
+    QString dirPath = AppState::instance().getSelectedDirPath();
+    targetDirLabel->setText(dirPath.isEmpty() ? "Open a folder first" : dirPath);
+    loadTemplates();
+    // The handle only matters once files are created, it arrives long before that
+    database->fetchUser(currentUserId).then(this, [this](std::optional<User> user) {
+        userHandle = user ? user->codeforces_handle : std::string();
+    });
+    updateButtonStates();
+    problemNamesEdit->setFocus();
+    return QDialog::exec();
+}
+
+void NewFromTemplateDialog::setupUI() {
+    mainLayout = new QVBoxLayout(this);
+    formLayout = new QFormLayout();
+
+    targetDirLabel = new QLabel();
+    formLayout->addRow("Folder:", targetDirLabel);
+
+    templateCombo = new QComboBox();
+    connect(templateCombo, &QComboBox::currentIndexChanged, this, &NewFromTemplateDialog::onFieldChanged);
+    formLayout->addRow("Template:", templateCombo);
+
+    problemNamesEdit = new QLineEdit();
+    problemNamesEdit->setPlaceholderText("A-H, or names separated by spaces");
+    connect(problemNamesEdit, &QLineEdit::textChanged, this, &NewFromTemplateDialog::onFieldChanged);
+    connect(problemNamesEdit, &QLineEdit::returnPressed, this, &NewFromTemplateDialog::onCreateFiles);
+    formLayout->addRow("Problems:", problemNamesEdit);
+
+    extensionEdit = new QLineEdit(".cpp");
+    connect(extensionEdit, &QLineEdit::textChanged, this, &NewFromTemplateDialog::onFieldChanged);
+    formLayout->addRow("Extension:", extensionEdit);
+
+    mainLayout->addLayout(formLayout);
+
+    // Buttons
+    buttonLayout = new QHBoxLayout();
+
+    createButton = new QPushButton("Create Files");
+    closeButton = new QPushButton("Close");
+    createButton->setDefault(true);
+
+    connect(createButton, &QPushButton::clicked, this, &NewFromTemplateDialog::onCreateFiles);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(createButton);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(buttonLayout);
+}
+
+void NewFromTemplateDialog::loadTemplates() {
+    int selectedId = templateCombo->currentData().toInt();
+    templateCombo->clear();
+    for (const CachedTemplate& cached : TemplateCache::instance().templates()) {
+        templateCombo->addItem(QString::fromStdString(cached.name), cached.id);
+    }
+    int selectedIndex = templateCombo->findData(selectedId);
+    if (selectedIndex >= 0) {
+        templateCombo->setCurrentIndex(selectedIndex);
+    }
+}
+
+void NewFromTemplateDialog::onFieldChanged() {
+    updateButtonStates();
+}
+
+void NewFromTemplateDialog::updateButtonStates() {
+    bool hasTarget = !AppState::instance().getSelectedDirPath().isEmpty();
+    bool hasTemplate = templateCombo->currentIndex() >= 0;
+    bool hasProblems = !expandProblemNames(problemNamesEdit->text()).isEmpty();
+    QString extension = extensionEdit->text().trimmed();
+    bool hasExtension = !extension.isEmpty() && !extension.contains(invalidNameRegex());
+
+    createButton->setEnabled(hasTarget && hasTemplate && hasProblems && hasExtension);
+}
+
+// "A-H" expands to eight letters, "1-3" to numbers, anything else is a name.
+// Both ends of a letter range have the same case, "A-z" would run through [\]^_`
+QStringList NewFromTemplateDialog::expandProblemNames(const QString& input) const {
+    static const QRegularExpression separatorRegex(R"([\s,]+)");
+    static const QRegularExpression letterRangeRegex(R"(^(?:([A-Z])-([A-Z])|([a-z])-([a-z]))$)");
+    static const QRegularExpression numberRangeRegex(R"(^(\d+)-(\d+)$)");
+
+    QStringList names;
+    for (const QString& token : input.split(separatorRegex, Qt::SkipEmptyParts)) {
+        QRegularExpressionMatch letters = letterRangeRegex.match(token);
+        QRegularExpressionMatch numbers = numberRangeRegex.match(token);
+        QChar first;
+        QChar last;
+        if (letters.hasMatch()) {
+            bool upper = letters.capturedLength(1) > 0;
+            first = letters.captured(upper ? 1 : 3).at(0);
+            last = letters.captured(upper ? 2 : 4).at(0);
+        }
+        if (letters.hasMatch() && first <= last) {
+            for (QChar c = first; c <= last; c = QChar(c.unicode() + 1)) {
+                names << QString(c);
+            }
+        } else if (numbers.hasMatch() && numbers.captured(1).toInt() <= numbers.captured(2).toInt()) {
+            for (int i = numbers.captured(1).toInt(); i <= numbers.captured(2).toInt() && names.size() < 100; ++i) {
+                names << QString::number(i);
+            }
+        } else {
+            names << token;
+        }
+    }
+    // Checked after expansion, whatever produced the name
+    names.removeIf([](const QString& name) { return name.contains(invalidNameRegex()); });
+    names.removeDuplicates();
+    return names;
+}
+
+void NewFromTemplateDialog::onCreateFiles() {
+    QString dirPath = AppState::instance().getSelectedDirPath();
+    const CachedTemplate* cached = TemplateCache::instance().findById(templateCombo->currentData().toInt());
+    QStringList problemNames = expandProblemNames(problemNamesEdit->text());
+    QString extension = extensionEdit->text().trimmed();
+    if (dirPath.isEmpty() || !cached || problemNames.isEmpty() || extension.isEmpty() || extension.contains(invalidNameRegex())) {
+        return;
+    }
+    if (!extension.startsWith('.')) {
+        extension.prepend('.');
+    }
+
+    std::unordered_map<std::string, std::string> variables = {
+        {"date", QDate::currentDate().toString(Qt::ISODate).toStdString()},
+        {"time", QTime::currentTime().toString("HH:mm").toStdString()},
+        {"handle", userHandle},
+    };
+
+    // Render the whole batch before touching the disk so a clash aborts it cleanly
+    QDir targetDir(dirPath);
+    QList<QPair<QString, QString>> files;
+    QStringList existingNames;
+    for (const QString& problemName : problemNames) {
+        QString fileName = problemName + extension;
+        QString filePath = targetDir.filePath(fileName);
+        if (QFileInfo::exists(filePath)) {
+            existingNames << fileName;
+            continue;
+        }
+        variables["problem"] = problemName.toStdString();
+        variables["file"] = fileName.toStdString();
+        files.append({filePath, QString::fromStdString(TemplateRenderer::render(cached->parsed, variables))});
+    }
+    if (!existingNames.isEmpty()) {
+        QMessageBox::warning(this, "Files Exist",
+            QString("These files already exist and were not overwritten:\n%1").arg(existingNames.join(", ")));
+        return;
+    }
+
+    // All or nothing: none of these paths existed, so a failure removes what was written
+    for (qsizetype i = 0; i < files.size(); i++) {
+        if (!FileDialog::writeFileContents(files[i].first, files[i].second)) {
+            for (qsizetype written = 0; written <= i; written++) {
+                QFile::remove(files[written].first);
+            }
+            QMessageBox::warning(this, "Error",
+                QString("Failed to write %1, no files were created").arg(QFileInfo(files[i].first).fileName()));
+            return;
+        }
+    }
+
+    accept();
+    problemNamesEdit->clear();
+    AppState::instance().setSelectedFilePath(files.first().first);
+}
@@ -0,0 +1,53 @@
+#ifndef NEWFROMTEMPLATEDIALOG_H
+#define NEWFROMTEMPLATEDIALOG_H
+
+#include <QDialog>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QLabel>
+#include <QPushButton>
+#include <QMessageBox>
+#include <QStringList>
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+
+class NewFromTemplateDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit NewFromTemplateDialog(DatabaseWorker* database, int userId, QWidget* parent = nullptr);
+    ~NewFromTemplateDialog();
+    int exec() override;
+
+private slots:
+    void onCreateFiles();
+    void onFieldChanged();
+
+private:
+    void setupUI();
+    void loadTemplates();
+    void updateButtonStates();
+    QStringList expandProblemNames(const QString& input) const;
+
+    // UI Components
+    QVBoxLayout* mainLayout;
+    QFormLayout* formLayout;
+    QHBoxLayout* buttonLayout;
+
+    QLabel* targetDirLabel;
+    QComboBox* templateCombo;
+    QLineEdit* problemNamesEdit;
+    QLineEdit* extensionEdit;
+
+    QPushButton* createButton;
+    QPushButton* closeButton;
+
+    // Data
+    DatabaseWorker* database;
+    int currentUserId;
+    std::string userHandle;
+};
+
+#endif // NEWFROMTEMPLATEDIALOG_H
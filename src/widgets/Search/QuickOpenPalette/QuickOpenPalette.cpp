@@ -0,0 +1,105 @@
+#include "QuickOpenPalette.h"
+#include "../../../Global/AppState.h"
+#include <QKeyEvent>
+
+QuickOpenPalette::QuickOpenPalette(PathIndex *path_index, QWidget *parent)
+    : QDialog(parent, Qt::Popup), path_index(path_index), candidates_generation(0) {
+    resize(600, 400);
+
+    query_edit = new QLineEdit(this);
+    query_edit->setPlaceholderText("Go to file");
+    query_edit->installEventFilter(this);
+    connect(query_edit, &QLineEdit::textChanged, this, &QuickOpenPalette::onQueryChanged);
+    connect(query_edit, &QLineEdit::returnPressed, this, &QuickOpenPalette::onAccepted);
+
+    results_list = new QListWidget(this);
+    results_list->setUniformItemSizes(true);
+    connect(results_list, &QListWidget::itemActivated, this, &QuickOpenPalette::onAccepted);
+    connect(results_list, &QListWidget::itemClicked, this, &QuickOpenPalette::onAccepted);
+
+    status_label = new QLabel(this);
+
+    // Re-run the query when a crawl or a file system change updates the index
+    connect(path_index, &PathIndex::pathsChanged, this, &QuickOpenPalette::onPathsChanged);
+
+    layout = new QVBoxLayout(this);
+    layout->addWidget(query_edit);
+    layout->addWidget(results_list, 1);
+    layout->addWidget(status_label);
+    setLayout(layout);
+
+    assignObjectNames();
+    applyQtStyles();
+}
+
+void QuickOpenPalette::popup() {
+    if (QWidget *anchor = parentWidget()) {
+        QPoint top_center = anchor->mapToGlobal(QPoint(anchor->width() / 2, 0));
+        move(top_center.x() - width() / 2, top_center.y() + 40);
+    }
+    query_edit->clear();
+    onQueryChanged(QString());
+    show();
+    query_edit->setFocus();
+}
+
+void QuickOpenPalette::assignObjectNames() {
+    setObjectName("quick_open_palette");
+    query_edit->setObjectName("quick_open_query_edit");
+    results_list->setObjectName("quick_open_results_list");
+}
+
+void QuickOpenPalette::applyQtStyles() {
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->setSpacing(6);
+}
+
+// Arrow keys move through the results while typing stays in the query box
+bool QuickOpenPalette::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == query_edit && event->type() == QEvent::KeyPress) {
+        int key = static_cast<QKeyEvent *>(event)->key();
+        if (key == Qt::Key_Down || key == Qt::Key_Up || key == Qt::Key_PageDown || key == Qt::Key_PageUp) {
+            QCoreApplication::sendEvent(results_list, event);
+            return true;
+        }
+    }
+    return QDialog::eventFilter(watched, event);
+}
+
+void QuickOpenPalette::onQueryChanged(const QString &query) {
+    std::string query_text = query.toStdString();
+    bool can_narrow = !candidates_query.isEmpty() && query.startsWith(candidates_query) && candidates_generation == path_index->generation();
+    std::vector<uint32_t> matched;
+    std::vector<FuzzyResult> results = FuzzyMatcher::match(path_index->paths(), query_text, MAX_RESULTS, can_narrow ? &candidates : nullptr, &matched);
+    candidates.swap(matched);
+    candidates_query = query;
+    candidates_generation = path_index->generation();
+
+    results_list->clear();
+    for (const FuzzyResult &result : results) {
+        std::string_view path = path_index->paths().at(result.index);
+        QListWidgetItem *item = new QListWidgetItem(QString::fromUtf8(path.data(), static_cast<qsizetype>(path.size())), results_list);
+        item->setData(Qt::UserRole, result.index);
+    }
+    if (results_list->count() > 0) {
+        results_list->setCurrentRow(0);
+    }
+    status_label->setText(path_index->rootPath().isEmpty()
+                              ? "Open a folder first"
+                              : QString("%1 of %2 files").arg(candidates.size()).arg(path_index->paths().size()));
+}
+
+void QuickOpenPalette::onPathsChanged() {
+    if (isVisible()) {
+        onQueryChanged(query_edit->text());
+    }
+}
+
+void QuickOpenPalette::onAccepted() {
+    QListWidgetItem *item = results_list->currentItem();
+    if (!item) {
+        return;
+    }
+    AppState::instance().setSelectedFilePath(path_index->absolutePath(item->data(Qt::UserRole).toUInt()));
+    hide();
+}
@@ -0,0 +1,44 @@
+#ifndef QUICKOPENPALETTE_H
+#define QUICKOPENPALETTE_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+#include <vector>
+#include "../../../Search/PathIndex/PathIndex.h"
+
+class QuickOpenPalette : public QDialog {
+    Q_OBJECT
+
+  public:
+    explicit QuickOpenPalette(PathIndex *path_index, QWidget *parent = nullptr);
+    void popup();
+    void assignObjectNames();
+    void applyQtStyles();
+
+  protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+  private slots:
+    void onQueryChanged(const QString &query);
+    void onPathsChanged();
+    void onAccepted();
+
+  private:
+    QVBoxLayout *layout;
+    QLineEdit *query_edit;
+    QListWidget *results_list;
+    QLabel *status_label;
+
+    PathIndex *path_index;
+    // Paths matching the previous query; a longer query only rescans these
+    std::vector<uint32_t> candidates;
+    QString candidates_query;
+    quint64 candidates_generation;
+
+    static constexpr size_t MAX_RESULTS = 50;
+};
+
+#endif // QUICKOPENPALETTE_H
@@ -0,0 +1,214 @@
+#include "SearchPanel.h"
+#include "../../../Global/AppState.h"
+#include <QDir>
+#include <QMessageBox>
+
+SearchPanel::SearchPanel(KodetronEditor *code_editor, QWidget *parent)
+    : QDialog(parent), code_editor(code_editor), open_file_replaced(false), active_search_id(-1), match_count(0) {
+    setWindowTitle("Find in Folder");
+    resize(700, 500);
+
+    file_searcher = new FileSearcher(this);
+    connect(file_searcher, &FileSearcher::fileMatched, this, &SearchPanel::onFileMatched);
+    connect(file_searcher, &FileSearcher::searchFinished, this, &SearchPanel::onSearchFinished);
+    connect(file_searcher, &FileSearcher::replaceFinished, this, &SearchPanel::onReplaceFinished);
+
+    // Query row
+    query_edit = new QLineEdit(this);
+    query_edit->setPlaceholderText("Search");
+    regex_checkbox = new QCheckBox("Regex", this);
+    case_checkbox = new QCheckBox("Match case", this);
+    search_button = new QPushButton("Search", this);
+    cancel_button = new QPushButton("Cancel", this);
+    connect(query_edit, &QLineEdit::returnPressed, this, &SearchPanel::onSearch);
+    connect(search_button, &QPushButton::clicked, this, &SearchPanel::onSearch);
+    connect(cancel_button, &QPushButton::clicked, this, &SearchPanel::onCancel);
+
+    query_layout = new QHBoxLayout();
+    query_layout->addWidget(query_edit, 1);
+    query_layout->addWidget(regex_checkbox);
+    query_layout->addWidget(case_checkbox);
+    query_layout->addWidget(search_button);
+    query_layout->addWidget(cancel_button);
+
+    // Replace row
+    replace_edit = new QLineEdit(this);
+    replace_edit->setPlaceholderText("Replace");
+    replace_all_button = new QPushButton("Replace All", this);
+    connect(replace_all_button, &QPushButton::clicked, this, &SearchPanel::onReplaceAll);
+
+    replace_layout = new QHBoxLayout();
+    replace_layout->addWidget(replace_edit, 1);
+    replace_layout->addWidget(replace_all_button);
+
+    // Results grouped by file
+    results_tree = new QTreeWidget(this);
+    results_tree->setHeaderHidden(true);
+    results_tree->setUniformRowHeights(true);
+    connect(results_tree, &QTreeWidget::itemActivated, this, &SearchPanel::onResultActivated);
+    connect(results_tree, &QTreeWidget::itemClicked, this, &SearchPanel::onResultActivated);
+
+    status_label = new QLabel(this);
+
+    layout = new QVBoxLayout(this);
+    layout->addLayout(query_layout);
+    layout->addLayout(replace_layout);
+    layout->addWidget(results_tree, 1);
+    layout->addWidget(status_label);
+    setLayout(layout);
+
+    assignObjectNames();
+    applyQtStyles();
+    setSearching(false);
+}
+
+void SearchPanel::showForCurrentFolder() {
+    root_path = AppState::instance().getSelectedDirPath();
+    status_label->setText(root_path.isEmpty() ? "Open a folder first" : root_path);
+    show();
+    raise();
+    activateWindow();
+    query_edit->setFocus();
+    query_edit->selectAll();
+}
+
+void SearchPanel::assignObjectNames() {
+    setObjectName("search_panel");
+    query_edit->setObjectName("search_query_edit");
+    replace_edit->setObjectName("search_replace_edit");
+    results_tree->setObjectName("search_results_tree");
+}
+
+void SearchPanel::applyQtStyles() {
+    layout->setContentsMargins(10, 10, 10, 10);
+    layout->setSpacing(10);
+}
+
+SearchQuery SearchPanel::currentQuery() const {
+    SearchQuery query;
+    query.pattern = query_edit->text();
+    query.use_regex = regex_checkbox->isChecked();
+    query.case_sensitive = case_checkbox->isChecked();
+    return query;
+}
+
+void SearchPanel::setSearching(bool searching) {
+    search_button->setEnabled(!searching);
+    cancel_button->setEnabled(searching);
+    replace_all_button->setEnabled(!searching && results_tree->topLevelItemCount() > 0);
+}
+
+void SearchPanel::onSearch() {
+    SearchQuery query = currentQuery();
+    if (root_path.isEmpty() || query.pattern.isEmpty()) {
+        return;
+    }
+    if (query.use_regex && !QRegularExpression(query.pattern).isValid()) {
+        status_label->setText("Invalid regular expression");
+        return;
+    }
+    results_tree->clear();
+    match_count = 0;
+    last_query = query;
+    // The open file is searched as the editor shows it, saved or not
+    QHash<QString, QString> open_buffers;
+    QString open_file = AppState::instance().getSelectedFilePath();
+    if (!open_file.isEmpty()) {
+        open_buffers.insert(open_file, code_editor->text());
+    }
+    active_search_id = file_searcher->start(root_path, query, open_buffers);
+    status_label->setText("Searching...");
+    setSearching(true);
+}
+
+void SearchPanel::onCancel() {
+    file_searcher->cancel();
+}
+
+void SearchPanel::onFileMatched(const FileSearchResult &result) {
+    // Results from a superseded search may still be queued
+    if (result.search_id != active_search_id) {
+        return;
+    }
+    QTreeWidgetItem *file_item = new QTreeWidgetItem(results_tree);
+    file_item->setText(0, QString("%1 (%2)").arg(QDir(root_path).relativeFilePath(result.file_path)).arg(result.matches.size()));
+    file_item->setData(0, Qt::UserRole, result.file_path);
+    for (const SearchMatch &match : result.matches) {
+        QTreeWidgetItem *match_item = new QTreeWidgetItem(file_item);
+        match_item->setText(0, QString("%1: %2").arg(match.line + 1).arg(match.line_text.trimmed()));
+        match_item->setData(0, Qt::UserRole, result.file_path);
+        match_item->setData(0, Qt::UserRole + 1, match.line);
+        match_item->setData(0, Qt::UserRole + 2, match.column);
+    }
+    match_count += static_cast<int>(result.matches.size());
+    status_label->setText(QString("%1 matches in %2 files...").arg(match_count).arg(results_tree->topLevelItemCount()));
+}
+
+void SearchPanel::onSearchFinished(int search_id, int files_scanned, bool cancelled) {
+    if (search_id != active_search_id) {
+        return;
+    }
+    results_tree->sortItems(0, Qt::AscendingOrder);
+    status_label->setText(QString("%1 matches in %2 files (%3 scanned)%4")
+                              .arg(match_count)
+                              .arg(results_tree->topLevelItemCount())
+                              .arg(files_scanned)
+                              .arg(cancelled ? ", cancelled" : ""));
+    setSearching(false);
+}
+
+void SearchPanel::onReplaceAll() {
+    QStringList file_paths;
+    for (int i = 0; i < results_tree->topLevelItemCount(); ++i) {
+        file_paths << results_tree->topLevelItem(i)->data(0, Qt::UserRole).toString();
+    }
+    if (file_paths.isEmpty()) {
+        return;
+    }
+    int reply = QMessageBox::question(this, "Confirm Replace",
+        QString("Replace %1 matches in %2 files?").arg(match_count).arg(file_paths.size()),
+        QMessageBox::Yes | QMessageBox::No);
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+    active_search_id = -1;
+    // The open file is replaced in the editor, where unsaved edits live, and left alone on disk
+    open_file_replaced = false;
+    QString open_file = AppState::instance().getSelectedFilePath();
+    if (file_paths.removeAll(open_file) > 0) {
+        QString text = code_editor->text();
+        if (FileSearcher::replaceInText(text, last_query, replace_edit->text())) {
+            code_editor->replaceAllText(text);
+            open_file_replaced = true;
+        }
+    }
+    file_searcher->replaceAll(file_paths, last_query, replace_edit->text());
+    status_label->setText("Replacing...");
+    setSearching(true);
+}
+
+void SearchPanel::onReplaceFinished(int files_changed, const QStringList &failed_paths) {
+    results_tree->clear();
+    status_label->setText(open_file_replaced ? QString("Replaced in %1 files and in the open file, which is not saved yet").arg(files_changed)
+                                             : QString("Replaced in %1 files").arg(files_changed));
+    setSearching(false);
+    if (!failed_paths.isEmpty()) {
+        QMessageBox::warning(this, "Error", QString("Could not rewrite:\n%1").arg(failed_paths.join("\n")));
+    }
+}
+
+void SearchPanel::onResultActivated(QTreeWidgetItem *item) {
+    QString file_path = item->data(0, Qt::UserRole).toString();
+    if (file_path.isEmpty()) {
+        return;
+    }
+    AppState::instance().setSelectedFilePath(file_path);
+    // The editor has to hold the file before the caret is placed
+    AppState::instance().commit();
+    QVariant line = item->data(0, Qt::UserRole + 1);
+    if (line.isValid()) {
+        code_editor->setCursorPosition(line.toInt(), item->data(0, Qt::UserRole + 2).toInt());
+        code_editor->ensureLineVisible(line.toInt());
+    }
+    code_editor->setFocus();
+}
@@ -0,0 +1,60 @@
+#ifndef SEARCHPANEL_H
+#define SEARCHPANEL_H
+
+#include <QDialog>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHash>
+#include "../../../Search/FileSearcher/FileSearcher.h"
+#include "../../KodetronEditor/KodetronEditor.h"
+
+class SearchPanel : public QDialog {
+    Q_OBJECT
+
+  public:
+    explicit SearchPanel(KodetronEditor *code_editor, QWidget *parent = nullptr);
+    void showForCurrentFolder();
+    void assignObjectNames();
+    void applyQtStyles();
+
+  private slots:
+    void onSearch();
+    void onCancel();
+    void onReplaceAll();
+    void onFileMatched(const FileSearchResult &result);
+    void onSearchFinished(int search_id, int files_scanned, bool cancelled);
+    void onReplaceFinished(int files_changed, const QStringList &failed_paths);
+    void onResultActivated(QTreeWidgetItem *item);
+
+  private:
+    SearchQuery currentQuery() const;
+    void setSearching(bool searching);
+
+    QVBoxLayout *layout;
+    QHBoxLayout *query_layout;
+    QHBoxLayout *replace_layout;
+    QLineEdit *query_edit;
+    QCheckBox *regex_checkbox;
+    QCheckBox *case_checkbox;
+    QPushButton *search_button;
+    QPushButton *cancel_button;
+    QLineEdit *replace_edit;
+    QPushButton *replace_all_button;
+    QTreeWidget *results_tree;
+    QLabel *status_label;
+
+    KodetronEditor *code_editor;
+    FileSearcher *file_searcher;
+    QString root_path;
+    SearchQuery last_query;
+    bool open_file_replaced;
+    int active_search_id;
+    int match_count;
+};
+
+#endif // SEARCHPANEL_H
@@ -1,12 +1,16 @@
 #include "ExecutionOptionsContainer.h"
-#include "../utils/StyleLoader/StyleReader.h"
 
 ExecutionOptionsContainer::ExecutionOptionsContainer(QWidget *parent) : QWidget(parent) {
     // Initialize buttons and labels
     run_button = new QPushButton("Run", this);
+    test_case_selector = new QComboBox(this);
+    add_test_button = new QPushButton("+", this);
+    add_test_button->setToolTip("Add test case");
 
     // Layout for the execution options
     layout = new QHBoxLayout(this);
+    layout->addWidget(test_case_selector);
+    layout->addWidget(add_test_button);
     layout->addWidget(run_button, 1);
     setLayout(layout);
 
@@ -14,20 +18,16 @@ ExecutionOptionsContainer::ExecutionOptionsContainer(QWidget *parent) : QWidget(
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void ExecutionOptionsContainer::assignObjectNames() {
     setObjectName("execution_options_container");
     run_button->setObjectName("run_button");
+    test_case_selector->setObjectName("test_case_selector");
+    add_test_button->setObjectName("add_test_button");
 }
 void ExecutionOptionsContainer::applyQtStyles() {
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(10);
     run_button->setCursor(Qt::PointingHandCursor);
-}
-void ExecutionOptionsContainer::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/StandardIO/ExecutionOptionsContainer/ExecutionOptionsContainer.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
+    add_test_button->setCursor(Qt::PointingHandCursor);
 }
@@ -6,6 +6,7 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QCheckBox>
+#include <QComboBox>
 
 class ExecutionOptionsContainer : public QWidget {
     Q_OBJECT
@@ -14,11 +15,14 @@ class ExecutionOptionsContainer : public QWidget {
     explicit ExecutionOptionsContainer(QWidget *parent = nullptr);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
     QPushButton* getRunButton() const { return run_button; }
+    QComboBox* getTestCaseSelector() const { return test_case_selector; }
+    QPushButton* getAddTestButton() const { return add_test_button; }
 
   private:
     QPushButton *run_button;
+    QComboBox *test_case_selector;
+    QPushButton *add_test_button;
     QLabel *run_in_terminal_label;
     QCheckBox *run_in_terminal_checkbox;
     QHBoxLayout *layout;
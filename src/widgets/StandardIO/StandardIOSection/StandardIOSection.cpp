@@ -1,12 +1,16 @@
 #include "StandardIOSection.h"
-#include "../utils/StyleLoader/StyleReader.h"
+#include "../../../Global/AppState.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QProcess>
+#include <QSignalBlocker>
 #include <QFile>
 #include <QTextStream>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 
-StandardIOSection::StandardIOSection(KodetronEditor* code_editor, QWidget *parent) : QWidget(parent), code_editor(code_editor) {
+StandardIOSection::StandardIOSection(DatabaseWorker* database, KodetronEditor* code_editor, QWidget *parent)
+    : QWidget(parent), code_editor(code_editor), database(database), current_test(0), test_cases_modified(false) {
     // Childs initialization
     execution_options_container = new ExecutionOptionsContainer(this);
     input_text_box = new QTextEdit(this);
@@ -22,12 +26,29 @@ StandardIOSection::StandardIOSection(KodetronEditor* code_editor, QWidget *paren
 
     // Connect Run button
     connect(execution_options_container->getRunButton(), &QPushButton::clicked, this, &StandardIOSection::onRunClicked);
+    connect(execution_options_container->getTestCaseSelector(), &QComboBox::currentIndexChanged, this, &StandardIOSection::onTestCaseSelected);
+    connect(execution_options_container->getAddTestButton(), &QPushButton::clicked, this, &StandardIOSection::onAddTestCase);
+    connect(input_text_box, &QTextEdit::textChanged, this, &StandardIOSection::panelStateChanged);
+    connect(input_text_box, &QTextEdit::textChanged, this, &StandardIOSection::scheduleSave);
+
+    // Added tests and typed input are kept even if they are never run
+    save_timer = new QTimer(this);
+    save_timer->setSingleShot(true);
+    save_timer->setInterval(SAVE_DELAY_MS);
+    connect(save_timer, &QTimer::timeout, this, &StandardIOSection::flushTestCases);
+    // The database worker is still running when the event loop quits
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &StandardIOSection::flushTestCases);
+
+    // Each source file keeps its own test cases
+    test_cases.push_back(TestCase{std::string(), std::string(), std::string(), TestVerdict::None, -1});
+    fillTestCaseSelector();
+    connect(&AppState::instance(), &AppState::selectedFilePathModified, this, &StandardIOSection::onFilePathChanged);
+    onFilePathChanged(AppState::instance().getSelectedFilePath());
 
     // Styles
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void StandardIOSection::assignObjectNames() {
     setObjectName("standard_io_section");
@@ -38,11 +59,126 @@ void StandardIOSection::applyQtStyles() {
     layout->setContentsMargins(10, 10, 10, 10);
     layout->setSpacing(20);
 }
-void StandardIOSection::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/StandardIO/StandardIOSection/StandardIOSection.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
+
+void StandardIOSection::onFilePathChanged(const QString &file_path) {
+    if (file_path == test_file_path) {
+        return;
+    }
+    flushTestCases();
+
+    // Edits made with no file open have nowhere to go
+    test_cases_modified = false;
+    test_file_path = file_path;
+    test_cases.assign(1, TestCase{std::string(), std::string(), std::string(), TestVerdict::None, -1});
+    fillTestCaseSelector();
+    showTestCase(0);
+    if (file_path.isEmpty()) {
+        return;
     }
+    // One indexed query for the whole suite; an empty suite keeps the blank test
+    database->fetchTestCases(file_path.toStdString()).then(this, [this, file_path](std::vector<TestCase> stored) {
+        if (file_path != test_file_path || test_cases_modified) {
+            return;
+        }
+        if (!stored.empty()) {
+            test_cases = std::move(stored);
+            fillTestCaseSelector();
+            showTestCase(0);
+        }
+        if (restore_file_path == file_path) {
+            restore_file_path.clear();
+            if (restore_state.test_index >= 0 && restore_state.test_index < static_cast<int>(test_cases.size())) {
+                showTestCase(restore_state.test_index);
+                // Typed but never run, so not part of the stored suite yet
+                input_text_box->setPlainText(restore_state.input);
+            }
+        }
+    });
+}
+
+TestPanelState StandardIOSection::panelState() const {
+    return TestPanelState{current_test, input_text_box->toPlainText()};
+}
+
+void StandardIOSection::restorePanelState(const QString &file_path, const TestPanelState &state) {
+    restore_file_path = file_path;
+    restore_state = state;
+}
+
+void StandardIOSection::onTestCaseSelected(int index) {
+    if (index < 0 || index == current_test) {
+        return;
+    }
+    keepCurrentInput();
+    showTestCase(index);
+}
+
+void StandardIOSection::onAddTestCase() {
+    keepCurrentInput();
+    test_cases.push_back(TestCase{std::string(), std::string(), std::string(), TestVerdict::None, -1});
+    test_cases_modified = true;
+    fillTestCaseSelector();
+    showTestCase(static_cast<int>(test_cases.size()) - 1);
+    input_text_box->setFocus();
+    scheduleSave();
+}
+
+void StandardIOSection::showTestCase(int index) {
+    current_test = index;
+    const TestCase &test_case = test_cases[index];
+    input_text_box->setPlainText(QString::fromStdString(test_case.input));
+    output_text_box->setPlainText(QString::fromStdString(test_case.last_output));
+    QComboBox *selector = execution_options_container->getTestCaseSelector();
+    QSignalBlocker blocker(selector);
+    selector->setCurrentIndex(index);
+    emit panelStateChanged();
+}
+
+void StandardIOSection::fillTestCaseSelector() {
+    QComboBox *selector = execution_options_container->getTestCaseSelector();
+    QSignalBlocker blocker(selector);
+    selector->clear();
+    for (size_t i = 0; i < test_cases.size(); i++) {
+        selector->addItem(QString("Test %1").arg(i + 1));
+    }
+}
+
+void StandardIOSection::keepCurrentInput() {
+    std::string input = input_text_box->toPlainText().toStdString();
+    if (input != test_cases[current_test].input) {
+        test_cases[current_test].input = std::move(input);
+        test_cases_modified = true;
+    }
+}
+
+void StandardIOSection::recordRun(const QString &output, TestVerdict verdict, long long time_ms) {
+    output_text_box->setPlainText(output);
+    TestCase &test_case = test_cases[current_test];
+    test_case.last_output = output.toStdString();
+    test_case.verdict = verdict;
+    test_case.time_ms = time_ms;
+    test_cases_modified = true;
+    saveTestCases();
+}
+
+void StandardIOSection::saveTestCases() {
+    save_timer->stop();
+    if (!test_cases_modified || test_file_path.isEmpty()) {
+        return;
+    }
+    test_cases_modified = false;
+    database->saveTestCases(test_file_path.toStdString(), test_cases);
+}
+
+void StandardIOSection::scheduleSave() {
+    if (!test_file_path.isEmpty()) {
+        save_timer->start();
+    }
+}
+
+void StandardIOSection::flushTestCases() {
+    keepCurrentInput();
+    saveTestCases();
 }
 
 void StandardIOSection::onRunClicked() {
@@ -54,6 +190,7 @@ void StandardIOSection::onRunClicked() {
     }
 
     // 2. Get input from the input box
+    keepCurrentInput();
     QString input = input_text_box->toPlainText();
 
     // 3. Save code to a temp file
@@ -79,16 +216,16 @@ void StandardIOSection::onRunClicked() {
     args << cppFilePath << "-o" << exeFilePath;
     compiler.start("g++", args);
     if (!compiler.waitForFinished(COMPILE_TIMEOUT_MS)) { // 10s timeout
-        output_text_box->setPlainText("Compilation timed out.");
+        recordRun("Compilation timed out.", TestVerdict::CompileError, -1);
         return;
     }
     QString compileStdErr = compiler.readAllStandardError();
     if (!compileStdErr.isEmpty()) {
-        output_text_box->setPlainText("Compilation error:\n" + compileStdErr);
+        recordRun("Compilation error:\n" + compileStdErr, TestVerdict::CompileError, -1);
         return;
     }
     if (!QFile::exists(exeFilePath)) {
-        output_text_box->setPlainText("Compilation failed: Executable not created.");
+        recordRun("Compilation failed: Executable not created.", TestVerdict::CompileError, -1);
         return;
     }
 
@@ -96,17 +233,28 @@ void StandardIOSection::onRunClicked() {
     QProcess program;
     program.setProgram(exeFilePath);
     program.setProcessChannelMode(QProcess::MergedChannels);
+    QElapsedTimer run_timer;
+    run_timer.start();
     program.start();
     if (!input.isEmpty()) {
         program.write(input.toUtf8());
         program.closeWriteChannel();
     }
     if (!program.waitForFinished(RUN_TIMEOUT_MS)) { // 10s timeout
-        output_text_box->setPlainText("Program execution timed out.");
         program.kill();
+        recordRun("Program execution timed out.", TestVerdict::TimeLimit, run_timer.elapsed());
         return;
     }
+    long long elapsed_ms = run_timer.elapsed();
     QString programOutput = program.readAllStandardOutput();
-    output_text_box->setPlainText(programOutput);
+    TestVerdict verdict = TestVerdict::Ran;
+    if (program.exitStatus() != QProcess::NormalExit || program.exitCode() != 0) {
+        verdict = TestVerdict::RuntimeError;
+    } else if (!test_cases[current_test].expected_output.empty()) {
+        // Trailing whitespace is not significant for judges either
+        QString expected = QString::fromStdString(test_cases[current_test].expected_output);
+        verdict = programOutput.trimmed() == expected.trimmed() ? TestVerdict::Accepted : TestVerdict::WrongAnswer;
+    }
+    recordRun(programOutput, verdict, elapsed_ms);
     // 6. Clean up handled by QTemporaryDir
 }
@@ -5,30 +5,67 @@
 #include <QVBoxLayout>
 #include <QWidget>
 #include <QTextEdit>
+#include <QTimer>
 #include "../../KodetronEditor/KodetronEditor.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+#include <vector>
 
+// What the session keeps of the test panel: the selected test and its input,
+// which reaches the stored suite only SAVE_DELAY_MS after the last edit
+struct TestPanelState {
+    int test_index;
+    QString input;
+};
 
 class StandardIOSection : public QWidget {
     Q_OBJECT
 
   public:
-    explicit StandardIOSection(KodetronEditor* code_editor, QWidget *parent = nullptr);
+    explicit StandardIOSection(DatabaseWorker* database, KodetronEditor* code_editor, QWidget *parent = nullptr);
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
+    TestPanelState panelState() const;
+    // Applied once the suite of file_path has been read, if that file is still open
+    void restorePanelState(const QString &file_path, const TestPanelState &state);
+    // Stores edits still waiting for the save timer, also run on quit
+    void flushTestCases();
+
+  signals:
+    void panelStateChanged();
 
   private slots:
     void onRunClicked();
+    void onFilePathChanged(const QString &file_path);
+    void onTestCaseSelected(int index);
+    void onAddTestCase();
 
   private:
+    void showTestCase(int index);
+    void keepCurrentInput();
+    void recordRun(const QString &output, TestVerdict verdict, long long time_ms);
+    void saveTestCases();
+    void scheduleSave();
+    void fillTestCaseSelector();
+
     ExecutionOptionsContainer *execution_options_container;
     QTextEdit *input_text_box;
     QTextEdit *output_text_box;
     QVBoxLayout *layout;
     KodetronEditor* code_editor;
+    DatabaseWorker* database;
+    // Test suite of the open file, restored when the file is opened and saved
+    // after each run and shortly after each edit
+    QString test_file_path;
+    std::vector<TestCase> test_cases;
+    int current_test;
+    bool test_cases_modified;
+    QString restore_file_path; // empty once applied
+    TestPanelState restore_state;
+    QTimer *save_timer;
     // Run/compile settings
     static constexpr int COMPILE_TIMEOUT_MS = 4000; // 4 seconds
     static constexpr int RUN_TIMEOUT_MS = 5000;     // 5 seconds
+    static constexpr int SAVE_DELAY_MS = 1000;      // edits are saved once typing pauses
     static constexpr const char* TEMP_CPP_FILENAME = "/temp.cpp";
     static constexpr const char* TEMP_EXE_FILENAME = "/temp_exe.exe";
 };
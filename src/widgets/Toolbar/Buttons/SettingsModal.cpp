@@ -2,8 +2,8 @@
 #include <QRegularExpression>
 #include <QRegularExpressionValidator>
 
-SettingsModal::SettingsModal(DatabaseManager* dbManager, int userId, QWidget* parent)
-    : QDialog(parent), dbManager(dbManager), currentUserId(userId), hasUnsavedChanges(false) {
+SettingsModal::SettingsModal(DatabaseWorker* database, int userId, QWidget* parent)
+    : QDialog(parent), database(database), currentUserId(userId), hasUnsavedChanges(false) {
     setWindowTitle("User Settings");
     setModal(true);
     setFixedSize(400, 300);
@@ -82,16 +82,20 @@ void SettingsModal::setupUI() {
 }
 
 void SettingsModal::loadUserData() {
-    if (dbManager->getUserById(currentUserId, originalUser)) {
-        nameEdit->setText(QString::fromStdString(originalUser.email)); // Assuming name is stored in email field for now
-        emailEdit->setText(QString::fromStdString(originalUser.email));
-        codeforcesHandleEdit->setText(QString::fromStdString(originalUser.codeforces_handle));
-        
-        hasUnsavedChanges = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to load user data.");
-        close();
-    }
+    database->fetchUser(currentUserId).then(this, [this](std::optional<User> user) {
+        if (user) {
+            originalUser = *user;
+            nameEdit->setText(QString::fromStdString(originalUser.email)); // Assuming name is stored in email field for now
+            emailEdit->setText(QString::fromStdString(originalUser.email));
+            codeforcesHandleEdit->setText(QString::fromStdString(originalUser.codeforces_handle));
+            
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to load user data.");
+            close();
+        }
+    });
 }
 
 void SettingsModal::onSaveSettings() {
@@ -160,12 +164,14 @@ void SettingsModal::applyChanges() {
     updatedUser.email = emailEdit->text().toStdString();
     updatedUser.codeforces_handle = codeforcesHandleEdit->text().toStdString();
     
-    if (dbManager->updateUser(updatedUser)) {
-        QMessageBox::information(this, "Success", "Settings saved successfully!");
-        originalUser = updatedUser;
-        hasUnsavedChanges = false;
-        updateButtonStates();
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to save settings. Please try again.");
-    }
+    database->updateUser(updatedUser).then(this, [this, updatedUser](bool updated) {
+        if (updated) {
+            QMessageBox::information(this, "Success", "Settings saved successfully!");
+            originalUser = updatedUser;
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to save settings. Please try again.");
+        }
+    });
 }
\ No newline at end of file
@@ -10,13 +10,13 @@
 #include <QPushButton>
 #include <QMessageBox>
 #include <QGroupBox>
-#include "..\Database\DataBaseManager.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
 
 class SettingsModal : public QDialog {
     Q_OBJECT
 
 public:
-    explicit SettingsModal(DatabaseManager* dbManager, int userId, QWidget* parent = nullptr);
+    explicit SettingsModal(DatabaseWorker* database, int userId, QWidget* parent = nullptr);
     ~SettingsModal();
 
 private slots:
@@ -46,7 +46,7 @@ private:
     QPushButton* closeButton;
     
     // Data
-    DatabaseManager* dbManager;
+    DatabaseWorker* database;
     int currentUserId;
     User originalUser;
     bool hasUnsavedChanges;
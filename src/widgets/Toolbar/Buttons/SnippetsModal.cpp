@@ -1,8 +1,9 @@
 #include "SnippetsModal.h"
+#include "../../../Snippets/SnippetEngine/SnippetEngine.h"
 
-SnippetsModal::SnippetsModal(DatabaseManager* dbManager, int userId, QWidget* parent)
-    : QDialog(parent), dbManager(dbManager), currentUserId(userId), 
-      currentSnippetIndex(-1), hasUnsavedChanges(false) {
+SnippetsModal::SnippetsModal(DatabaseWorker* database, int userId, QWidget* parent)
+    : QDialog(parent), database(database), currentUserId(userId), 
+      currentSnippetId(-1), hasUnsavedChanges(false), searchSerial(0) {
     setWindowTitle("Snippets Manager");
     setModal(true);
     resize(800, 600);
@@ -20,12 +21,28 @@ void SnippetsModal::setupUI() {
     // Create splitter for list and editor
     splitter = new QSplitter(Qt::Horizontal, this);
     
-    // Left side - Snippets list
-    snippetsList = new QListWidget();
-    snippetsList->setMinimumWidth(250);
-    snippetsList->setMaximumWidth(350);
-    connect(snippetsList, &QListWidget::currentRowChanged, this, &SnippetsModal::onSnippetSelectionChanged);
-    splitter->addWidget(snippetsList);
+    // Left side - Search box over the snippets list
+    QWidget* listWidget = new QWidget();
+    QVBoxLayout* listLayout = new QVBoxLayout(listWidget);
+    listLayout->setContentsMargins(0, 0, 0, 0);
+    listWidget->setMinimumWidth(250);
+    listWidget->setMaximumWidth(350);
+
+    searchEdit = new QLineEdit();
+    searchEdit->setPlaceholderText("Search snippets...");
+    searchEdit->setClearButtonEnabled(true);
+    connect(searchEdit, &QLineEdit::textChanged, this, &SnippetsModal::onSearchTextChanged);
+
+    snippetsModel = new ContentListModel(this);
+    snippetsList = new QListView();
+    snippetsList->setModel(snippetsModel);
+    snippetsList->setItemDelegate(new ContentListDelegate(snippetsList));
+    snippetsList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    connect(snippetsList->selectionModel(), &QItemSelectionModel::currentChanged, this, &SnippetsModal::onSnippetSelectionChanged);
+
+    listLayout->addWidget(searchEdit);
+    listLayout->addWidget(snippetsList);
+    splitter->addWidget(listWidget);
     
     // Right side - Editor
     QWidget* editorWidget = new QWidget();
@@ -76,29 +93,63 @@ void SnippetsModal::setupUI() {
 }
 
 void SnippetsModal::loadSnippets() {
-    snippetsList->clear();
-    snippets = dbManager->getSnippetsByUserId(currentUserId);
-    
-    for (const auto& snippet : snippets) {
-        snippetsList->addItem(QString::fromStdString(snippet.name));
+    // The dialog is shown right away and filled in when the list arrives. Only
+    // names and sizes are read, so opening costs the same for any content size.
+    // Edits afterwards patch single rows of the model instead of reloading.
+    database->fetchSnippetSummaries(currentUserId).then(this, [this](std::vector<ContentSummary> loadedSnippets) {
+        snippetsModel->setSummaries(std::move(loadedSnippets));
+        // Keeps an active search applied to the loaded list
+        onSearchTextChanged(searchEdit->text());
+        clearEditor();
+    });
+}
+
+void SnippetsModal::onSearchTextChanged(const QString& text) {
+    int serial = ++searchSerial;
+    if (text.trimmed().isEmpty()) {
+        snippetsModel->clearSearch();
+        return;
+    }
+    database->searchSnippets(currentUserId, text.toStdString(), SEARCH_LIMIT).then(this, [this, serial](std::vector<SearchHit> hits) {
+        // Answers to earlier keystrokes can arrive after newer ones
+        if (serial != searchSerial) {
+            return;
+        }
+        snippetsModel->showSearchHits(std::move(hits));
+    });
+}
+
+void SnippetsModal::refreshSearch() {
+    // Hits are ranked against the text, so an edit can reorder or add them
+    if (snippetsModel->isSearching()) {
+        onSearchTextChanged(searchEdit->text());
     }
-    
-    clearEditor();
 }
 
 void SnippetsModal::onSnippetSelectionChanged() {
-    int currentRow = snippetsList->currentRow();
-    
-    if (currentRow >= 0 && currentRow < static_cast<int>(snippets.size())) {
-        currentSnippetIndex = currentRow;
-        const Snippet& snippet = snippets[currentSnippetIndex];
-        
-        snippetNameEdit->setText(QString::fromStdString(snippet.name));
-        snippetContentEdit->setPlainText(QString::fromStdString(snippet.content));
-        
+    QModelIndex current = snippetsList->currentIndex();
+    int selectedId = current.isValid() ? current.data(ContentListModel::IdRole).toInt() : -1;
+    const ContentSummary* selected = snippetsModel->summaryFor(selectedId);
+    
+    if (selected) {
+        currentSnippetId = selectedId;
+        snippetNameEdit->setText(QString::fromStdString(selected->name));
+        snippetContentEdit->clear();
+        snippetContentEdit->setReadOnly(true);
         hasUnsavedChanges = false;
+
+        database->fetchSnippetContent(selectedId).then(this, [this, selectedId](std::optional<std::string> content) {
+            // The selection may have moved on while the content was read
+            if (currentSnippetId != selectedId) {
+                return;
+            }
+            snippetContentEdit->setPlainText(QString::fromStdString(content.value_or(std::string())));
+            snippetContentEdit->setReadOnly(false);
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        });
     } else {
-        currentSnippetIndex = -1;
+        currentSnippetId = -1;
         clearEditor();
     }
     
@@ -113,52 +164,69 @@ void SnippetsModal::onCreateSnippet() {
     std::string name = snippetNameEdit->text().toStdString();
     std::string content = snippetContentEdit->toPlainText().toStdString();
     
-    if (dbManager->createSnippet(name, content, currentUserId)) {
-        QMessageBox::information(this, "Success", "Snippet created successfully!");
-        loadSnippets();
-        clearEditor();
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to create snippet. Name might already exist.");
-    }
+    Snippet newSnippet{-1, name, content, currentUserId};
+    database->createSnippet(newSnippet).then(this, [this, newSnippet](std::optional<ContentSummary> created) {
+        if (created) {
+            SnippetEngine::instance().upsert(Snippet{created->id, newSnippet.name, newSnippet.content, newSnippet.user_id});
+            QMessageBox::information(this, "Success", "Snippet created successfully!");
+            snippetsModel->upsert(*created);
+            refreshSearch();
+            snippetsList->setCurrentIndex(snippetsModel->indexFor(created->id));
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to create snippet. Name might already exist.");
+        }
+    });
 }
 
 void SnippetsModal::onUpdateSnippet() {
-    if (currentSnippetIndex < 0 || !validateSnippetData()) {
+    if (currentSnippetId < 0 || !validateSnippetData()) {
         return;
     }
     
-    Snippet updatedSnippet = snippets[currentSnippetIndex];
-    updatedSnippet.name = snippetNameEdit->text().toStdString();
-    updatedSnippet.content = snippetContentEdit->toPlainText().toStdString();
+    Snippet updatedSnippet{
+        currentSnippetId, snippetNameEdit->text().toStdString(),
+        snippetContentEdit->toPlainText().toStdString(), currentUserId};
     
-    if (dbManager->updateSnippet(updatedSnippet)) {
-        QMessageBox::information(this, "Success", "Snippet updated successfully!");
-        loadSnippets();
-        hasUnsavedChanges = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to update snippet.");
-    }
+    database->updateSnippet(updatedSnippet).then(this, [this, updatedSnippet](std::optional<ContentSummary> updated) {
+        if (updated) {
+            SnippetEngine::instance().upsert(updatedSnippet);
+            QMessageBox::information(this, "Success", "Snippet updated successfully!");
+            snippetsModel->upsert(*updated);
+            refreshSearch();
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to update snippet.");
+        }
+    });
 }
 
 void SnippetsModal::onDeleteSnippet() {
-    if (currentSnippetIndex < 0) {
+    if (currentSnippetId < 0) {
         return;
     }
     
-    const Snippet& snippet = snippets[currentSnippetIndex];
+    const ContentSummary* snippet = snippetsModel->summaryFor(currentSnippetId);
+    if (!snippet) {
+        return;
+    }
     
     int reply = QMessageBox::question(this, "Confirm Delete", 
         QString("Are you sure you want to delete the snippet '%1'?")
-        .arg(QString::fromStdString(snippet.name)),
+        .arg(QString::fromStdString(snippet->name)),
         QMessageBox::Yes | QMessageBox::No);
     
     if (reply == QMessageBox::Yes) {
-        if (dbManager->deleteSnippet(snippet.id)) {
-            QMessageBox::information(this, "Success", "Snippet deleted successfully!");
-            loadSnippets();
-        } else {
-            QMessageBox::warning(this, "Error", "Failed to delete snippet.");
-        }
+        int snippetId = snippet->id;
+        database->deleteSnippet(snippetId).then(this, [this, snippetId](bool deleted) {
+            if (deleted) {
+                SnippetEngine::instance().remove(snippetId);
+                QMessageBox::information(this, "Success", "Snippet deleted successfully!");
+                snippetsModel->remove(snippetId);
+            } else {
+                QMessageBox::warning(this, "Error", "Failed to delete snippet.");
+            }
+        });
     }
 }
 
@@ -175,11 +243,12 @@ void SnippetsModal::onSnippetContentChanged() {
 void SnippetsModal::clearEditor() {
     snippetNameEdit->clear();
     snippetContentEdit->clear();
+    snippetContentEdit->setReadOnly(false);
     hasUnsavedChanges = false;
 }
 
 void SnippetsModal::updateButtonStates() {
-    bool hasSelection = currentSnippetIndex >= 0;
+    bool hasSelection = currentSnippetId >= 0;
     bool hasContent = !snippetNameEdit->text().isEmpty() && !snippetContentEdit->toPlainText().isEmpty();
     
     createButton->setEnabled(hasContent);
@@ -188,21 +257,26 @@ void SnippetsModal::updateButtonStates() {
 }
 
 void SnippetsModal::saveCurrentSnippet() {
-    if (currentSnippetIndex < 0 || !validateSnippetData()) {
+    if (currentSnippetId < 0 || !validateSnippetData()) {
         return;
     }
 
-    Snippet updatedSnippet = snippets[currentSnippetIndex];
-    updatedSnippet.name = snippetNameEdit->text().toStdString();
-    updatedSnippet.content = snippetContentEdit->toPlainText().toStdString();
+    Snippet updatedSnippet{
+        currentSnippetId, snippetNameEdit->text().toStdString(),
+        snippetContentEdit->toPlainText().toStdString(), currentUserId};
 
-    if (dbManager->updateSnippet(updatedSnippet)) {
-        QMessageBox::information(this, "Success", "Snippet saved successfully!");
-        loadSnippets();
-        hasUnsavedChanges = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to save snippet.");
-    }
+    database->updateSnippet(updatedSnippet).then(this, [this, updatedSnippet](std::optional<ContentSummary> updated) {
+        if (updated) {
+            SnippetEngine::instance().upsert(updatedSnippet);
+            QMessageBox::information(this, "Success", "Snippet saved successfully!");
+            snippetsModel->upsert(*updated);
+            refreshSearch();
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to save snippet.");
+        }
+    });
 }
 
 bool SnippetsModal::validateSnippetData() {
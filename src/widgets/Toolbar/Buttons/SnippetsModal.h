@@ -4,7 +4,7 @@
 #include <QDialog>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QTextEdit>
 #include <QLineEdit>
@@ -12,13 +12,14 @@
 #include <QMessageBox>
 #include <QSplitter>
 #include <vector>
-#include "..\Database\DataBaseManager.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../ContentListModel/ContentListModel.h"
 
 class SnippetsModal : public QDialog {
     Q_OBJECT
 
 public:
-    explicit SnippetsModal(DatabaseManager* dbManager, int userId, QWidget* parent = nullptr);
+    explicit SnippetsModal(DatabaseWorker* database, int userId, QWidget* parent = nullptr);
     ~SnippetsModal();
 
 private slots:
@@ -28,10 +29,12 @@ private slots:
     void onDeleteSnippet();
     void onSnippetNameChanged();
     void onSnippetContentChanged();
+    void onSearchTextChanged(const QString& text);
 
 private:
     void setupUI();
     void loadSnippets();
+    void refreshSearch();
     void clearEditor();
     void updateButtonStates();
     void saveCurrentSnippet();
@@ -42,7 +45,9 @@ private:
     QHBoxLayout* buttonLayout;
     QSplitter* splitter;
     
-    QListWidget* snippetsList;
+    QLineEdit* searchEdit;
+    QListView* snippetsList;
+    ContentListModel* snippetsModel;
     QVBoxLayout* editorLayout;
     QLineEdit* snippetNameEdit;
     QTextEdit* snippetContentEdit;
@@ -53,15 +58,17 @@ private:
     QPushButton* closeButton;
     
     // Data
-    DatabaseManager* dbManager;
+    DatabaseWorker* database;
     int currentUserId;
-    std::vector<Snippet> snippets;
-    int currentSnippetIndex;
+    int currentSnippetId; // -1 without a selection; content is read when a row is selected
     bool hasUnsavedChanges;
+    int searchSerial; // bumped per keystroke, older search results are dropped
     
     // Labels
     QLabel* nameLabel;
     QLabel* contentLabel;
+
+    static constexpr int SEARCH_LIMIT = 50;
 };
 
 #endif
\ No newline at end of file
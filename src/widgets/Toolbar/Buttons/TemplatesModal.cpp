@@ -1,8 +1,9 @@
 #include "TemplatesModal.h"
+#include "../../../Templates/TemplateCache/TemplateCache.h"
 
-TemplatesModal::TemplatesModal(DatabaseManager* dbManager, int userId, QWidget* parent)
-    : QDialog(parent), dbManager(dbManager), currentUserId(userId), 
-      currentTemplateIndex(-1), hasUnsavedChanges(false) {
+TemplatesModal::TemplatesModal(DatabaseWorker* database, int userId, QWidget* parent)
+    : QDialog(parent), database(database), currentUserId(userId), 
+      currentTemplateId(-1), hasUnsavedChanges(false), searchSerial(0) {
     setWindowTitle("Templates Manager");
     setModal(true);
     resize(800, 600);
@@ -20,12 +21,28 @@ void TemplatesModal::setupUI() {
     // Create splitter for list and editor
     splitter = new QSplitter(Qt::Horizontal, this);
     
-    // Left side - Templates list
-    templatesList = new QListWidget();
-    templatesList->setMinimumWidth(250);
-    templatesList->setMaximumWidth(350);
-    connect(templatesList, &QListWidget::currentRowChanged, this, &TemplatesModal::onTemplateSelectionChanged);
-    splitter->addWidget(templatesList);
+    // Left side - Search box over the templates list
+    QWidget* listWidget = new QWidget();
+    QVBoxLayout* listLayout = new QVBoxLayout(listWidget);
+    listLayout->setContentsMargins(0, 0, 0, 0);
+    listWidget->setMinimumWidth(250);
+    listWidget->setMaximumWidth(350);
+
+    searchEdit = new QLineEdit();
+    searchEdit->setPlaceholderText("Search templates...");
+    searchEdit->setClearButtonEnabled(true);
+    connect(searchEdit, &QLineEdit::textChanged, this, &TemplatesModal::onSearchTextChanged);
+
+    templatesModel = new ContentListModel(this);
+    templatesList = new QListView();
+    templatesList->setModel(templatesModel);
+    templatesList->setItemDelegate(new ContentListDelegate(templatesList));
+    templatesList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    connect(templatesList->selectionModel(), &QItemSelectionModel::currentChanged, this, &TemplatesModal::onTemplateSelectionChanged);
+
+    listLayout->addWidget(searchEdit);
+    listLayout->addWidget(templatesList);
+    splitter->addWidget(listWidget);
     
     // Right side - Editor
     QWidget* editorWidget = new QWidget();
@@ -76,29 +93,63 @@ void TemplatesModal::setupUI() {
 }
 
 void TemplatesModal::loadTemplates() {
-    templatesList->clear();
-    templates = dbManager->getTemplatesByUserId(currentUserId);
-    
-    for (const auto& template_obj : templates) {
-        templatesList->addItem(QString::fromStdString(template_obj.name));
+    // The dialog is shown right away and filled in when the list arrives. Only
+    // names and sizes are read, so opening costs the same for any content size.
+    // Edits afterwards patch single rows of the model instead of reloading.
+    database->fetchTemplateSummaries(currentUserId).then(this, [this](std::vector<ContentSummary> loadedTemplates) {
+        templatesModel->setSummaries(std::move(loadedTemplates));
+        // Keeps an active search applied to the loaded list
+        onSearchTextChanged(searchEdit->text());
+        clearEditor();
+    });
+}
+
+void TemplatesModal::onSearchTextChanged(const QString& text) {
+    int serial = ++searchSerial;
+    if (text.trimmed().isEmpty()) {
+        templatesModel->clearSearch();
+        return;
+    }
+    database->searchTemplates(currentUserId, text.toStdString(), SEARCH_LIMIT).then(this, [this, serial](std::vector<SearchHit> hits) {
+        // Answers to earlier keystrokes can arrive after newer ones
+        if (serial != searchSerial) {
+            return;
+        }
+        templatesModel->showSearchHits(std::move(hits));
+    });
+}
+
+void TemplatesModal::refreshSearch() {
+    // Hits are ranked against the text, so an edit can reorder or add them
+    if (templatesModel->isSearching()) {
+        onSearchTextChanged(searchEdit->text());
     }
-    
-    clearEditor();
 }
 
 void TemplatesModal::onTemplateSelectionChanged() {
-    int currentRow = templatesList->currentRow();
-    
-    if (currentRow >= 0 && currentRow < static_cast<int>(templates.size())) {
-        currentTemplateIndex = currentRow;
-        const Template& template_obj = templates[currentTemplateIndex];
-        
-        templateNameEdit->setText(QString::fromStdString(template_obj.name));
-        templateContentEdit->setPlainText(QString::fromStdString(template_obj.content));
-        
+    QModelIndex current = templatesList->currentIndex();
+    int selectedId = current.isValid() ? current.data(ContentListModel::IdRole).toInt() : -1;
+    const ContentSummary* selected = templatesModel->summaryFor(selectedId);
+    
+    if (selected) {
+        currentTemplateId = selectedId;
+        templateNameEdit->setText(QString::fromStdString(selected->name));
+        templateContentEdit->clear();
+        templateContentEdit->setReadOnly(true);
         hasUnsavedChanges = false;
+
+        database->fetchTemplateContent(selectedId).then(this, [this, selectedId](std::optional<std::string> content) {
+            // The selection may have moved on while the content was read
+            if (currentTemplateId != selectedId) {
+                return;
+            }
+            templateContentEdit->setPlainText(QString::fromStdString(content.value_or(std::string())));
+            templateContentEdit->setReadOnly(false);
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        });
     } else {
-        currentTemplateIndex = -1;
+        currentTemplateId = -1;
         clearEditor();
     }
     
@@ -113,52 +164,69 @@ void TemplatesModal::onCreateTemplate() {
     std::string name = templateNameEdit->text().toStdString();
     std::string content = templateContentEdit->toPlainText().toStdString();
     
-    if (dbManager->createTemplate(name, content, currentUserId)) {
-        QMessageBox::information(this, "Success", "Template created successfully!");
-        loadTemplates();
-        clearEditor();
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to create template.");
-    }
+    Template newTemplate{-1, name, content, currentUserId};
+    database->createTemplate(newTemplate).then(this, [this, newTemplate](std::optional<ContentSummary> created) {
+        if (created) {
+            TemplateCache::instance().upsert(Template{created->id, newTemplate.name, newTemplate.content, newTemplate.user_id});
+            QMessageBox::information(this, "Success", "Template created successfully!");
+            templatesModel->upsert(*created);
+            refreshSearch();
+            templatesList->setCurrentIndex(templatesModel->indexFor(created->id));
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to create template.");
+        }
+    });
 }
 
 void TemplatesModal::onUpdateTemplate() {
-    if (currentTemplateIndex < 0 || !validateTemplateData()) {
+    if (currentTemplateId < 0 || !validateTemplateData()) {
         return;
     }
     
-    Template updatedTemplate = templates[currentTemplateIndex];
-    updatedTemplate.name = templateNameEdit->text().toStdString();
-    updatedTemplate.content = templateContentEdit->toPlainText().toStdString();
+    Template updatedTemplate{
+        currentTemplateId, templateNameEdit->text().toStdString(),
+        templateContentEdit->toPlainText().toStdString(), currentUserId};
     
-    if (dbManager->updateTemplate(updatedTemplate)) {
-        QMessageBox::information(this, "Success", "Template updated successfully!");
-        loadTemplates();
-        hasUnsavedChanges = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to update template.");
-    }
+    database->updateTemplate(updatedTemplate).then(this, [this, updatedTemplate](std::optional<ContentSummary> updated) {
+        if (updated) {
+            TemplateCache::instance().upsert(updatedTemplate);
+            QMessageBox::information(this, "Success", "Template updated successfully!");
+            templatesModel->upsert(*updated);
+            refreshSearch();
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to update template.");
+        }
+    });
 }
 
 void TemplatesModal::onDeleteTemplate() {
-    if (currentTemplateIndex < 0) {
+    if (currentTemplateId < 0) {
         return;
     }
     
-    const Template& template_obj = templates[currentTemplateIndex];
+    const ContentSummary* template_obj = templatesModel->summaryFor(currentTemplateId);
+    if (!template_obj) {
+        return;
+    }
     
     int reply = QMessageBox::question(this, "Confirm Delete", 
         QString("Are you sure you want to delete the template '%1'?")
-        .arg(QString::fromStdString(template_obj.name)),
+        .arg(QString::fromStdString(template_obj->name)),
         QMessageBox::Yes | QMessageBox::No);
     
     if (reply == QMessageBox::Yes) {
-        if (dbManager->deleteTemplate(template_obj.id)) {
-            QMessageBox::information(this, "Success", "Template deleted successfully!");
-            loadTemplates();
-        } else {
-            QMessageBox::warning(this, "Error", "Failed to delete template.");
-        }
+        int templateId = template_obj->id;
+        database->deleteTemplate(templateId).then(this, [this, templateId](bool deleted) {
+            if (deleted) {
+                TemplateCache::instance().remove(templateId);
+                QMessageBox::information(this, "Success", "Template deleted successfully!");
+                templatesModel->remove(templateId);
+            } else {
+                QMessageBox::warning(this, "Error", "Failed to delete template.");
+            }
+        });
     }
 }
 
@@ -175,29 +243,35 @@ void TemplatesModal::onTemplateContentChanged() {
 void TemplatesModal::clearEditor() {
     templateNameEdit->clear();
     templateContentEdit->clear();
+    templateContentEdit->setReadOnly(false);
     hasUnsavedChanges = false;
 }
 
 void TemplatesModal::saveCurrentTemplate() {
-    if (currentTemplateIndex < 0 || !validateTemplateData()) {
+    if (currentTemplateId < 0 || !validateTemplateData()) {
         return;
     }
 
-    Template updatedTemplate = templates[currentTemplateIndex];
-    updatedTemplate.name = templateNameEdit->text().toStdString();
-    updatedTemplate.content = templateContentEdit->toPlainText().toStdString();
+    Template updatedTemplate{
+        currentTemplateId, templateNameEdit->text().toStdString(),
+        templateContentEdit->toPlainText().toStdString(), currentUserId};
 
-    if (dbManager->updateTemplate(updatedTemplate)) {
-        QMessageBox::information(this, "Success", "Template saved successfully!");
-        loadTemplates();
-        hasUnsavedChanges = false;
-    } else {
-        QMessageBox::warning(this, "Error", "Failed to save template.");
-    }
+    database->updateTemplate(updatedTemplate).then(this, [this, updatedTemplate](std::optional<ContentSummary> updated) {
+        if (updated) {
+            TemplateCache::instance().upsert(updatedTemplate);
+            QMessageBox::information(this, "Success", "Template saved successfully!");
+            templatesModel->upsert(*updated);
+            refreshSearch();
+            hasUnsavedChanges = false;
+            updateButtonStates();
+        } else {
+            QMessageBox::warning(this, "Error", "Failed to save template.");
+        }
+    });
 }
 
 void TemplatesModal::updateButtonStates() {
-    bool hasSelection = currentTemplateIndex >= 0;
+    bool hasSelection = currentTemplateId >= 0;
     bool hasContent = !templateNameEdit->text().isEmpty() && !templateContentEdit->toPlainText().isEmpty();
     
     createButton->setEnabled(hasContent);
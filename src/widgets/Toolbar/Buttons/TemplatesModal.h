@@ -4,7 +4,7 @@
 #include <QDialog>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QTextEdit>
 #include <QLineEdit>
@@ -12,13 +12,14 @@
 #include <QMessageBox>
 #include <QSplitter>
 #include <vector>
-#include "..\Database\DataBaseManager.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
+#include "../ContentListModel/ContentListModel.h"
 
 class TemplatesModal : public QDialog {
     Q_OBJECT
 
 public:
-    explicit TemplatesModal(DatabaseManager* dbManager, int userId, QWidget* parent = nullptr);
+    explicit TemplatesModal(DatabaseWorker* database, int userId, QWidget* parent = nullptr);
     ~TemplatesModal();
 
 private slots:
@@ -28,10 +29,12 @@ private slots:
     void onDeleteTemplate();
     void onTemplateNameChanged();
     void onTemplateContentChanged();
+    void onSearchTextChanged(const QString& text);
 
 private:
     void setupUI();
     void loadTemplates();
+    void refreshSearch();
     void clearEditor();
     void updateButtonStates();
     void saveCurrentTemplate();
@@ -42,7 +45,9 @@ private:
     QHBoxLayout* buttonLayout;
     QSplitter* splitter;
     
-    QListWidget* templatesList;
+    QLineEdit* searchEdit;
+    QListView* templatesList;
+    ContentListModel* templatesModel;
     QVBoxLayout* editorLayout;
     QLineEdit* templateNameEdit;
     QTextEdit* templateContentEdit;
@@ -53,15 +58,17 @@ private:
     QPushButton* closeButton;
     
     // Data
-    DatabaseManager* dbManager;
+    DatabaseWorker* database;
     int currentUserId;
-    std::vector<Template> templates;
-    int currentTemplateIndex;
+    int currentTemplateId; // -1 without a selection; content is read when a row is selected
     bool hasUnsavedChanges;
+    int searchSerial; // bumped per keystroke, older search results are dropped
     
     // Labels
     QLabel* nameLabel;
     QLabel* contentLabel;
+
+    static constexpr int SEARCH_LIMIT = 50;
 };
 
 #endif // TEMPLATESMODAL_H
\ No newline at end of file
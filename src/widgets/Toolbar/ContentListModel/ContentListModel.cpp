@@ -0,0 +1,212 @@
+#include "ContentListModel.h"
+#include "../../../Database/FtsQuery/FtsQuery.h"
+#include <QAbstractTextDocumentLayout>
+#include <QApplication>
+#include <QDateTime>
+#include <QLocale>
+#include <QPainter>
+#include <QTextDocument>
+#include <algorithm>
+
+ContentListModel::ContentListModel(QObject *parent) : QAbstractListModel(parent), searching(false) {}
+
+void ContentListModel::setSummaries(std::vector<ContentSummary> new_summaries) {
+    beginResetModel();
+    summaries = std::move(new_summaries);
+    hits.clear();
+    searching = false;
+    endResetModel();
+}
+
+void ContentListModel::upsert(const ContentSummary &summary) {
+    auto existing = findSummary(summary.id);
+    if (existing == summaries.end()) {
+        int row = static_cast<int>(sortedRow(summary.name));
+        if (!searching) {
+            beginInsertRows(QModelIndex(), row, row);
+        }
+        summaries.insert(summaries.begin() + row, summary);
+        if (!searching) {
+            endInsertRows();
+        }
+        return;
+    }
+
+    int from = static_cast<int>(existing - summaries.begin());
+    if (existing->name == summary.name) {
+        summaries[from] = summary;
+        if (!searching) {
+            emit dataChanged(index(from), index(from));
+        }
+        return;
+    }
+
+    // A rename moves the row to keep the name order; to is the row once it is taken out
+    size_t position = sortedRow(summary.name);
+    int to = static_cast<int>(position) - (from < static_cast<int>(position) ? 1 : 0);
+    bool moves = !searching && to != from && beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+    summaries.erase(summaries.begin() + from);
+    summaries.insert(summaries.begin() + to, summary);
+    if (moves) {
+        endMoveRows();
+    }
+    if (!searching) {
+        emit dataChanged(index(to), index(to));
+    }
+}
+
+void ContentListModel::remove(int id) {
+    auto existing = findSummary(id);
+    if (existing != summaries.end()) {
+        int row = static_cast<int>(existing - summaries.begin());
+        if (!searching) {
+            beginRemoveRows(QModelIndex(), row, row);
+        }
+        summaries.erase(existing);
+        if (!searching) {
+            endRemoveRows();
+        }
+    }
+    if (!searching) {
+        return;
+    }
+    auto hit = std::find_if(hits.begin(), hits.end(), [id](const SearchHit &candidate) { return candidate.id == id; });
+    if (hit != hits.end()) {
+        int row = static_cast<int>(hit - hits.begin());
+        beginRemoveRows(QModelIndex(), row, row);
+        hits.erase(hit);
+        endRemoveRows();
+    }
+}
+
+void ContentListModel::showSearchHits(std::vector<SearchHit> new_hits) {
+    beginResetModel();
+    hits = std::move(new_hits);
+    searching = true;
+    endResetModel();
+}
+
+void ContentListModel::clearSearch() {
+    if (!searching) {
+        return;
+    }
+    beginResetModel();
+    hits.clear();
+    searching = false;
+    endResetModel();
+}
+
+bool ContentListModel::isSearching() const {
+    return searching;
+}
+
+const ContentSummary *ContentListModel::summaryFor(int id) const {
+    auto existing = findSummary(id);
+    return existing != summaries.end() ? &*existing : nullptr;
+}
+
+QModelIndex ContentListModel::indexFor(int id) const {
+    if (searching) {
+        auto hit = std::find_if(hits.begin(), hits.end(), [id](const SearchHit &candidate) { return candidate.id == id; });
+        return hit != hits.end() ? index(static_cast<int>(hit - hits.begin())) : QModelIndex();
+    }
+    auto existing = findSummary(id);
+    return existing != summaries.end() ? index(static_cast<int>(existing - summaries.begin())) : QModelIndex();
+}
+
+int ContentListModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(searching ? hits.size() : summaries.size());
+}
+
+QVariant ContentListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+    if (searching) {
+        const SearchHit &hit = hits[index.row()];
+        switch (role) {
+        case IdRole:
+            return hit.id;
+        case MarkupRole:
+            return QString::fromStdString(FtsQuery::markedToHtml(hit.name) + "<br><small>" + FtsQuery::markedToHtml(hit.excerpt) + "</small>");
+        case Qt::AccessibleTextRole:
+            if (const ContentSummary *summary = summaryFor(hit.id)) {
+                return QString::fromStdString(summary->name);
+            }
+            return QVariant();
+        default:
+            return QVariant();
+        }
+    }
+
+    const ContentSummary &summary = summaries[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::AccessibleTextRole:
+        return QString::fromStdString(summary.name);
+    case IdRole:
+        return summary.id;
+    case Qt::ToolTipRole: {
+        QString updated = summary.updated_at > 0 ? QDateTime::fromSecsSinceEpoch(summary.updated_at).toString("yyyy-MM-dd hh:mm") : QString("unknown");
+        return QString("%1, updated %2").arg(QLocale().formattedDataSize(summary.size), updated);
+    }
+    default:
+        return QVariant();
+    }
+}
+
+std::vector<ContentSummary>::const_iterator ContentListModel::findSummary(int id) const {
+    return std::find_if(summaries.begin(), summaries.end(), [id](const ContentSummary &summary) { return summary.id == id; });
+}
+
+size_t ContentListModel::sortedRow(const std::string &name) const {
+    auto position = std::upper_bound(summaries.begin(), summaries.end(), name, [](const std::string &value, const ContentSummary &summary) {
+        return value < summary.name;
+    });
+    return static_cast<size_t>(position - summaries.begin());
+}
+
+ContentListDelegate::ContentListDelegate(QObject *parent) : QStyledItemDelegate(parent) {}
+
+void ContentListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    QString markup = index.data(ContentListModel::MarkupRole).toString();
+    if (markup.isEmpty()) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+    QStyleOptionViewItem item_option = option;
+    initStyleOption(&item_option, index);
+    item_option.text.clear();
+    QStyle *style = item_option.widget ? item_option.widget->style() : QApplication::style();
+    // Background, selection and focus as for any other row
+    style->drawControl(QStyle::CE_ItemViewItem, &item_option, painter, item_option.widget);
+
+    QTextDocument document;
+    document.setDefaultFont(option.font);
+    document.setHtml(markup);
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.palette = option.palette;
+    if (option.state & QStyle::State_Selected) {
+        context.palette.setColor(QPalette::Text, option.palette.color(QPalette::HighlightedText));
+    }
+    QRect text_rect = style->subElementRect(QStyle::SE_ItemViewItemText, &item_option, item_option.widget);
+    painter->save();
+    painter->translate(text_rect.topLeft());
+    painter->setClipRect(text_rect.translated(-text_rect.topLeft()));
+    document.documentLayout()->draw(painter, context);
+    painter->restore();
+}
+
+QSize ContentListDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    QString markup = index.data(ContentListModel::MarkupRole).toString();
+    if (markup.isEmpty()) {
+        return QStyledItemDelegate::sizeHint(option, index);
+    }
+    QTextDocument document;
+    document.setDefaultFont(option.font);
+    document.setHtml(markup);
+    return QSize(static_cast<int>(document.idealWidth()), static_cast<int>(document.size().height()));
+}
@@ -0,0 +1,54 @@
+#ifndef CONTENTLISTMODEL_H
+#define CONTENTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <vector>
+#include "../../../Database/DataBaseManager.h"
+
+// Snippet or template list for the Toolbar managers. Loaded once when the
+// dialog opens; afterwards each create, update or delete is applied as a
+// single-row insert, change, move or removal, so the view keeps its
+// selection and scroll position.
+//
+// While a search is shown the rows are the hits in rank order instead.
+// Deltas still go to the summaries, and a removed row also leaves the hits.
+class ContentListModel : public QAbstractListModel {
+    Q_OBJECT
+
+  public:
+    enum Role { IdRole = Qt::UserRole, MarkupRole };
+
+    explicit ContentListModel(QObject *parent = nullptr);
+    void setSummaries(std::vector<ContentSummary> new_summaries); // sorted by name, as listed by the database
+    void upsert(const ContentSummary &summary);
+    void remove(int id);
+    void showSearchHits(std::vector<SearchHit> new_hits);
+    void clearSearch();
+    bool isSearching() const;
+    const ContentSummary *summaryFor(int id) const;
+    QModelIndex indexFor(int id) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  private:
+    std::vector<ContentSummary>::const_iterator findSummary(int id) const;
+    size_t sortedRow(const std::string &name) const;
+
+    std::vector<ContentSummary> summaries; // by name, byte order like SQLite's BINARY collation
+    std::vector<SearchHit> hits;
+    bool searching;
+};
+
+// Draws search hits from their MarkupRole rich text, other rows as usual
+class ContentListDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+  public:
+    explicit ContentListDelegate(QObject *parent = nullptr);
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
+#endif // CONTENTLISTMODEL_H
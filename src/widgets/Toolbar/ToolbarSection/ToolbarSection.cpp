@@ -1,5 +1,4 @@
 #include "ToolbarSection.h"
-#include "../../../utils/StyleLoader/StyleReader.h"
 
 QToolButton *ToolbarSection::createToolButton(const QString &iconPath, const QString &toolTip) {
     QToolButton *button = new QToolButton(this);
@@ -8,9 +7,9 @@ QToolButton *ToolbarSection::createToolButton(const QString &iconPath, const QSt
     return button;
 }
 
-ToolbarSection::ToolbarSection(DatabaseManager* dbManager, int userId, QWidget *parent):
+ToolbarSection::ToolbarSection(DatabaseWorker* database, int userId, QWidget *parent):
     QWidget(parent),
-    dbManager(dbManager), 
+    database(database), 
     currentUserId(userId),
     settingsModal(nullptr), // Initialize modal pointers to nullptr
     snippetsModal(nullptr),
@@ -38,26 +37,25 @@ ToolbarSection::ToolbarSection(DatabaseManager* dbManager, int userId, QWidget *
     setAttribute(Qt::WA_StyledBackground, true);
     assignObjectNames();
     applyQtStyles();
-    loadStyleSheet();
 }
 void ToolbarSection::openSnippets() {
     if (!snippetsModal) {
         // Create the SnippetsModal if it hasn't been created yet
-        snippetsModal = new SnippetsModal(dbManager, currentUserId, this);
+        snippetsModal = new SnippetsModal(database, currentUserId, this);
     }
     snippetsModal->exec();
 }
 void ToolbarSection::openTemplates() {
     if (!templatesModal) {
         // Create the TemplatesModal if it hasn't been created yet
-        templatesModal = new TemplatesModal(dbManager, currentUserId, this);
+        templatesModal = new TemplatesModal(database, currentUserId, this);
     }
     templatesModal->exec();
 }
 void ToolbarSection::openSettings() {
     if (!settingsModal) {
         // Create the SettingsModal if it hasn't been created yet
-        settingsModal = new SettingsModal(dbManager, currentUserId, this);
+        settingsModal = new SettingsModal(database, currentUserId, this);
     }
     settingsModal->exec();
 }
@@ -74,9 +72,3 @@ void ToolbarSection::applyQtStyles() {
   open_templates_button->setCursor(Qt::PointingHandCursor);
   open_settings_button->setCursor(Qt::PointingHandCursor);
 }
-void ToolbarSection::loadStyleSheet() {
-    QString styleSheet = StyleLoader::read("../src/widgets/Toolbar/ToolbarSection/ToolbarSection.qss");
-    if (!styleSheet.isEmpty()) {
-        setStyleSheet(styleSheet);
-    }
-}
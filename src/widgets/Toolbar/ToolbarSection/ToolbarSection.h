@@ -9,20 +9,19 @@
 #include "..\Buttons\SnippetsModal.h"
 #include "..\Buttons\TemplatesModal.h"
 
-#include "..\Database\DatabaseManager.h"
+#include "../../../Database/DatabaseWorker/DatabaseWorker.h"
 
 class ToolbarSection : public QWidget {
     Q_OBJECT
 
   public:
-    explicit ToolbarSection(DatabaseManager* dbManager, int userId, QWidget *parent = nullptr); 
+    explicit ToolbarSection(DatabaseWorker* database, int userId, QWidget *parent = nullptr); 
     QToolButton *createToolButton(const QString &iconPath, const QString &toolTip);
     void openSnippets();
     void openTemplates();
     void openSettings();
     void assignObjectNames();
     void applyQtStyles();
-    void loadStyleSheet();
 
   private:
     QToolButton *open_snippets_button;
@@ -30,7 +29,7 @@ class ToolbarSection : public QWidget {
     QToolButton *open_settings_button;
     QVBoxLayout *layout;
 
-    DatabaseManager* dbManager;
+    DatabaseWorker* database;
     int currentUserId;
     SettingsModal* settingsModal;
     SnippetsModal* snippetsModal;
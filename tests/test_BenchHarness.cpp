@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "../bench/BenchHarness.h"
+
+// Test that a result summarises its samples and derives throughput from the median
+TEST(BenchHarnessTest, SummarisesSamples) {
+    BenchState state(4);
+    int calls = 0;
+    int setups = 0;
+    state.setItemsPerIteration(1000);
+    state.measure([&]() { setups++; }, [&]() { calls++; });
+    EXPECT_EQ(setups, 4);
+    EXPECT_EQ(calls, 4);
+
+    BenchResult result = state.result("counting");
+    EXPECT_EQ(result.iterations, 4);
+    EXPECT_EQ(result.skipped, "");
+    EXPECT_LE(result.min_ms, result.median_ms);
+    EXPECT_LE(result.median_ms, result.max_ms);
+    EXPECT_EQ(result.bytes_per_second, 0);
+}
+
+// Test that skipping stops the iterations and is reported instead of timings
+TEST(BenchHarnessTest, ReportsSkippedBenchmarks) {
+    BenchState state(10);
+    int calls = 0;
+    state.measure([&]() {
+        calls++;
+        state.skip("g++ not found");
+    });
+    EXPECT_EQ(calls, 1);
+
+    std::ostringstream out;
+    BenchHarness::writeJson(out, {{"platform", "off\"screen"}}, {state.result("compile"), BenchState(1).result("empty")});
+    std::string json = out.str();
+    EXPECT_NE(json.find("\"platform\": \"off\\\"screen\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\": \"compile\", \"skipped\": \"g++ not found\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"skipped\": \"measure() was not called\""), std::string::npos);
+}
+
+// Test that generated sources have exactly the requested size and end mid-line when they must
+TEST(BenchHarnessTest, GeneratesSourceOfExactSize) {
+    EXPECT_EQ(BenchHarness::sourceOfSize(0), "");
+    std::string source = BenchHarness::sourceOfSize(1000);
+    EXPECT_EQ(source.size(), 1000u);
+    EXPECT_EQ(source.rfind("    if (dp[i][j]", 0), 0u);
+    EXPECT_EQ(BenchHarness::sourceOfSize(1000 * 1000).size(), 1000u * 1000u);
+}
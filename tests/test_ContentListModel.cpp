@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QStringList>
+#include "../src/widgets/Toolbar/ContentListModel/ContentListModel.h"
+
+namespace {
+    QStringList names(const ContentListModel& model) {
+        QStringList result;
+        for (int row = 0; row < model.rowCount(); row++) {
+            result.append(model.index(row).data().toString());
+        }
+        return result;
+    }
+
+    void load(ContentListModel& model) {
+        model.setSummaries({{1, "a", 10, 0}, {2, "c", 10, 0}, {3, "e", 10, 0}, {4, "g", 10, 0}});
+    }
+}
+
+// Test that a new name is inserted at its sorted row with a matching rowsInserted
+TEST(ContentListModelTest, InsertsAtSortedRow) {
+    ContentListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    load(model);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+
+    model.upsert({5, "d", 10, 0});
+    ASSERT_EQ(inserted.count(), 1);
+    EXPECT_EQ(inserted[0][1].toInt(), 2);
+    EXPECT_EQ(inserted[0][2].toInt(), 2);
+    EXPECT_EQ(names(model), QStringList({"a", "c", "d", "e", "g"}));
+
+    model.upsert({6, "z", 10, 0});
+    EXPECT_EQ(inserted.last()[1].toInt(), 5);
+    EXPECT_EQ(model.indexFor(6).row(), 5);
+}
+
+// Test that renaming towards the end moves the row down past its new neighbours
+TEST(ContentListModelTest, RenameMovesRowDown) {
+    ContentListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    load(model);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+
+    model.upsert({1, "f", 10, 0});
+    ASSERT_EQ(moved.count(), 1);
+    EXPECT_EQ(moved[0][1].toInt(), 0);
+    EXPECT_EQ(moved[0][4].toInt(), 3); // destination row is counted before the removal
+    EXPECT_EQ(names(model), QStringList({"c", "e", "f", "g"}));
+    EXPECT_EQ(model.indexFor(1).row(), 2);
+
+    model.upsert({2, "zz", 10, 0});
+    EXPECT_EQ(moved.last()[4].toInt(), 4);
+    EXPECT_EQ(names(model), QStringList({"e", "f", "g", "zz"}));
+}
+
+// Test that renaming towards the start moves the row up, and a rename in place does not move
+TEST(ContentListModelTest, RenameMovesRowUp) {
+    ContentListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    load(model);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+
+    model.upsert({4, "b", 10, 0});
+    ASSERT_EQ(moved.count(), 1);
+    EXPECT_EQ(moved[0][1].toInt(), 3);
+    EXPECT_EQ(moved[0][4].toInt(), 1);
+    EXPECT_EQ(names(model), QStringList({"a", "b", "c", "e"}));
+
+    model.upsert({2, "d", 10, 0});
+    EXPECT_EQ(moved.count(), 1);
+    EXPECT_EQ(changed.last()[0].toModelIndex().row(), 2);
+    EXPECT_EQ(names(model), QStringList({"a", "b", "d", "e"}));
+}
+
+// Test that removal takes out the right row, and while searching also the hit
+TEST(ContentListModelTest, RemovesRowsAndSearchHits) {
+    ContentListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    load(model);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+
+    model.remove(3);
+    ASSERT_EQ(removed.count(), 1);
+    EXPECT_EQ(removed[0][1].toInt(), 2);
+    EXPECT_EQ(names(model), QStringList({"a", "c", "g"}));
+    model.remove(42);
+    EXPECT_EQ(removed.count(), 1);
+
+    model.showSearchHits({{4, "[g]", ""}, {1, "[a]", ""}});
+    model.remove(1);
+    ASSERT_EQ(removed.count(), 2);
+    EXPECT_EQ(removed[1][1].toInt(), 1);
+    EXPECT_EQ(model.rowCount(), 1);
+    EXPECT_EQ(model.indexFor(4).row(), 0);
+    // Summaries changed during the search are listed once it is cleared
+    model.upsert({5, "b", 10, 0});
+    EXPECT_EQ(model.rowCount(), 1);
+    model.clearSearch();
+    EXPECT_EQ(names(model), QStringList({"b", "c", "g"}));
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "../src/FileSystemOperations/DirectoryEnumerator/DirectoryEnumerator.h"
+
+namespace fs = std::filesystem;
+
+// Test that files and directories are listed with their type, without . and ..
+TEST(DirectoryEnumeratorTest, ListsEntriesWithTypes) {
+    fs::path root = fs::temp_directory_path() / "kodetron_enumerator_test";
+    fs::remove_all(root);
+    fs::create_directories(root / "round1");
+    std::ofstream(root / "A.cpp") << "int main() {}";
+    std::ofstream(root / "A1.in") << "1";
+
+    std::vector<DirectoryEntry> entries;
+    ASSERT_TRUE(DirectoryEnumerator::list(root.string(), entries));
+    std::sort(entries.begin(), entries.end(), [](const DirectoryEntry &a, const DirectoryEntry &b) { return a.name < b.name; });
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].name, "A.cpp");
+    EXPECT_FALSE(entries[0].is_dir);
+    EXPECT_EQ(entries[2].name, "round1");
+    EXPECT_TRUE(entries[2].is_dir);
+    fs::remove_all(root);
+}
+
+// Test that large directories spanning several reads are listed completely
+TEST(DirectoryEnumeratorTest, ListsLargeDirectories) {
+    fs::path root = fs::temp_directory_path() / "kodetron_enumerator_large";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    for (int i = 0; i < 3000; i++) {
+        std::ofstream(root / ("test_with_a_longer_name_" + std::to_string(i) + ".in"));
+    }
+    std::vector<DirectoryEntry> entries;
+    ASSERT_TRUE(DirectoryEnumerator::list(root.string(), entries));
+    EXPECT_EQ(entries.size(), 3000u);
+    fs::remove_all(root);
+}
+
+// Test that a missing directory is reported as a failure
+TEST(DirectoryEnumeratorTest, FailsOnMissingDirectory) {
+    std::vector<DirectoryEntry> entries;
+    EXPECT_FALSE(DirectoryEnumerator::list("/nonexistent/kodetron", entries));
+    EXPECT_TRUE(entries.empty());
+}
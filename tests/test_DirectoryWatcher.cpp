@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include "../src/FileSystemOperations/DirectoryWatcher/DirectoryWatcher.h"
+#include "../src/Global/AppState.h"
+
+namespace {
+    FileChange::Kind kindOf(const QList<FileChange>& changes, const QString& path, bool* found) {
+        for (const FileChange& change : changes) {
+            if (change.path == path) {
+                *found = true;
+                return change.kind;
+            }
+        }
+        *found = false;
+        return FileChange::Kind::Added;
+    }
+}
+
+// Test that only paths created within the batch cancel out when removed again
+TEST(DirectoryWatcherTest, BatchKeepsNetEffectPerPath) {
+    FileChangeBatch batch;
+    batch.add(FileChange::Kind::Added, "/r/temp", false);
+    batch.add(FileChange::Kind::Removed, "/r/temp", false);
+    // An existing file replaced and deleted again is still gone
+    batch.add(FileChange::Kind::Removed, "/r/old", false);
+    batch.add(FileChange::Kind::Added, "/r/old", false);
+    batch.add(FileChange::Kind::Removed, "/r/old", false);
+    // An existing file rewritten by rename is reported as added
+    batch.add(FileChange::Kind::Removed, "/r/kept", false);
+    batch.add(FileChange::Kind::Added, "/r/kept", false);
+
+    QList<FileChange> changes = batch.take();
+    bool found = false;
+    kindOf(changes, "/r/temp", &found);
+    EXPECT_FALSE(found);
+    EXPECT_EQ(kindOf(changes, "/r/old", &found), FileChange::Kind::Removed);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(kindOf(changes, "/r/kept", &found), FileChange::Kind::Added);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(changes.size(), 2);
+    EXPECT_TRUE(batch.isEmpty());
+}
+
+// Test that deleting the watched folder itself is reported and ends the watch
+TEST(DirectoryWatcherTest, ReportsRemovedRoot) {
+    if (!QApplication::instance()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        static int argc = 1;
+        static char name[] = "kodetron_tests";
+        static char* argv[] = {name, nullptr};
+        new QApplication(argc, argv);
+    }
+    QTemporaryDir parent;
+    QString root = parent.filePath("contest");
+    ASSERT_TRUE(QDir().mkpath(root));
+    DirectoryWatcher& watcher = DirectoryWatcher::instance();
+    QSignalSpy changes(&watcher, &DirectoryWatcher::changesReady);
+    QSignalSpy removed(&watcher, &DirectoryWatcher::rootRemoved);
+    AppState::instance().setSelectedDirPath(root);
+    AppState::instance().commit();
+
+    // Watches are registered off the GUI thread; a reported probe file proves they are in place
+    for (int attempt = 0; attempt < 50 && changes.isEmpty(); attempt++) {
+        QFile probe(root + "/probe" + QString::number(attempt));
+        probe.open(QIODevice::WriteOnly);
+        changes.wait(100);
+    }
+    ASSERT_FALSE(changes.isEmpty());
+
+    ASSERT_TRUE(QDir(root).removeRecursively());
+    ASSERT_TRUE(removed.wait(2000));
+    EXPECT_EQ(removed.first().first().toString(), QDir::cleanPath(root));
+    EXPECT_TRUE(watcher.rootPath().isEmpty());
+
+    AppState::instance().setSelectedDirPath(QString());
+    AppState::instance().commit();
+}
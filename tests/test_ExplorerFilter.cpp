@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include "../src/FileSystemOperations/ExplorerFilter/ExplorerFilter.h"
+
+// Test that extension, literal and glob patterns are all honoured
+TEST(ExplorerFilterTest, MatchesEveryPatternKind) {
+    ExplorerFilter filter = ExplorerFilter::compile("*.cpp, *.IN; Makefile gen*.py");
+    EXPECT_TRUE(filter.matches("A.cpp"));
+    EXPECT_TRUE(filter.matches("a1.in"));
+    EXPECT_TRUE(filter.matches("makefile"));
+    EXPECT_TRUE(filter.matches("gen_random.py"));
+    EXPECT_FALSE(filter.matches("solve.py"));
+    EXPECT_FALSE(filter.matches("A.out"));
+    EXPECT_FALSE(filter.matches("cpp"));
+}
+
+// Test that an empty spec or a lone star shows everything
+TEST(ExplorerFilterTest, EmptyAndStarAcceptAll) {
+    EXPECT_TRUE(ExplorerFilter::compile("").acceptsAll());
+    EXPECT_TRUE(ExplorerFilter::compile("*.cpp, *").matches("notes.md"));
+}
+
+// Test that globs with several stars and question marks backtrack correctly
+TEST(ExplorerFilterTest, MatchesGlobsWithBacktracking) {
+    ExplorerFilter filter = ExplorerFilter::compile("*test*.t?t");
+    EXPECT_TRUE(filter.matches("my_test_data.txt"));
+    EXPECT_TRUE(filter.matches("testtest.tat"));
+    EXPECT_FALSE(filter.matches("my_test_data.text"));
+}
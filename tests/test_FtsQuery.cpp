@@ -0,0 +1,16 @@
+#include <gtest/gtest.h>
+#include "../src/Database/FtsQuery/FtsQuery.h"
+
+// Test that words become quoted prefix terms and punctuation is dropped
+TEST(FtsQueryTest, BuildsQuotedPrefixTerms) {
+    EXPECT_EQ(FtsQuery::prefixQuery("std::vec"), "\"std\"* \"vec\"*");
+    EXPECT_EQ(FtsQuery::prefixQuery("  dfs_iter  "), "\"dfs_iter\"*");
+    EXPECT_EQ(FtsQuery::prefixQuery("\"a\" OR b*"), "\"a\"* \"OR\"* \"b\"*");
+    EXPECT_EQ(FtsQuery::prefixQuery("-- ::"), "");
+}
+
+// Test that excerpts are escaped before the match markers become tags
+TEST(FtsQueryTest, RendersMarkedExcerpt) {
+    std::string marked = std::string("vector<int> ") + FtsQuery::MATCH_START + "seg" + FtsQuery::MATCH_END + " & tree";
+    EXPECT_EQ(FtsQuery::markedToHtml(marked), "vector&lt;int&gt; <b>seg</b> &amp; tree");
+}
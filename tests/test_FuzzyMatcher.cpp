@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/Search/FuzzyMatcher/FuzzyMatcher.h"
+
+// Test that only paths containing the query as a subsequence are returned
+TEST(FuzzyMatcherTest, MatchesSubsequencesOnly) {
+    PathList paths;
+    paths.append("contests/1900/A.cpp");
+    paths.append("library/segtree.cpp");
+    paths.append("notes.txt");
+    std::vector<FuzzyResult> results = FuzzyMatcher::match(paths, "sgtr", 10);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(paths.at(results[0].index), "library/segtree.cpp");
+    EXPECT_TRUE(FuzzyMatcher::match(paths, "xyz", 10).empty());
+}
+
+// Test that segment starts and file name hits outrank scattered matches
+TEST(FuzzyMatcherTest, RanksFileNameAndSegmentStartsFirst) {
+    PathList paths;
+    paths.append("src/fenwick/bits/tree/misc.cpp");
+    paths.append("library/FenwickTree.cpp");
+    paths.append("library/fenwick_tree.cpp");
+    std::vector<FuzzyResult> results = FuzzyMatcher::match(paths, "ft", 10);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_NE(paths.at(results[0].index), "src/fenwick/bits/tree/misc.cpp");
+    EXPECT_EQ(paths.at(results[2].index), "src/fenwick/bits/tree/misc.cpp");
+}
+
+// Test that narrowing to the previous matches gives the same answer as a full scan
+TEST(FuzzyMatcherTest, NarrowsFromPreviousCandidates) {
+    PathList paths;
+    for (int i = 0; i < 500; i++) {
+        paths.append("round" + std::to_string(i) + "/problem_" + std::string(1, char('A' + i % 8)) + ".cpp");
+    }
+    std::vector<uint32_t> candidates;
+    FuzzyMatcher::match(paths, "r1", 1000, nullptr, &candidates);
+    std::vector<FuzzyResult> narrowed = FuzzyMatcher::match(paths, "r12b", 20, &candidates);
+    std::vector<FuzzyResult> full = FuzzyMatcher::match(paths, "r12b", 20);
+    ASSERT_EQ(narrowed.size(), full.size());
+    for (size_t i = 0; i < full.size(); i++) {
+        EXPECT_EQ(narrowed[i].index, full[i].index);
+        EXPECT_EQ(narrowed[i].score, full[i].score);
+    }
+}
+
+// Test that an empty query keeps every path and caps the result count
+TEST(FuzzyMatcherTest, EmptyQueryReturnsLimit) {
+    PathList paths;
+    for (int i = 0; i < 30; i++) {
+        paths.append("f" + std::to_string(i));
+    }
+    EXPECT_EQ(FuzzyMatcher::match(paths, "", 10).size(), 10u);
+}
+
+// Test that a small limit returns the head of the full ranking, skipped paths included
+TEST(FuzzyMatcherTest, LimitKeepsTheBestResults) {
+    PathList paths;
+    for (int i = 0; i < 300; i++) {
+        std::string directory = i % 3 == 0 ? "segments/" : i % 3 == 1 ? "src/SegTree/" : "notes/";
+        paths.append(directory + (i % 2 ? "SegTree" : "misc_seg") + std::to_string(i) + ".cpp");
+    }
+    std::vector<uint32_t> matched;
+    std::vector<FuzzyResult> all = FuzzyMatcher::match(paths, "sgt", 1000, nullptr, &matched);
+    std::vector<FuzzyResult> top = FuzzyMatcher::match(paths, "sgt", 7, nullptr, &matched);
+    EXPECT_EQ(matched.size(), all.size());
+    ASSERT_EQ(top.size(), 7u);
+    for (size_t i = 0; i < top.size(); i++) {
+        EXPECT_EQ(top[i].index, all[i].index);
+        EXPECT_EQ(top[i].score, all[i].score);
+    }
+    EXPECT_TRUE(FuzzyMatcher::match(paths, "sgt", 0).empty());
+}
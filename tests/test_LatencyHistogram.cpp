@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "../src/utils/LatencyHistogram/LatencyHistogram.h"
+
+// Test that delays land in power-of-two buckets, the last one open-ended
+TEST(LatencyHistogramTest, BucketsByPowersOfTwo) {
+    EXPECT_EQ(LatencyHistogram::bucketFor(0), 0);
+    EXPECT_EQ(LatencyHistogram::bucketFor(0.9), 0);
+    EXPECT_EQ(LatencyHistogram::bucketFor(1), 1);
+    EXPECT_EQ(LatencyHistogram::bucketFor(3.5), 2);
+    EXPECT_EQ(LatencyHistogram::bucketFor(4), 3);
+    EXPECT_EQ(LatencyHistogram::bucketFor(1e9), LatencyHistogram::BUCKET_COUNT - 1);
+
+    EXPECT_EQ(LatencyHistogram::bucketLabel(0), "<1 ms");
+    EXPECT_EQ(LatencyHistogram::bucketLabel(3), "4-8 ms");
+    EXPECT_EQ(LatencyHistogram::bucketLabel(LatencyHistogram::BUCKET_COUNT - 1), "2048+ ms");
+}
+
+// Test that counts, the maximum and percentiles follow the recorded samples
+TEST(LatencyHistogramTest, SummarisesSamples) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentileMs(0.5), 0);
+    for (int i = 0; i < 98; i++) {
+        histogram.record(0.2);
+    }
+    histogram.record(12);
+    histogram.record(300);
+    histogram.record(-1); // a timer that fired early counts as no delay
+
+    EXPECT_EQ(histogram.total(), 101);
+    EXPECT_EQ(histogram.count(0), 99);
+    EXPECT_EQ(histogram.count(LatencyHistogram::bucketFor(12)), 1);
+    EXPECT_DOUBLE_EQ(histogram.maxMs(), 300);
+    EXPECT_DOUBLE_EQ(histogram.percentileMs(0.5), 1);
+    EXPECT_DOUBLE_EQ(histogram.percentileMs(0.99), 16);
+    EXPECT_DOUBLE_EQ(histogram.percentileMs(1), 300);
+
+    histogram.clear();
+    EXPECT_EQ(histogram.total(), 0);
+    EXPECT_EQ(histogram.maxMs(), 0);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "../src/Database/LibraryArchive/LibraryArchive.h"
+
+namespace {
+    std::vector<LibraryRecord> readAll(const std::string& archive, std::string* error = nullptr) {
+        std::istringstream in(archive);
+        LibraryReader reader(in);
+        std::vector<LibraryRecord> records;
+        LibraryRecord record;
+        while (reader.next(record)) {
+            records.push_back(record);
+        }
+        if (error) {
+            *error = reader.error();
+        }
+        return records;
+    }
+}
+
+// Test that records with quotes, newlines, control and non-ASCII characters survive a round trip
+TEST(LibraryArchiveTest, RoundTripsRecords) {
+    std::vector<LibraryRecord> written = {
+        {LibraryRecordKind::Snippet, "dsu", "struct DSU {\n\tvector<int> p;\n};\n"},
+        {LibraryRecordKind::Template, "default", "// \"main\" \\ path\r\n\x01 ü ∑ 😀"},
+    };
+    std::ostringstream out;
+    LibraryWriter writer(out);
+    for (const LibraryRecord& record : written) {
+        writer.write(record);
+    }
+
+    std::string error;
+    std::vector<LibraryRecord> read = readAll(out.str(), &error);
+    EXPECT_EQ(error, "");
+    ASSERT_EQ(read.size(), written.size());
+    for (size_t i = 0; i < read.size(); i++) {
+        EXPECT_EQ(read[i].kind, written[i].kind);
+        EXPECT_EQ(read[i].name, written[i].name);
+        EXPECT_EQ(read[i].content, written[i].content);
+    }
+}
+
+// Test that records larger than the read buffer are assembled across refills
+TEST(LibraryArchiveTest, ReadsRecordsLongerThanTheBuffer) {
+    std::string content(LibraryReader::BUFFER_SIZE * 3 + 17, 'x');
+    std::ostringstream out;
+    LibraryWriter writer(out);
+    for (int i = 0; i < 3; i++) {
+        writer.write({LibraryRecordKind::Snippet, "s" + std::to_string(i), content});
+    }
+
+    std::istringstream in(out.str());
+    LibraryReader reader(in);
+    LibraryRecord record;
+    int count = 0;
+    while (reader.next(record)) {
+        EXPECT_EQ(record.content, content);
+        count++;
+    }
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(reader.error(), "");
+    EXPECT_EQ(reader.bytesRead(), static_cast<long long>(out.str().size()));
+}
+
+// Test that escapes written by other tools are decoded, unknown keys ignored and blank lines skipped
+TEST(LibraryArchiveTest, AcceptsHandWrittenArchives) {
+    std::string archive =
+        "{ \"version\": 1, \"format\": \"kodetron-library\" }\r\n"
+        "\n"
+        "{\"name\":\"a\\/b\",\"origin\":\"kactl\",\"kind\":\"snippet\",\"content\":\"\\u00e9\\ud83d\\ude00\"}";
+    std::string error;
+    std::vector<LibraryRecord> read = readAll(archive, &error);
+    EXPECT_EQ(error, "");
+    ASSERT_EQ(read.size(), 1u);
+    EXPECT_EQ(read[0].name, "a/b");
+    EXPECT_EQ(read[0].content, "é😀");
+}
+
+// Test that malformed input stops the reader with the offending line number
+TEST(LibraryArchiveTest, ReportsMalformedLines) {
+    std::string error;
+    readAll("{\"format\":\"something-else\",\"version\":1}\n", &error);
+    EXPECT_EQ(error, "line 1: not a kodetron library");
+
+    std::vector<LibraryRecord> read = readAll(
+        "{\"format\":\"kodetron-library\",\"version\":1}\n"
+        "{\"kind\":\"snippet\",\"name\":\"ok\",\"content\":\"x\"}\n"
+        "{\"kind\":\"snippet\",\"name\":\"broken\",\"content\":\"unterminated}\n",
+        &error);
+    EXPECT_EQ(read.size(), 1u);
+    EXPECT_EQ(error.rfind("line 3:", 0), 0u);
+
+    readAll("{\"format\":\"kodetron-library\",\"version\":1}\n{\"kind\":\"snippet\",\"tags\":[]}\n", &error);
+    EXPECT_EQ(error, "line 2: unsupported value for \"tags\"");
+
+    read = readAll("{\"format\":\"kodetron-library\",\"version\":1}\n{\"kind\":\"template\",\"name\":\"blank\",\"content\":\" \\n\\t\"}\n", &error);
+    EXPECT_TRUE(read.empty());
+    EXPECT_EQ(error, "line 2: \"blank\" has no content");
+
+    readAll("", &error);
+    EXPECT_EQ(error, "empty file");
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/Search/LiteralScanner/LiteralScanner.h"
+
+// Test that matches are found across SIMD block boundaries and in the tail
+TEST(LiteralScannerTest, FindsMatchesAtEveryOffset) {
+    std::string needle = "segtree";
+    for (size_t offset = 0; offset < 80; offset++) {
+        std::string haystack(offset, 'x');
+        haystack += needle + std::string(5, 'y');
+        EXPECT_EQ(LiteralScanner::find(haystack.data(), haystack.size(), needle, false), offset);
+    }
+}
+
+// Test that near misses sharing first and last bytes are rejected
+TEST(LiteralScannerTest, RejectsCandidatesWithDifferentMiddle) {
+    std::string haystack = std::string(40, '.') + "segxxee" + std::string(40, '.');
+    EXPECT_EQ(LiteralScanner::find(haystack.data(), haystack.size(), "segtree", false), LiteralScanner::NOT_FOUND);
+}
+
+// Test that ASCII case folding works in both the vector and scalar paths
+TEST(LiteralScannerTest, IgnoresAsciiCase) {
+    std::string haystack = std::string(33, ' ') + "LowER_Bound(" + "lower_bound";
+    EXPECT_EQ(LiteralScanner::find(haystack.data(), haystack.size(), "lower_bound", true), 33u);
+    EXPECT_EQ(LiteralScanner::find(haystack.data(), haystack.size(), "lower_bound", false), 45u);
+    EXPECT_EQ(LiteralScanner::find(haystack.data(), haystack.size(), "lower_bound", false, 46), LiteralScanner::NOT_FOUND);
+}
+
+// Test that the required literal skips optional and class parts of a regex
+TEST(LiteralScannerTest, ExtractsRequiredLiteral) {
+    EXPECT_EQ(LiteralScanner::requiredLiteral("vector<int>"), "vector<int>");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(\bsort\(\w+\.begin)"), ".begin");
+    EXPECT_EQ(LiteralScanner::requiredLiteral("colou?r"), "colo");
+    EXPECT_EQ(LiteralScanner::requiredLiteral("ab{2}cdef"), "cdef");
+    EXPECT_EQ(LiteralScanner::requiredLiteral("[abc]+long_name"), "long_name");
+    EXPECT_EQ(LiteralScanner::requiredLiteral("foo|bar"), "");
+    EXPECT_EQ(LiteralScanner::requiredLiteral("(?i)foo"), "");
+}
+
+// Test that the arguments of escapes such as \x41 or \cA are not taken as literal text
+TEST(LiteralScannerTest, SkipsEscapeArguments) {
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(\x41BC)"), "BC"); // \x takes at most two hex digits
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(\cA)"), "");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(key\cAvalue)"), "value");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(x\x{263A}yz)"), "yz");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(\p{Lu}word)"), "word");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(ab\012345)"), "ab");
+    EXPECT_EQ(LiteralScanner::requiredLiteral(R"(\Qa+b\Emain)"), "main");
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "../src/Database/PayloadCodec/PayloadCodec.h"
+
+// Test that a large repetitive test input shrinks and decodes back unchanged
+TEST(PayloadCodecTest, RoundTripsLargeInput) {
+    std::string raw;
+    for (int i = 0; i < 100000; i++) {
+        raw += std::to_string(i % 1000) + " ";
+    }
+    PayloadCodec::Encoded encoded = PayloadCodec::encode(raw);
+#if defined(KODETRON_HAVE_ZSTD) || defined(KODETRON_HAVE_ZLIB)
+    EXPECT_NE(encoded.codec, PayloadCodec::RAW);
+    EXPECT_LT(encoded.data.size(), raw.size() / 10);
+#endif
+    std::string decoded;
+    ASSERT_TRUE(PayloadCodec::decode(encoded.codec, encoded.data, raw.size(), decoded));
+    EXPECT_EQ(decoded, raw);
+}
+
+// Test that short values are stored as they are
+TEST(PayloadCodecTest, KeepsSmallValuesRaw) {
+    PayloadCodec::Encoded encoded = PayloadCodec::encode("1 2\n");
+    EXPECT_EQ(encoded.codec, PayloadCodec::RAW);
+    EXPECT_EQ(encoded.data, "1 2\n");
+}
+
+// Test that damaged data or an unknown codec is reported instead of returned
+TEST(PayloadCodecTest, RejectsDamagedData) {
+    std::string raw(4096, 'x');
+    PayloadCodec::Encoded encoded = PayloadCodec::encode(raw);
+    std::string decoded;
+    EXPECT_FALSE(PayloadCodec::decode(encoded.codec, encoded.data.substr(0, encoded.data.size() / 2), raw.size(), decoded));
+    EXPECT_FALSE(PayloadCodec::decode(99, encoded.data, raw.size(), decoded));
+}
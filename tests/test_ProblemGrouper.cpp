@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "../src/FileSystemOperations/ProblemGrouper/ProblemGrouper.h"
+
+// Test that numbered tests are attached to their source in test order
+TEST(ProblemGrouperTest, PairsSourcesWithNumberedTests) {
+    GroupedListing listing = ProblemGrouper::group({"A2.out", "B.cpp", "A.cpp", "A10.in", "A1.out", "A2.in", "A1.in", "notes.txt"});
+    ASSERT_EQ(listing.groups.size(), 2u);
+    EXPECT_EQ(listing.groups[0].source, "B.cpp");
+    EXPECT_TRUE(listing.groups[0].tests.empty());
+    EXPECT_EQ(listing.groups[1].source, "A.cpp");
+    std::vector<std::string> expected = {"A1.in", "A1.out", "A2.in", "A2.out", "A10.in"};
+    EXPECT_EQ(listing.groups[1].tests, expected);
+    EXPECT_EQ(listing.ungrouped, std::vector<std::string>{"notes.txt"});
+}
+
+// Test that an exact stem wins over stripping the test number
+TEST(ProblemGrouperTest, PrefersExactStem) {
+    GroupedListing listing = ProblemGrouper::group({"A.cpp", "A1.cpp", "A1.in", "A_2.in", "A.ans"});
+    ASSERT_EQ(listing.groups.size(), 2u);
+    EXPECT_EQ(listing.groups[0].tests, (std::vector<std::string>{"A.ans", "A_2.in"}));
+    EXPECT_EQ(listing.groups[1].tests, std::vector<std::string>{"A1.in"});
+}
+
+// Test that tests without a matching source stay ungrouped
+TEST(ProblemGrouperTest, LeavesOrphanTestsUngrouped) {
+    GroupedListing listing = ProblemGrouper::group({"sample1.in", "1.in", "C.py"});
+    ASSERT_EQ(listing.groups.size(), 1u);
+    EXPECT_EQ(listing.ungrouped, (std::vector<std::string>{"sample1.in", "1.in"}));
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "../src/utils/RangeShift/RangeShift.h"
+
+// Test that inserts move ranges after them and grow ranges around them, edges only on request
+TEST(RangeShiftTest, ShiftsForInsert) {
+    size_t start = 10;
+    size_t length = 5;
+    RangeShift::forInsert(start, length, 3, 2, false);
+    EXPECT_EQ(start, 12u);
+    EXPECT_EQ(length, 5u);
+    RangeShift::forInsert(start, length, 14, 4, false);
+    EXPECT_EQ(length, 9u);
+    RangeShift::forInsert(start, length, 12, 1, false);
+    EXPECT_EQ(start, 13u);
+    EXPECT_EQ(length, 9u);
+    RangeShift::forInsert(start, length, 22, 3, false);
+    EXPECT_EQ(length, 9u);
+    RangeShift::forInsert(start, length, 22, 3, true);
+    EXPECT_EQ(start, 13u);
+    EXPECT_EQ(length, 12u);
+}
+
+// Test that deletes before, across the start, inside and across the end of a range keep it on its text
+TEST(RangeShiftTest, ShiftsForDelete) {
+    size_t start = 10;
+    size_t length = 10;
+    RangeShift::forDelete(start, length, 0, 4);
+    EXPECT_EQ(start, 6u);
+    EXPECT_EQ(length, 10u);
+    RangeShift::forDelete(start, length, 4, 4);
+    EXPECT_EQ(start, 4u);
+    EXPECT_EQ(length, 8u);
+    RangeShift::forDelete(start, length, 6, 2);
+    EXPECT_EQ(start, 4u);
+    EXPECT_EQ(length, 6u);
+    RangeShift::forDelete(start, length, 8, 10);
+    EXPECT_EQ(start, 4u);
+    EXPECT_EQ(length, 4u);
+    RangeShift::forDelete(start, length, 6, 3);
+    EXPECT_EQ(start, 4u);
+    EXPECT_EQ(length, 2u);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/Database/RecordCache/RecordCache.h"
+
+// Test that reads are served from the cache and writes replace in place
+TEST(RecordCacheTest, FindsPutRecords) {
+    RecordCache<std::string> cache;
+    EXPECT_EQ(cache.find(1), nullptr);
+    cache.put(1, "tourist");
+    const std::string* cached = cache.find(1);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(*cached, "tourist");
+
+    // Other ids growing the table do not move existing records
+    for (int id = 2; id < 1000; id++) {
+        cache.put(id, std::to_string(id));
+    }
+    EXPECT_EQ(cache.find(1), cached);
+    cache.put(1, "petr");
+    EXPECT_EQ(*cache.find(1), "petr");
+}
+
+// Test that every change bumps the generation and no-ops do not
+TEST(RecordCacheTest, GenerationTracksWrites) {
+    RecordCache<int> cache;
+    uint64_t seen = cache.generation();
+    cache.put(1, 10);
+    EXPECT_NE(cache.generation(), seen);
+
+    seen = cache.generation();
+    cache.erase(2);
+    EXPECT_EQ(cache.generation(), seen);
+    cache.erase(1);
+    EXPECT_NE(cache.generation(), seen);
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    seen = cache.generation();
+    cache.clear();
+    EXPECT_NE(cache.generation(), seen);
+}
+
+// Test that in-place edits keep the record's address and only bump the generation when they change something
+TEST(RecordCacheTest, UpdatesInPlace) {
+    RecordCache<std::string> cache;
+    cache.put(1, "a");
+    cache.put(2, "b");
+    const std::string* cached = cache.find(1);
+
+    uint64_t seen = cache.generation();
+    cache.update(1, [](std::string& value) { value += "x"; return true; });
+    EXPECT_EQ(cache.find(1), cached);
+    EXPECT_EQ(*cached, "ax");
+    EXPECT_NE(cache.generation(), seen);
+
+    seen = cache.generation();
+    cache.update(3, [](std::string&) { return true; });
+    cache.update(2, [](std::string&) { return false; });
+    EXPECT_EQ(cache.find(3), nullptr);
+    EXPECT_EQ(cache.generation(), seen);
+
+    cache.updateAll([](std::string& value) {
+        if (value != "b") {
+            return false;
+        }
+        value = "c";
+        return true;
+    });
+    EXPECT_EQ(*cache.find(2), "c");
+    EXPECT_EQ(*cache.find(1), "ax");
+    EXPECT_NE(cache.generation(), seen);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "../src/Database/SchemaMigrations/SchemaMigrations.h"
+
+namespace {
+    struct MemoryDatabase {
+        sqlite3* db = nullptr;
+        MemoryDatabase() { sqlite3_open(":memory:", &db); }
+        ~MemoryDatabase() { sqlite3_close(db); }
+    };
+
+    std::vector<SchemaMigration> history(int* runs) {
+        return {
+            {2, "add column", [runs](sqlite3* db) {
+                (*runs)++;
+                return SchemaMigrations::execute(db, "ALTER TABLE Items ADD COLUMN size INTEGER NOT NULL DEFAULT 0;");
+            }},
+            {1, "create table", [runs](sqlite3* db) {
+                (*runs)++;
+                return SchemaMigrations::execute(db, "CREATE TABLE Items (id INTEGER PRIMARY KEY, name VARCHAR);");
+            }},
+        };
+    }
+}
+
+// Test that steps run in version order once and record the version
+TEST(SchemaMigrationsTest, AppliesPendingStepsOnce) {
+    MemoryDatabase memory;
+    int runs = 0;
+    ASSERT_TRUE(SchemaMigrations::migrate(memory.db, history(&runs)));
+    EXPECT_EQ(runs, 2);
+    EXPECT_EQ(SchemaMigrations::currentVersion(memory.db), 2);
+    EXPECT_TRUE(SchemaMigrations::hasTable(memory.db, "Items"));
+    EXPECT_TRUE(SchemaMigrations::hasColumn(memory.db, "Items", "size"));
+
+    ASSERT_TRUE(SchemaMigrations::migrate(memory.db, history(&runs)));
+    EXPECT_EQ(runs, 2);
+}
+
+// Test that a failing step rolls back the steps before it as well
+TEST(SchemaMigrationsTest, FailureLeavesDatabaseUntouched) {
+    MemoryDatabase memory;
+    int runs = 0;
+    std::vector<SchemaMigration> steps = history(&runs);
+    steps.push_back({3, "broken", [](sqlite3* db) { return SchemaMigrations::execute(db, "ALTER TABLE Missing ADD COLUMN x;"); }});
+
+    std::string error;
+    EXPECT_FALSE(SchemaMigrations::migrate(memory.db, steps, &error));
+    EXPECT_NE(error.find("broken"), std::string::npos);
+    EXPECT_EQ(SchemaMigrations::currentVersion(memory.db), 0);
+    EXPECT_FALSE(SchemaMigrations::hasTable(memory.db, "Items"));
+}
+
+// Test that a file from a newer build is refused rather than modified
+TEST(SchemaMigrationsTest, RefusesNewerDatabase) {
+    MemoryDatabase memory;
+    SchemaMigrations::execute(memory.db, "PRAGMA user_version = 7;");
+    int runs = 0;
+    std::string error;
+    EXPECT_FALSE(SchemaMigrations::migrate(memory.db, history(&runs), &error));
+    EXPECT_EQ(runs, 0);
+    EXPECT_FALSE(error.empty());
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../src/Snippets/SnippetParser/SnippetParser.h"
+
+// Test that plain text has a single final stop at the end
+TEST(SnippetParserTest, PlainTextEndsAtFinalStop) {
+    ParsedSnippet snippet = SnippetParser::parse("int main() {}");
+    EXPECT_EQ(snippet.body, "int main() {}");
+    ASSERT_EQ(snippet.tab_stops.size(), 1u);
+    EXPECT_EQ(snippet.tab_stops[0].index, 0);
+    EXPECT_EQ(snippet.tab_stops[0].offset, snippet.body.size());
+}
+
+// Test that placeholders are replaced by their defaults and visited in order
+TEST(SnippetParserTest, PlaceholdersAreOrderedWithFinalStopLast) {
+    ParsedSnippet snippet = SnippetParser::parse("for (int ${2:i} = 0; $2 < ${1:n}; $2++) {$0}");
+    EXPECT_EQ(snippet.body, "for (int i = 0; i < n; i++) {}");
+    ASSERT_EQ(snippet.tab_stops.size(), 5u);
+    EXPECT_EQ(snippet.tab_stops[0].index, 1);
+    EXPECT_EQ(snippet.body.substr(snippet.tab_stops[0].offset, snippet.tab_stops[0].length), "n");
+    // The repeats of $2 mirror its default and stay linked to it
+    for (size_t i = 1; i <= 3; i++) {
+        EXPECT_EQ(snippet.tab_stops[i].index, 2);
+        EXPECT_EQ(snippet.body.substr(snippet.tab_stops[i].offset, snippet.tab_stops[i].length), "i");
+    }
+    EXPECT_EQ(snippet.tab_stops[1].offset, 9u);
+    EXPECT_EQ(snippet.tab_stops[3].offset, 23u);
+    EXPECT_EQ(snippet.tab_stops.back().index, 0);
+    EXPECT_EQ(snippet.tab_stops.back().offset, snippet.body.size() - 1);
+}
+
+// Test that escaped dollars and unknown sequences are kept literally
+TEST(SnippetParserTest, EscapesAndLiteralDollars) {
+    ParsedSnippet snippet = SnippetParser::parse("\\$1 costs $ and ${x}");
+    EXPECT_EQ(snippet.body, "$1 costs $ and ${x}");
+    EXPECT_EQ(snippet.tab_stops.size(), 1u);
+}
+
+// Test that indentation is applied to continuation lines and stops follow it
+TEST(SnippetParserTest, IndentShiftsTabStops) {
+    ParsedSnippet snippet = SnippetParser::indent(SnippetParser::parse("{\n${1:x}\n}"), "    ");
+    EXPECT_EQ(snippet.body, "{\n    x\n    }");
+    EXPECT_EQ(snippet.tab_stops[0].offset, 6u);
+    EXPECT_EQ(snippet.tab_stops[0].length, 1u);
+}
+
+// Test that typing over a selected placeholder keeps later stops in place
+TEST(SnippetParserTest, EditsShiftTrackedStops) {
+    std::vector<SnippetTabStop> stops = {{1, 10, 1}, {2, 20, 3}, {0, 30, 0}};
+    SnippetParser::shiftForDelete(stops, 10, 1);
+    SnippetParser::shiftForInsert(stops, 10, 4, 1);
+    EXPECT_EQ(stops[0].offset, 10u);
+    EXPECT_EQ(stops[0].length, 4u);
+    EXPECT_EQ(stops[1].offset, 23u);
+    EXPECT_EQ(stops[2].offset, 33u);
+
+    SnippetParser::shiftForDelete(stops, 22, 3);
+    EXPECT_EQ(stops[1].offset, 22u);
+    EXPECT_EQ(stops[1].length, 1u);
+    EXPECT_EQ(stops[2].offset, 30u);
+}
+
+// Test that typing at the end of the active stop moves, rather than grows, the stop right after it
+TEST(SnippetParserTest, InsertAtSharedEdgeGrowsOnlyTheActiveStop) {
+    ParsedSnippet snippet = SnippetParser::parse("${1:a}${2:b}");
+    std::vector<SnippetTabStop> stops = snippet.tab_stops;
+    SnippetParser::shiftForInsert(stops, 1, 2, 1);
+    EXPECT_EQ(stops[0].offset, 0u);
+    EXPECT_EQ(stops[0].length, 3u);
+    EXPECT_EQ(stops[1].offset, 3u);
+    EXPECT_EQ(stops[1].length, 1u);
+    EXPECT_EQ(stops[2].offset, 4u);
+
+    // Typing at the start of stop 2 while it is active leaves stop 1 alone
+    SnippetParser::shiftForInsert(stops, 3, 1, 2);
+    EXPECT_EQ(stops[0].length, 3u);
+    EXPECT_EQ(stops[1].offset, 3u);
+    EXPECT_EQ(stops[1].length, 2u);
+    EXPECT_EQ(stops[2].offset, 5u);
+}
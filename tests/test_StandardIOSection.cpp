@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTextEdit>
+#include "../src/Global/AppState.h"
+#include "../src/widgets/StandardIO/StandardIOSection/StandardIOSection.h"
+
+class StandardIOSectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!QApplication::instance()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+            static int argc = 1;
+            static char name[] = "kodetron_tests";
+            static char* argv[] = {name, nullptr};
+            new QApplication(argc, argv);
+        }
+        // A fresh database away from the user's
+        QStandardPaths::setTestModeEnabled(true);
+        QFile::remove(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/kodetron.db");
+        database = new DatabaseWorker();
+        database->initialize(1);
+        database->start();
+
+        source_path = dir.filePath("a.cpp");
+        AppState::instance().setSelectedFilePath(source_path);
+        AppState::instance().commit();
+    }
+
+    void TearDown() override {
+        delete database; // runs the saves still queued
+        AppState::instance().setSelectedFilePath(QString());
+        AppState::instance().commit();
+    }
+
+    // Lets the section's fetch of the stored suite finish and apply
+    void settle() {
+        database->fetchTestCases(source_path.toStdString()).waitForFinished();
+        QCoreApplication::sendPostedEvents();
+        QCoreApplication::processEvents();
+    }
+
+    QTemporaryDir dir;
+    QString source_path;
+    DatabaseWorker* database = nullptr;
+};
+
+// Test that a test added and typed into but never run is stored on quit and selectable after a restart
+TEST_F(StandardIOSectionTest, KeepsTestsThatWereNeverRun) {
+    TestPanelState state;
+    {
+        StandardIOSection section(database, nullptr);
+        settle();
+        section.findChild<ExecutionOptionsContainer*>()->getAddTestButton()->click();
+        section.findChild<QTextEdit*>("input_text_box")->setPlainText("3 4");
+        state = section.panelState();
+        section.flushTestCases(); // what aboutToQuit does
+    }
+
+    std::vector<TestCase> stored = database->fetchTestCases(source_path.toStdString()).result();
+    ASSERT_EQ(stored.size(), 2u);
+    EXPECT_EQ(stored[1].input, "3 4");
+    EXPECT_EQ(stored[1].verdict, TestVerdict::None);
+
+    // The session restores the second test, which now exists in the stored suite
+    StandardIOSection restored(database, nullptr);
+    restored.restorePanelState(source_path, state); // before its fetch of the suite has been applied
+    settle();
+    EXPECT_EQ(restored.panelState().test_index, 1);
+    EXPECT_EQ(restored.panelState().input, "3 4");
+}
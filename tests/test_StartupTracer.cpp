@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../src/utils/StartupTracer/StartupTracer.h"
+
+// Test that nested phases are timed and reported indented under their parent
+TEST(StartupTracerTest, TimesNestedPhases) {
+    double now = 0;
+    StartupTracer tracer([&now]() { return now; });
+    {
+        StartupTracer::Scope window("MainWindow", tracer);
+        now = 5;
+        {
+            StartupTracer::Scope editor("EditorSection", tracer);
+            now = 25;
+        }
+        now = 30;
+    }
+    tracer.mark("first paint");
+
+    const std::vector<StartupPhase> &phases = tracer.phases();
+    ASSERT_EQ(phases.size(), 3u);
+    EXPECT_EQ(phases[0].name, "MainWindow");
+    EXPECT_EQ(phases[0].depth, 0);
+    EXPECT_DOUBLE_EQ(phases[0].duration_ms, 30);
+    EXPECT_EQ(phases[1].depth, 1);
+    EXPECT_DOUBLE_EQ(phases[1].start_ms, 5);
+    EXPECT_DOUBLE_EQ(phases[1].duration_ms, 20);
+    EXPECT_LT(phases[2].duration_ms, 0);
+
+    std::string report = tracer.report();
+    EXPECT_NE(report.find("\n  EditorSection"), std::string::npos);
+    EXPECT_NE(report.find("first paint"), std::string::npos);
+}
+
+// Test that deferred tasks wait for runNextDeferred, are traced, and run immediately once startup is over
+TEST(StartupTracerTest, RunsDeferredTasksInOrder) {
+    double now = 0;
+    StartupTracer tracer([&now]() { return now; });
+    std::vector<std::string> ran;
+    tracer.defer("database", [&]() {
+        ran.push_back("database");
+        now += 40;
+        tracer.defer("restore", [&]() { ran.push_back("restore"); });
+    });
+    tracer.defer("apis", [&]() { ran.push_back("apis"); });
+    EXPECT_TRUE(ran.empty());
+
+    while (tracer.runNextDeferred()) {
+    }
+    EXPECT_EQ(ran, (std::vector<std::string>{"database", "apis", "restore"}));
+    EXPECT_TRUE(tracer.isFinished());
+    ASSERT_EQ(tracer.phases().size(), 3u);
+    EXPECT_EQ(tracer.phases()[0].name, "deferred: database");
+    EXPECT_DOUBLE_EQ(tracer.phases()[0].duration_ms, 40);
+
+    tracer.defer("late", [&]() { ran.push_back("late"); });
+    EXPECT_EQ(ran.back(), "late");
+    EXPECT_EQ(tracer.phases().size(), 3u);
+}
+
+// Test that a mark later than its goal is flagged in the report
+TEST(StartupTracerTest, ReportsMissedGoals) {
+    double now = 120;
+    StartupTracer tracer([&now]() { return now; });
+    tracer.mark("first paint", 150);
+    EXPECT_FALSE(tracer.missedGoal());
+    EXPECT_NE(tracer.report().find("goal 150 ms, met"), std::string::npos);
+
+    now = 180;
+    tracer.mark("second paint", 150);
+    EXPECT_TRUE(tracer.missedGoal());
+    EXPECT_NE(tracer.report().find("goal 150 ms, MISSED"), std::string::npos);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "../src/Database/StatementCache/StatementCache.h"
+
+namespace {
+    struct MemoryDatabase {
+        sqlite3* db = nullptr;
+        MemoryDatabase() {
+            sqlite3_open(":memory:", &db);
+            sqlite3_exec(db, "CREATE TABLE Items (id INTEGER PRIMARY KEY, name VARCHAR);", nullptr, nullptr, nullptr);
+        }
+        ~MemoryDatabase() { sqlite3_close(db); }
+    };
+}
+
+// Test that a statement is prepared once and comes back reset and unbound
+TEST(StatementCacheTest, ReusesResetStatement) {
+    MemoryDatabase memory;
+    StatementCache cache(memory.db);
+    sqlite3_stmt* first = nullptr;
+    {
+        Statement insert = cache.get("INSERT INTO Items (name) VALUES (?);");
+        ASSERT_TRUE(insert);
+        first = insert.get();
+        std::string name = "a";
+        insert.bind(1, name);
+        EXPECT_EQ(insert.step(), SQLITE_DONE);
+    }
+    {
+        Statement insert = cache.get("INSERT INTO Items (name) VALUES (?);");
+        EXPECT_EQ(insert.get(), first);
+        // Bindings were cleared, the row gets NULL
+        EXPECT_EQ(insert.step(), SQLITE_DONE);
+    }
+    EXPECT_EQ(cache.size(), 1u);
+
+    Statement select = cache.get("SELECT name FROM Items ORDER BY id;");
+    ASSERT_EQ(select.step(), SQLITE_ROW);
+    EXPECT_EQ(select.columnText(0), "a");
+    ASSERT_EQ(select.step(), SQLITE_ROW);
+    EXPECT_EQ(select.columnText(0), "");
+}
+
+// Test that leaving a scope mid-iteration does not leave the statement busy
+TEST(StatementCacheTest, EarlyReturnResetsStatement) {
+    MemoryDatabase memory;
+    StatementCache cache(memory.db);
+    sqlite3_exec(memory.db, "INSERT INTO Items (name) VALUES ('a'), ('b');", nullptr, nullptr, nullptr);
+    sqlite3_stmt* stmt = nullptr;
+    {
+        Statement select = cache.get("SELECT name FROM Items;");
+        stmt = select.get();
+        ASSERT_EQ(select.step(), SQLITE_ROW);
+        EXPECT_TRUE(sqlite3_stmt_busy(stmt));
+    }
+    EXPECT_FALSE(sqlite3_stmt_busy(stmt));
+}
+
+// Test that nested use of the same SQL gets its own statement and bad SQL an empty handle
+TEST(StatementCacheTest, NestedUseAndErrors) {
+    MemoryDatabase memory;
+    StatementCache cache(memory.db);
+    Statement outer = cache.get("SELECT id FROM Items;");
+    Statement inner = cache.get("SELECT id FROM Items;");
+    ASSERT_TRUE(inner);
+    EXPECT_NE(outer.get(), inner.get());
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_FALSE(cache.get("SELECT FROM nowhere;"));
+}
+
+// Test that reset() lets one handle run a batch and drops the previous bindings
+TEST(StatementCacheTest, ResetRunsBatches) {
+    MemoryDatabase memory;
+    StatementCache cache(memory.db);
+    Statement insert = cache.get("INSERT INTO Items (id, name) VALUES (?, ?);");
+    std::string name = "a";
+    for (int id = 1; id <= 3; id++) {
+        insert.bind(1, id);
+        if (id < 3) {
+            insert.bind(2, name);
+        }
+        ASSERT_EQ(insert.step(), SQLITE_DONE);
+        insert.reset();
+        EXPECT_FALSE(sqlite3_stmt_busy(insert.get()));
+    }
+
+    Statement select = cache.get("SELECT name FROM Items WHERE id = 3;");
+    ASSERT_EQ(select.step(), SQLITE_ROW);
+    EXPECT_TRUE(select.columnIsNull(0));
+}
@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+#include "../src/Templates/TemplateRenderer/TemplateRenderer.h"
+
+// Test that known variables are substituted in place
+TEST(TemplateRendererTest, SubstitutesVariables) {
+    ParsedTemplate parsed = TemplateRenderer::parse("// ${problem} by ${handle} on ${date}\nint main() {}\n");
+    std::string rendered = TemplateRenderer::render(parsed, {{"problem", "A"}, {"handle", "tourist"}, {"date", "2024-01-01"}});
+    EXPECT_EQ(rendered, "// A by tourist on 2024-01-01\nint main() {}\n");
+}
+
+// Test that unknown variables and snippet placeholders are left untouched
+TEST(TemplateRendererTest, KeepsUnknownAndNonVariablePlaceholders) {
+    ParsedTemplate parsed = TemplateRenderer::parse("${unknown} ${1:n} $0 ${ broken");
+    EXPECT_EQ(TemplateRenderer::render(parsed, {}), "${unknown} ${1:n} $0 ${ broken");
+}
+
+// Test that one parsed template renders many files independently
+TEST(TemplateRendererTest, RendersRepeatedlyFromOneParse) {
+    ParsedTemplate parsed = TemplateRenderer::parse("${problem}${problem}");
+    EXPECT_EQ(TemplateRenderer::render(parsed, {{"problem", "A"}}), "AA");
+    EXPECT_EQ(TemplateRenderer::render(parsed, {{"problem", "B"}}), "BB");
+}